@@ -29,14 +29,84 @@
 
 *******************************************************************************/
 
+/* Enable POSIX functions with strict C standards. */
+#ifndef _DEFAULT_SOURCE
+#define _DEFAULT_SOURCE
+#endif
+
 #include <stdlib.h>
+#include <stddef.h>
 #include <limits.h>
 #include <stdint.h>
+#include <inttypes.h>
+#include <float.h>
 #include <ctype.h>
 #include <string.h>
 #include <strings.h>
+#include <sys/types.h>
+#include <sys/stat.h>
 #include "libcfgcli.h"
 
+#ifdef HAVE_CONFIG_H
+#include "autoconf.h"
+#elif defined(__unix__)
+/* Assume POSIX functions if the library is compiled without configure. */
+#define HAVE_POSIX_MEMALIGN 1
+#define HAVE_FCNTL_H 1
+#define HAVE_UNISTD_H 1
+#define HAVE_SYS_MMAN_H 1
+#define HAVE_MMAP 1
+#define HAVE_PREAD 1
+#define HAVE_ENVIRON 1
+#define HAVE_STRUCT_STAT_ST_MTIM 1
+#define HAVE_SHM_OPEN 1
+#endif
+#ifdef HAVE_FCNTL_H
+#include <fcntl.h>
+#endif
+#ifdef HAVE_UNISTD_H
+#include <unistd.h>
+#endif
+#ifdef HAVE_SYS_MMAN_H
+#include <sys/mman.h>
+#endif
+#ifdef HAVE_PTHREAD
+#include <pthread.h>
+#endif
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+#ifdef HAVE_IO_URING
+#include <errno.h>
+#include <sys/syscall.h>
+#include <linux/io_uring.h>
+#endif
+#ifdef HAVE_ZLIB
+#include <zlib.h>
+#endif
+#ifdef HAVE_ZSTD
+#include <zstd.h>
+#endif
+#ifdef HAVE_MEMFD
+#include <sys/syscall.h>
+#include <linux/memfd.h>
+#ifndef F_ADD_SEALS             /* Linux specific, hidden without _GNU_SOURCE */
+#define F_ADD_SEALS                1033
+#define F_SEAL_SEAL                0x0001
+#define F_SEAL_SHRINK              0x0002
+#define F_SEAL_GROW                0x0004
+#define F_SEAL_WRITE               0x0008
+#endif
+#endif
+/* Shared segments are created in memory, and attached by `mmap`. */
+#if defined(HAVE_MMAP) && (defined(HAVE_MEMFD) || defined(HAVE_SHM_OPEN))
+#define CFGCLI_HAVE_SHARED 1
+#endif
+
+#ifdef HAVE_ENVIRON
+extern char **environ;
+#endif
+
 /*============================================================================*\
                              Definitions of macros
 \*============================================================================*/
@@ -46,6 +116,65 @@
 #define CFGCLI_STR_MAX_DOUBLE_SIZE 134217728   /* maximum string doubling size */
 #define CFGCLI_NUM_MAX_SIZE(type)  (CHAR_BIT * sizeof(type) / 3 + 2)
 
+/* Settings on number conversions. */
+#define CFGCLI_REAL_MAX_LEN        512    /* maximum length of real numbers */
+
+/* Settings on included files. */
+#define CFGCLI_MAX_INCLUDE_DEPTH   16     /* maximum depth of nested files */
+#ifdef HAVE_STRUCT_STAT_ST_MTIM
+#define CFGCLI_MTIME_NS(st)        ((long) (st).st_mtim.tv_nsec)
+#else
+#define CFGCLI_MTIME_NS(st)        0L     /* only seconds of the file time */
+#endif
+
+/* Settings on response files of command line arguments. */
+#define CFGCLI_CMD_RESPONSE        '@'
+#define CFGCLI_MAX_RESPONSE_DEPTH  8      /* maximum depth of nested files */
+
+/* Settings on the index of parameter names. */
+#define CFGCLI_INDEX_INIT_SLOTS    64      /* initial number of hash slots */
+
+/* Settings on the trie of long command line options. */
+#define CFGCLI_TRIE_INIT_NODES     64      /* initial number of trie nodes */
+#define CFGCLI_TRIE_PARAM(i)       ((i) << 1)           /* parameter index */
+#define CFGCLI_TRIE_FUNC(i)        (((i) << 1) | 1)      /* function index */
+#define CFGCLI_TRIE_AMBIGUOUS      (-2)    /* more than one options match */
+
+/* Settings on multi-dimensional arrays. */
+#define CFGCLI_NDARRAY_ALIGN       64     /* alignment of the buffer in bytes */
+
+/* Settings on parallel array conversions. */
+#define CFGCLI_MAX_THREADS         256    /* maximum number of threads */
+
+/* Settings on element sinks. */
+#define CFGCLI_SINK_BATCH_SIZE     8192   /* bytes of elements per callback */
+
+/* Settings on asynchronous loading of configuration files. */
+#define CFGCLI_LOAD_MAX_RING       256    /* maximum entries of the ring */
+#define CFGCLI_LOAD_MAX_READ       1073741824     /* maximum bytes per read */
+#define CFGCLI_LOAD_MAX_RETRY      64     /* retries of interrupted entries */
+
+/* Settings on compressed configuration files. */
+#define CFGCLI_SOURCE_MAGIC_LEN    4      /* bytes for detecting the format */
+#define CFGCLI_SOURCE_IN_SIZE      65536  /* bytes of compressed input read */
+
+/* Settings on shared segments of configurations. */
+#define CFGCLI_SHARED_MAGIC        "CFGCLISH"   /* identifier of segments */
+#define CFGCLI_SHARED_VERSION      1      /* version of the segment format */
+#define CFGCLI_SHARED_ALIGN        64     /* alignment of arrays in bytes */
+#define CFGCLI_SHARED_MAX_RETRY    16     /* attempts of unique shm names */
+
+/* Settings on writing configurations, for IEEE 754 numbers. */
+#define CFGCLI_FLT_MAX_DIGITS      9      /* digits for exact round trips */
+#define CFGCLI_DBL_MAX_DIGITS      17     /* digits for exact round trips */
+
+/* Settings on environment variables. */
+#define CFGCLI_ENV_SEP             '_'    /* replacing '.' and '-' in names */
+
+/* Settings on string interning. */
+#define CFGCLI_INTERN_INIT_SLOTS   64      /* initial number of hash slots */
+#define CFGCLI_INTERN_POOL_SIZE    65536   /* size of blocks for strings */
+
 /* Settings on the source of the configurations. */
 #define CFGCLI_SRC_NULL            0
 #define CFGCLI_SRC_OF_OPT(x)       (-x)    /* -x for source being command line */
@@ -61,9 +190,11 @@
 #define CFGCLI_ERR_DTYPE           (-7)
 #define CFGCLI_ERR_CMD             (-8)
 #define CFGCLI_ERR_FILE            (-9)
+#define CFGCLI_ERR_SINK            (-10)
+#define CFGCLI_ERR_CHECK           (-11)
 #define CFGCLI_ERR_UNKNOWN         (-99)
 
-#define CFGCLI_ERRNO(cfg)          (((cfgcli_error_t *)cfg->error)->errno)
+#define CFGCLI_ERRNO(cfg)          (((cfgcli_error_t *)cfg->error)->code)
 #define CFGCLI_IS_ERROR(cfg)       (CFGCLI_ERRNO(cfg) != 0)
 
 /* Check if a string is a valid command line option, or parser termination. */
@@ -84,7 +215,9 @@ typedef struct {
   cfgcli_dtype_t dtype;            /* data type of the parameter               */
   int src;                      /* source of the value                      */
   int opt;                      /* short command line option                */
-  int narr;                     /* number of elements for the array         */
+  size_t narr;                  /* number of elements for the array         */
+  int ndim;                     /* number of dimensions for the array       */
+  size_t shape[CFGCLI_MAX_NDIM];        /* shape of multi-dimensional array */
   size_t nlen;                  /* length of the parameter name             */
   size_t llen;                  /* length of the long option                */
   size_t vlen;                  /* length of the value                      */
@@ -94,8 +227,25 @@ typedef struct {
   char *value;                  /* value of the parameter                   */
   void *var;                    /* variable for saving the retrieved value  */
   char *help;                   /* parameter help message                   */
+  cfgcli_sink_t sink;           /* callback receiving the array elements    */
+  void *sink_arg;               /* argument of the callback                 */
+  uint64_t hash;                /* hash value of the converted value        */
+  uint64_t digest[4];           /* SHA-256 digest of the converted value    */
+  void *check;                  /* constraints on the converted values      */
+  size_t cidx;                  /* index of the element violating them      */
+  int cfail;                    /* the violated constraint                  */
 } cfgcli_param_valid_t;
 
+/* Data structure for storing verified constraints on numeric values. */
+typedef struct {
+  int flags;                    /* combination of CFGCLI_CHECK_* flags      */
+  long double min;              /* inclusive lower bound                    */
+  long double max;              /* inclusive upper bound                    */
+  double *set;                  /* sorted allowed values                    */
+  size_t nset;                  /* number of allowed values                 */
+  long double prev;             /* last element of the previous batch       */
+} cfgcli_check_valid_t;
+
 /* Data structure for storing verified command line functions. */
 typedef struct {
   int called;                   /* 1 if the function is already called      */
@@ -108,15 +258,162 @@ typedef struct {
   char *help;                   /* parameter help message                   */
 } cfgcli_func_valid_t;
 
+/* Data structure for storing verified subcommands. */
+typedef struct {
+  size_t nlen;                  /* length of the name                       */
+  char *name;                   /* name of the subcommand                   */
+  int (*func) (cfgcli_t *, void *);     /* registration function            */
+  void *args;                   /* pointer to the arguments                 */
+  char *help;                   /* help message                             */
+} cfgcli_cmd_valid_t;
+
 /* Data structure for storing warning/error messages. */
 typedef struct {
-  int errno;                    /* identifier of the warning/error          */
+  int code;                     /* identifier of the warning/error          */
   int num;                      /* number of existing messages              */
   char *msg;                    /* warning and error messages               */
   size_t len;                   /* length of the existing messages          */
   size_t max;                   /* allocated space for the messages         */
 } cfgcli_error_t;
 
+/* Memory block kept until the configurations are destroyed. */
+typedef struct cfgcli_block_struct {
+  struct cfgcli_block_struct *next;     /* the next block                   */
+  char data[];                          /* content of this block            */
+} cfgcli_block_t;
+
+/* Node of the tree of dotted parameter names. */
+typedef struct {
+  uint64_t hash;                /* hash value of the full name              */
+  const char *name;             /* full name, not necessarily terminated    */
+  size_t len;                   /* length of the full name                  */
+  int par;                      /* index of the parameter, -1 for sections  */
+  int child;                    /* first child node, -1 if none             */
+  int last;                     /* last child node, -1 if none              */
+  int next;                     /* next sibling node, -1 if none            */
+} cfgcli_node_t;
+
+/* Data structure for the index of parameter names. */
+typedef struct {
+  int num;                      /* number of nodes, including the root      */
+  int max;                      /* allocated number of nodes                */
+  cfgcli_node_t *node;          /* nodes of the tree, starting from root    */
+  size_t nslot;                 /* number of hash slots, a power of 2       */
+  int *slot;                    /* index of nodes plus 1, 0 for empty slots */
+  const char *scope;            /* the only section to be read, if set      */
+  size_t sclen;                 /* length of the section name               */
+} cfgcli_index_t;
+
+/* Node of the trie of long command line options. */
+typedef struct {
+  int child;                    /* first child node, -1 if none             */
+  int next;                     /* next sibling node, -1 if none            */
+  int opt;                      /* option ending at this node, -1 if none   */
+  int any;                      /* an option in the subtree                 */
+  int num;                      /* number of options in the subtree         */
+  char c;                       /* character leading to this node           */
+} cfgcli_trie_node_t;
+
+/* Data structure for the trie of long command line options. */
+typedef struct {
+  int num;                      /* number of nodes, including the root      */
+  int max;                      /* allocated number of nodes                */
+  cfgcli_trie_node_t *node;     /* nodes of the trie, starting from root    */
+} cfgcli_trie_t;
+
+/* Section of configuration files, with the buffer for full names. */
+typedef struct {
+  bool skip;                    /* true if the section is not registered    */
+  size_t len;                   /* length of the prefix for full names      */
+  char name[CFGCLI_MAX_NAME_LEN + 1];   /* the prefix and full name         */
+} cfgcli_section_t;
+
+/* Raw value of a parameter recorded for deferred conversion. */
+typedef struct {
+  char *value;                  /* the raw value, NULL if not recorded      */
+  size_t vlen;                  /* length of the value, including '\0'      */
+  int src;                      /* source of the value                      */
+  bool owned;                   /* true if the value is a private copy      */
+} cfgcli_pending_t;
+
+/* Data structure for deferred value conversion. */
+typedef struct {
+  bool on;                      /* true if conversions are deferred         */
+  int max;                      /* number of allocated records              */
+  cfgcli_pending_t *rec;        /* records indexed by parameters            */
+} cfgcli_defer_t;
+
+/* Previous state of a parameter, restored if its section is not reloaded. */
+typedef struct {
+  int idx;                      /* index of the parameter                   */
+  cfgcli_param_valid_t par;     /* the verified parameter                   */
+  cfgcli_pending_t rec;         /* value recorded for deferred conversion   */
+  union {                       /* content of the variable                  */
+    cfgcli_strview_t view;
+    long double ld;
+    int64_t i64;
+    size_t size;
+    void *ptr;
+  } var;
+} cfgcli_saved_t;
+
+/* Data structure for the parameters of a reloaded section. */
+typedef struct {
+  cfgcli_t *cfg;                /* entry for all configurations             */
+  int num;                      /* number of parameters in the section      */
+  cfgcli_saved_t *saved;        /* previous states, NULL for counting       */
+} cfgcli_reload_t;
+
+/* Task of converting the array elements starting in a range of bytes. */
+typedef struct {
+  char *lo;                     /* start of the range                       */
+  char *hi;                     /* end of the range                         */
+  char *arr;                    /* the destination array                    */
+  size_t size;                  /* size of the elements                     */
+  size_t narr;                  /* number of elements of the full array     */
+  size_t nsep;                  /* number of '\0' separators in the range   */
+  size_t first;                 /* number of separators before the range    */
+  size_t fail;                  /* index of the first failed element        */
+  cfgcli_dtype_t dtype;         /* data type of the elements                */
+  int src;                      /* source of the value                      */
+  int err;                      /* error of the first failed element        */
+} cfgcli_task_t;
+
+/* Batch of array elements passed to sinks, aligned for all element types. */
+typedef union {
+  char buf[CFGCLI_SINK_BATCH_SIZE];     /* bytes of the elements            */
+  long double ld;               /* members only for the alignment           */
+  int64_t i64;
+  size_t size;
+  void *ptr;
+} cfgcli_sink_batch_t;
+
+/* Hash table of environment variable names for parameters. */
+typedef struct {
+  size_t nslot;                 /* number of hash slots, a power of 2       */
+  int *slot;                    /* index of parameters plus 1, 0 for empty  */
+  uint64_t *hash;               /* hash values of the variable names        */
+  char *name;                   /* variable names, `CFGCLI_MAX_NAME_LEN`
+                                   characters for each parameter            */
+} cfgcli_env_t;
+
+/* Slot of the hash table for interned strings. */
+typedef struct {
+  uint64_t hash;                /* hash value of the string                 */
+  size_t len;                   /* length of the string, without the '\0'   */
+  const char *str;              /* the interned string                      */
+} cfgcli_intern_slot_t;
+
+/* Data structure for the table of interned strings. */
+typedef struct {
+  bool on;                      /* true if new strings are interned         */
+  size_t num;                   /* number of interned strings               */
+  size_t max;                   /* number of slots, a power of 2            */
+  cfgcli_intern_slot_t *slot;   /* slots of the hash table                  */
+  char *pool;                   /* free space for storing strings           */
+  size_t plen;                  /* size of the free space                   */
+} cfgcli_intern_t;
+
 /* Data structure for storing an help line content. */
 typedef struct {
   cfgcli_dtype_t dtype;            /* data type of the parameter               */
@@ -134,7 +431,9 @@ typedef enum {
   CFGCLI_PARSE_ARRAY_START,        CFGCLI_PARSE_ARRAY_VALUE,
   CFGCLI_PARSE_ARRAY_QUOTE,        CFGCLI_PARSE_ARRAY_QUOTE_END,
   CFGCLI_PARSE_ARRAY_NEWLINE,      CFGCLI_PARSE_CLEAN,
-  CFGCLI_PARSE_ARRAY_END,          CFGCLI_PARSE_ARRAY_DONE
+  CFGCLI_PARSE_ARRAY_END,          CFGCLI_PARSE_ARRAY_DONE,
+  CFGCLI_PARSE_INCLUDE_PATH,       CFGCLI_PARSE_INCLUDE_END,
+  CFGCLI_PARSE_SECTION_NAME,       CFGCLI_PARSE_SECTION_END
 } cfgcli_parse_state_t;
 
 /* Return value for the parser status. */
@@ -142,9 +441,233 @@ typedef enum {
   CFGCLI_PARSE_DONE,
   CFGCLI_PARSE_PASS,
   CFGCLI_PARSE_CONTINUE,
-  CFGCLI_PARSE_ERROR
+  CFGCLI_PARSE_ERROR,
+  CFGCLI_PARSE_INCLUDE,
+  CFGCLI_PARSE_SECTION
 } cfgcli_parse_return_t;
 
+/* Types of tokens of included files. */
+typedef enum {
+  CFGCLI_TOKEN_ENTRY,           /* parameter definition                     */
+  CFGCLI_TOKEN_INCLUDE,         /* nested include directive                 */
+  CFGCLI_TOKEN_SECTION,         /* section header                           */
+  CFGCLI_TOKEN_ERROR            /* invalid line                             */
+} cfgcli_token_type_t;
+
+/* Token of included files. */
+typedef struct {
+  cfgcli_token_type_t type;     /* type of the token                        */
+  size_t line;                  /* line number of the token                 */
+  char *key;                    /* name of the parameter                    */
+  char *value;                  /* value, or path of the included file      */
+  size_t vlen;                  /* length of the value                      */
+} cfgcli_token_t;
+
+/* Cached tokens of an included file. */
+typedef struct cfgcli_include_struct {
+  struct cfgcli_include_struct *next;   /* the next cached file             */
+  dev_t dev;                    /* device of the file                       */
+  ino_t ino;                    /* inode of the file                        */
+  time_t mtime;                 /* last modification time of the file       */
+  long mtime_ns;                /* nanoseconds of the time, 0 if unknown    */
+  off_t size;                   /* size of the file                         */
+  char *fname;                  /* name of the file                         */
+  char *text;                   /* content of the file, split into tokens   */
+  size_t ntok;                  /* number of tokens                         */
+  cfgcli_token_t *tok;          /* tokens of the file                       */
+} cfgcli_include_t;
+
+/* Response file mapped, or read, into memory, kept until the configurations
+   are destroyed. */
+typedef struct cfgcli_map_struct {
+  struct cfgcli_map_struct *next;       /* the next mapped file             */
+  void *addr;                   /* address of the mapping                   */
+  size_t len;                   /* length of the mapping                    */
+} cfgcli_map_t;
+
+/* Iterator over command line arguments, with response files expanded. */
+typedef struct {
+  int argc;                     /* number of command line arguments         */
+  char *const *argv;            /* the command line arguments               */
+  int idx;                      /* index of the next argument in `argv`     */
+  int depth;                    /* number of response files being read      */
+  char *pos[CFGCLI_MAX_RESPONSE_DEPTH];         /* next unread characters   */
+  char *end[CFGCLI_MAX_RESPONSE_DEPTH];         /* ends of the files        */
+  char *ahead;                  /* argument read in advance                 */
+  bool peeked;                  /* true if `ahead` is not consumed yet      */
+} cfgcli_args_t;
+
+/* States of files read by the loader. */
+typedef enum {
+  CFGCLI_LOAD_OPEN,             /* waiting for the file to be opened        */
+  CFGCLI_LOAD_READ,             /* waiting for the content of the file      */
+  CFGCLI_LOAD_DONE,             /* read completely, waiting to be parsed    */
+  CFGCLI_LOAD_FAIL,             /* failed to be opened or read              */
+  CFGCLI_LOAD_PARSED            /* parsed                                   */
+} cfgcli_load_state_t;
+
+/* File read by the loader. */
+typedef struct {
+  cfgcli_load_state_t state;    /* state of the file                        */
+  const char *fname;            /* name of the file                         */
+  const char *fail;             /* message of the failure                   */
+  int prior;                    /* priority of values read from the file    */
+  int fd;                       /* file descriptor, -1 if not opened        */
+  FILE *fp;                     /* stream of the file, if `pread` is not
+                                   available                                */
+  bool regular;                 /* true for regular files of known size     */
+  dev_t dev;                    /* device of the file                       */
+  ino_t ino;                    /* inode of the file                        */
+  char *buf;                    /* content of the file                      */
+  size_t len;                   /* number of bytes read                     */
+  size_t size;                  /* capacity of the buffer, without '\0'     */
+} cfgcli_load_file_t;
+
+#ifdef HAVE_IO_URING
+/* Rings of io_uring, mapped from the kernel. */
+typedef struct {
+  int fd;                       /* file descriptor of the ring, -1 if none  */
+  unsigned entries;             /* number of submission queue entries       */
+  unsigned *sq_head;            /* head of the submission queue             */
+  unsigned *sq_tail;            /* tail of the submission queue             */
+  unsigned *sq_mask;            /* mask of submission queue indices         */
+  unsigned *sq_array;           /* indices of submitted entries             */
+  struct io_uring_sqe *sqes;    /* submission queue entries                 */
+  unsigned *cq_head;            /* head of the completion queue             */
+  unsigned *cq_tail;            /* tail of the completion queue             */
+  unsigned *cq_mask;            /* mask of completion queue indices         */
+  struct io_uring_cqe *cqes;    /* completion queue entries                 */
+  void *sq_ptr;                 /* mapped submission queue ring             */
+  void *cq_ptr;                 /* mapped completion queue ring             */
+  size_t sq_len;                /* size of the submission queue ring        */
+  size_t cq_len;                /* size of the completion queue ring        */
+  size_t sqe_len;               /* size of the submission queue entries     */
+} cfgcli_ring_t;
+#endif
+
+/* Loader reading configuration files asynchronously. */
+struct cfgcli_loader_struct {
+  cfgcli_t *cfg;                /* entry for the configurations             */
+  int nfile;                    /* number of files                          */
+  int nopen;                    /* number of files submitted for opening    */
+  int next;                     /* index of the next file to be parsed      */
+  int inflight;                 /* number of submitted operations           */
+  unsigned queued;              /* number of operations not submitted yet   */
+  cfgcli_load_file_t *file;     /* the files                                */
+#ifdef HAVE_IO_URING
+  cfgcli_ring_t ring;           /* the ring, unused if `ring.fd` < 0        */
+#endif
+};
+
+/* Chain of files being read, for detecting recursive inclusions. */
+typedef struct {
+  int depth;                    /* number of files in the chain             */
+  dev_t dev[CFGCLI_MAX_INCLUDE_DEPTH + 1];      /* devices of the files     */
+  ino_t ino[CFGCLI_MAX_INCLUDE_DEPTH + 1];      /* inodes of the files      */
+} cfgcli_chain_t;
+
+/* Header of shared segments, with offsets from the start of the segment. */
+typedef struct {
+  char magic[8];                /* identifier of the format                 */
+  uint32_t version;             /* version of the format                    */
+  uint32_t npar;                /* number of parameters                     */
+  uint64_t size;                /* total size of the segment                */
+  uint64_t nslot;               /* number of hash slots, a power of 2       */
+  uint64_t slot;                /* offset of the slots, with the index of
+                                   parameters plus 1, 0 for empty slots     */
+  uint64_t entry;               /* offset of the parameters                 */
+} cfgcli_shared_head_t;
+
+/* Parameter in shared segments, with offsets from the start of the segment. */
+typedef struct {
+  uint64_t hash;                /* hash value of the name                   */
+  uint64_t name;                /* offset of the null terminated name       */
+  uint64_t value;               /* offset of the value, or of the offsets
+                                   and lengths of string array elements     */
+  uint64_t len;                 /* bytes of the value, without the '\0' of
+                                   strings                                  */
+  uint64_t narr;                /* number of elements for the array         */
+  uint64_t shape;               /* offset of the shape of ndarrays          */
+  int32_t dtype;                /* data type of the parameter               */
+  int32_t ndim;                 /* number of dimensions for the array       */
+} cfgcli_shared_entry_t;
+
+/* Shared segment of configurations mapped by a process. */
+struct cfgcli_shared_struct {
+  const char *base;             /* start of the read-only mapping           */
+  size_t size;                  /* size of the segment                      */
+};
+
+/* Compression formats of configuration files. */
+typedef enum {
+  CFGCLI_CODEC_NONE,            /* plain text                               */
+  CFGCLI_CODEC_GZIP,            /* gzip, decompressed with zlib             */
+  CFGCLI_CODEC_ZSTD             /* Zstandard                                */
+} cfgcli_codec_t;
+
+/* Source of configuration text, decompressed while it is read. */
+typedef struct {
+  FILE *fp;                     /* the file, NULL for a memory buffer       */
+  cfgcli_codec_t codec;         /* compression format                       */
+  unsigned char head[CFGCLI_SOURCE_MAGIC_LEN];  /* bytes read for detection */
+  size_t nhead;                 /* number of pending bytes in `head`        */
+  unsigned char *in;            /* buffer of compressed input from the file */
+  unsigned char *next;          /* next byte of compressed input            */
+  size_t avail;                 /* number of available bytes of input       */
+  bool end;                     /* true if a compressed frame is complete   */
+  bool flush;                   /* true if the output may be pending        */
+  bool eof;                     /* true if the end of the text is reached   */
+  bool fail;                    /* true on read or decompression errors     */
+#ifdef HAVE_ZLIB
+  z_stream zs;                  /* state of the gzip decompression          */
+#endif
+#ifdef HAVE_ZSTD
+  ZSTD_DStream *ds;             /* state of the Zstandard decompression     */
+#endif
+} cfgcli_source_t;
+
+/* Handling of array definitions spanning multiple lines. */
+typedef enum {
+  CFGCLI_STREAM_NONE,           /* no pending line continuation             */
+  CFGCLI_STREAM_KEEP,           /* keep the full definition in the chunk    */
+  CFGCLI_STREAM_SKIP,           /* discard the definition                   */
+  CFGCLI_STREAM_DATA            /* convert the elements line by line        */
+} cfgcli_stream_mode_t;
+
+/* Element of streamed string arrays: offset first, then the address. */
+typedef union {
+  size_t off;                   /* offset of the string in the characters   */
+  char *ptr;                    /* address of the string                    */
+} cfgcli_stream_str_t;
+
+/* State of SHA-256 hashing. */
+typedef struct {
+  uint32_t h[8];                /* intermediate hash value                  */
+  unsigned char blk[64];        /* pending bytes of the current block       */
+  size_t num;                   /* number of pending bytes                  */
+  uint64_t total;               /* total number of hashed bytes             */
+} cfgcli_sha256_t;
+
+/* Growing buffer for writing configurations. */
+typedef struct {
+  char *buf;                    /* the written characters                   */
+  size_t len;                   /* number of written characters             */
+  size_t max;                   /* allocated space for the characters       */
+} cfgcli_output_t;
+
+/* Data structure for streaming elements of multiple-line arrays. */
+typedef struct {
+  cfgcli_t *cfg;                /* entry for all configurations             */
+  cfgcli_param_valid_t *par;    /* parameter receiving the elements         */
+  char *data;                   /* converted elements                       */
+  size_t num;                   /* number of converted elements             */
+  size_t max;                   /* allocated space for the elements         */
+  char *str;                    /* characters of string elements            */
+  size_t slen;                  /* used space for the characters            */
+  size_t smax;                  /* allocated space for the characters       */
+  size_t total;                 /* number of elements passed to the sink    */
+} cfgcli_stream_t;
+
 
 /*============================================================================*\
                        Functions for string manipulation
@@ -200,14 +723,14 @@ static void cfgcli_msg(cfgcli_t *cfg, const char *msg, const char *key) {
     }
     else if (SIZE_MAX / 2 >= err->max) max = err->max << 1;
     if (!max) {
-      err->errno = CFGCLI_ERR_MEMORY;
+      err->code = CFGCLI_ERR_MEMORY;
       return;
     }
     if (len > max) max = len;           /* the size is still not enough */
 
     tmp = realloc(err->msg, max);
     if (!tmp) {
-      err->errno = CFGCLI_ERR_MEMORY;
+      err->code = CFGCLI_ERR_MEMORY;
       return;
     }
     err->msg = tmp;
@@ -227,146 +750,709 @@ static void cfgcli_msg(cfgcli_t *cfg, const char *msg, const char *key) {
 }
 
 
+/******************************************************************************
+Function `cfgcli_keep`:
+  Allocate memory that is kept until the configurations are destroyed.
+Arguments:
+  * `cfg`:      entry for the configurations;
+  * `size`:     number of bytes to be allocated.
+Return:
+  Address of the allocated memory on success; NULL on error.
+******************************************************************************/
+static void *cfgcli_keep(cfgcli_t *cfg, const size_t size) {
+  if (size > SIZE_MAX - sizeof(cfgcli_block_t)) return NULL;
+  cfgcli_block_t *block = malloc(sizeof(cfgcli_block_t) + size);
+  if (!block) return NULL;
+  block->next = (cfgcli_block_t *) cfg->blocks;
+  cfg->blocks = block;
+  return block->data;
+}
+
+
+/******************************************************************************
+Function `cfgcli_hash`:
+  Compute the 64-bit FNV-1a hash value of a string.
+Arguments:
+  * `str`:      the string;
+  * `len`:      length of the string.
+Return:
+  The hash value.
+******************************************************************************/
+static inline uint64_t cfgcli_hash(const char *str, const size_t len) {
+  uint64_t hash = UINT64_C(0xcbf29ce484222325);
+  for (size_t i = 0; i < len; i++) {
+    hash ^= (unsigned char) str[i];
+    hash *= UINT64_C(0x100000001b3);
+  }
+  return hash;
+}
+
+
 /*============================================================================*\
-              Functions for initialising parameters and functions
+                        Functions for interning strings
 \*============================================================================*/
 
 /******************************************************************************
-Function `cfgcli_init`:
-  Initialise the entry for all parameters and command line functions.
+Function `cfgcli_intern`:
+  Return the unique stored copy of a string, and create it if necessary.
+Arguments:
+  * `cfg`:      entry for the configurations;
+  * `str`:      the string, not necessarily null terminated;
+  * `len`:      length of the string.
 Return:
-  The address of the structure.
+  Address of the null terminated interned string; NULL on error.
 ******************************************************************************/
-cfgcli_t *cfgcli_init(void) {
-  cfgcli_t *cfg = calloc(1, sizeof(cfgcli_t));
-  if (!cfg) return NULL;
+static const char *cfgcli_intern(cfgcli_t *cfg, const char *str,
+    const size_t len) {
+  cfgcli_intern_t *tab = (cfgcli_intern_t *) cfg->intern;
+  const uint64_t hash = cfgcli_hash(str, len);
+  size_t i;
 
-  cfgcli_error_t *err = calloc(1, sizeof(cfgcli_error_t));
-  if (!err) {
-    free(cfg);
-    return NULL;
+  /* Search for the string with linear probing. */
+  for (i = hash & (tab->max - 1); tab->slot[i].str; i = (i + 1) & (tab->max - 1)) {
+    if (tab->slot[i].hash == hash && tab->slot[i].len == len &&
+        !memcmp(tab->slot[i].str, str, len)) return tab->slot[i].str;
   }
-  err->msg = NULL;
 
-  cfg->params = cfg->funcs = NULL;
-  cfg->error = err;
-  return cfg;
+  /* Keep the load factor of the table below 1/2, before inserting. */
+  if ((tab->num + 1) * 2 > tab->max) {
+    const size_t max = tab->max << 1;
+    cfgcli_intern_slot_t *slot = calloc(max, sizeof(cfgcli_intern_slot_t));
+    if (!slot) return NULL;
+    for (size_t j = 0; j < tab->max; j++) {
+      if (!tab->slot[j].str) continue;
+      for (i = tab->slot[j].hash & (max - 1); slot[i].str; i = (i + 1) & (max - 1));
+      slot[i] = tab->slot[j];
+    }
+    free(tab->slot);
+    tab->slot = slot;
+    tab->max = max;
+    for (i = hash & (max - 1); slot[i].str; i = (i + 1) & (max - 1));
+  }
+
+  /* Store a copy of the string. */
+  char *copy;
+  if (len >= CFGCLI_INTERN_POOL_SIZE / 4) {     /* own block for long strings */
+    if (!(copy = cfgcli_keep(cfg, len + 1))) return NULL;
+  }
+  else {
+    if (tab->plen < len + 1) {
+      if (!(tab->pool = cfgcli_keep(cfg, CFGCLI_INTERN_POOL_SIZE))) {
+        tab->plen = 0;
+        return NULL;
+      }
+      tab->plen = CFGCLI_INTERN_POOL_SIZE;
+    }
+    copy = tab->pool;
+    tab->pool += len + 1;
+    tab->plen -= len + 1;
+  }
+  memcpy(copy, str, len);
+  copy[len] = '\0';
+  tab->slot[i].hash = hash;
+  tab->slot[i].len = len;
+  tab->slot[i].str = copy;
+  tab->num++;
+  return copy;
 }
 
 /******************************************************************************
-Function `cfgcli_print_help_line`:
-  Print short and long options with their dashes
+Function `cfgcli_set_intern`:
+  Enable or disable the interning of string values.
 Arguments:
-  * `buffer`:  output buffer with options sets
-  * `help_line`:  content to use for display
+  * `cfg`:      entry for the configurations;
+  * `intern`:   true for enabling string interning.
 Return:
-  Output string length.
+  Zero on success; non-zero on error.
 ******************************************************************************/
-static size_t cfgcli_print_help_line(char *buffer, const cfgcli_help_line_t *help_line) {
-  size_t len = 0;
-  if (help_line->opt) {
-    len += sprintf(buffer, " -%c", help_line->opt);
-    if (help_line->lopt) {
-      len += sprintf(buffer + len, ",");
+int cfgcli_set_intern(cfgcli_t *cfg, const bool intern) {
+  if (!cfg) return CFGCLI_ERR_INIT;
+  if (CFGCLI_IS_ERROR(cfg)) return CFGCLI_ERRNO(cfg);
+
+  cfgcli_intern_t *tab = (cfgcli_intern_t *) cfg->intern;
+  if (!tab) {
+    if (!intern) return 0;
+    if (!(tab = calloc(1, sizeof(cfgcli_intern_t))) ||
+        !(tab->slot = calloc(CFGCLI_INTERN_INIT_SLOTS,
+        sizeof(cfgcli_intern_slot_t)))) {
+      free(tab);
+      cfgcli_msg(cfg, "failed to allocate memory for interning strings", NULL);
+      return CFGCLI_ERRNO(cfg) = CFGCLI_ERR_MEMORY;
     }
+    tab->max = CFGCLI_INTERN_INIT_SLOTS;
+    cfg->intern = tab;
   }
-  if (help_line->lopt) {
-    len += sprintf(buffer + len, " --%s", help_line->lopt);
-  }
-  if (help_line->dtype != CFGCLI_DTYPE_NULL && help_line->dtype != CFGCLI_DTYPE_BOOL) {
-    len += sprintf(buffer + len, " %s", help_line->name);
-  }
-  if (help_line->help) {
-    len += sprintf(buffer + len, "\n    %s", help_line->help);
-  }
-  return len;
+  /* Interned strings are kept even if interning is disabled. */
+  tab->on = intern;
+  return 0;
 }
 
 /******************************************************************************
-Function `cfgcli_print_param`:
-  Wrapper to `cfgcli_print_help_line` for `cfgcli_param_valid_t` parameter
+Function `cfgcli_interning`:
+  Check if string values are interned.
 Arguments:
-  * `buffer`:  output buffer with options sets
-  * `param`:  parameter to display
+  * `cfg`:      entry for the configurations.
 Return:
-  Output string length.
+  True if string interning is enabled; false otherwise.
 ******************************************************************************/
-static size_t cfgcli_print_param(char *buffer, const cfgcli_param_valid_t *param) {
-  cfgcli_help_line_t *help_content = malloc(sizeof(cfgcli_help_line_t));
-  help_content->dtype = param->dtype;
-  help_content->opt = param->opt;
-  help_content->lopt = param->lopt;
-  help_content->name = param->name;
-  help_content->help = param->help;
-  return cfgcli_print_help_line(buffer, help_content);
+static inline bool cfgcli_interning(const cfgcli_t *cfg) {
+  return cfg->intern && ((cfgcli_intern_t *) cfg->intern)->on;
 }
 
+
+/*============================================================================*\
+                 Functions for indexing dotted parameter names
+\*============================================================================*/
+
 /******************************************************************************
-Function `cfgcli_print_func`:
-  Wrapper to `cfgcli_print_help_line` for `cfgcli_func_valid_t` parameter
+Function `cfgcli_index_find`:
+  Search for a node of the name index.
 Arguments:
-  * `buffer`:  output buffer with options sets
-  * `func`:  function to display
+  * `idx`:      the index of parameter names;
+  * `name`:     the full name, not necessarily null terminated;
+  * `len`:      length of the name.
 Return:
-  Output string length.
+  Index of the node on success; -1 if the name is not found.
 ******************************************************************************/
-static size_t cfgcli_print_func(char *buffer, const cfgcli_func_valid_t *func) {
-  cfgcli_help_line_t *help_content = malloc(sizeof(cfgcli_help_line_t));
-  help_content->dtype = CFGCLI_DTYPE_NULL;
-  help_content->opt = func->opt;
-  help_content->lopt = func->lopt;
-  help_content->name = NULL;
-  help_content->help = func->help;
-  return cfgcli_print_help_line(buffer, help_content);
+static int cfgcli_index_find(const cfgcli_index_t *idx, const char *name,
+    const size_t len) {
+  if (!idx) return -1;
+  if (!len) return 0;                   /* the root is not hashed */
+  const uint64_t hash = cfgcli_hash(name, len);
+  for (size_t i = hash & (idx->nslot - 1); idx->slot[i];
+      i = (i + 1) & (idx->nslot - 1)) {
+    const cfgcli_node_t *node = idx->node + idx->slot[i] - 1;
+    if (node->hash == hash && node->len == len && !memcmp(node->name, name, len))
+      return idx->slot[i] - 1;
+  }
+  return -1;
 }
 
 /******************************************************************************
-Function `cfgcli_print_help`:
-  Print help messages based on validated parameters
+Function `cfgcli_index_add`:
+  Return the node of the name index, and create it if necessary.
 Arguments:
-  * `cfg`:      entry for all configuration parameters;
+  * `idx`:      the index of parameter names;
+  * `name`:     the full name, which must be valid as long as the index;
+  * `len`:      length of the name;
+  * `parent`:   index of the parent node.
+Return:
+  Index of the node on success; -1 on error.
 ******************************************************************************/
-void cfgcli_print_help(cfgcli_t *cfg) {
-	size_t used_len = 0;
-	int dash_size_overload = 13;
-	char buffer[CFGCLI_MAX_LOPT_LEN + CFGCLI_MAX_NAME_LEN + dash_size_overload + CFGCLI_MAX_HELP_LEN];
-	bzero(buffer, CFGCLI_MAX_LOPT_LEN + CFGCLI_MAX_NAME_LEN + dash_size_overload + CFGCLI_MAX_HELP_LEN);
-	if (cfg && !CFGCLI_IS_ERROR(cfg)) {
-		if (cfg->npar > 0) {
-			const cfgcli_param_valid_t *param = (cfgcli_param_valid_t *)cfg->params;
-			printf("Option%c:\n", cfg->npar > 1 ? 's' : '\0');
-			for (size_t i = 0; i < cfg->npar; ++i) {
-				used_len = cfgcli_print_param(buffer, &param[i]);
-				printf("%s\n", buffer);
-				bzero(buffer, used_len);
-			}
-			printf("\n");
-		}
-		else {
-			cfgcli_msg(cfg, "the parameter list is not set", NULL);
-		}
-		if (cfg->nfunc > 0) {
-			const cfgcli_func_valid_t *param = (cfgcli_func_valid_t *)cfg->funcs;
-			printf("Function%c:\n", cfg->nfunc > 1 ? 's' : '\0');
-			for (size_t i = 0; i < cfg->nfunc; ++i) {
-				used_len = cfgcli_print_func(buffer, &param[i]);
-				printf("%s\n", buffer);
-				bzero(buffer, used_len);
-			}
-			printf("\n");
-		}
-		else {
-			cfgcli_msg(cfg, "the function list is not set", NULL);
-		}
-	}
+static int cfgcli_index_add(cfgcli_index_t *idx, const char *name,
+    const size_t len, const int parent) {
+  int n = cfgcli_index_find(idx, name, len);
+  if (n >= 0) return n;
+
+  /* Keep the load factor of the hash table below 1/2. */
+  if ((size_t) (idx->num + 1) * 2 > idx->nslot) {
+    const size_t nslot = idx->nslot << 1;
+    int *slot = calloc(nslot, sizeof(int));
+    if (!slot) return -1;
+    for (int j = 1; j < idx->num; j++) {      /* the root is not hashed */
+      size_t i;
+      for (i = idx->node[j].hash & (nslot - 1); slot[i]; i = (i + 1) & (nslot - 1));
+      slot[i] = j + 1;
+    }
+    free(idx->slot);
+    idx->slot = slot;
+    idx->nslot = nslot;
+  }
+  if (idx->num == idx->max) {
+    cfgcli_node_t *node = realloc(idx->node, 2 * idx->max * sizeof *node);
+    if (!node) return -1;
+    idx->node = node;
+    idx->max *= 2;
+  }
+
+  /* Create the node, as the last child of the parent. */
+  cfgcli_node_t *node = idx->node + (n = idx->num++);
+  node->hash = cfgcli_hash(name, len);
+  node->name = name;
+  node->len = len;
+  node->par = node->child = node->last = node->next = -1;
+  if (idx->node[parent].last < 0) idx->node[parent].child = n;
+  else idx->node[idx->node[parent].last].next = n;
+  idx->node[parent].last = n;
+
+  size_t i;
+  for (i = node->hash & (idx->nslot - 1); idx->slot[i]; i = (i + 1) & (idx->nslot - 1));
+  idx->slot[i] = n + 1;
+  return n;
 }
 
 /******************************************************************************
-Function `cfgcli_print_usage`:
-  Print usage messages based on validated parameters and provided progname
+Function `cfgcli_index_param`:
+  Add a parameter to the name index, together with its enclosing sections.
 Arguments:
-  * `cfg`:      entry for all configuration parameters;
-  * `progname`: program name to be displayed
+  * `cfg`:      entry for all configurations;
+  * `ipar`:     index of the parameter.
+Return:
+  Zero on success; non-zero on error.
+******************************************************************************/
+static int cfgcli_index_param(cfgcli_t *cfg, const int ipar) {
+  cfgcli_index_t *idx = (cfgcli_index_t *) cfg->index;
+  if (!idx) {                           /* create the index with the root */
+    if (!(idx = calloc(1, sizeof(cfgcli_index_t)))) return CFGCLI_ERR_MEMORY;
+    idx->node = malloc(CFGCLI_INDEX_INIT_SLOTS / 2 * sizeof(cfgcli_node_t));
+    idx->slot = calloc(CFGCLI_INDEX_INIT_SLOTS, sizeof(int));
+    if (!idx->node || !idx->slot) {
+      free(idx->node);
+      free(idx->slot);
+      free(idx);
+      return CFGCLI_ERR_MEMORY;
+    }
+    idx->num = 1;
+    idx->max = CFGCLI_INDEX_INIT_SLOTS / 2;
+    idx->nslot = CFGCLI_INDEX_INIT_SLOTS;
+    idx->node[0].name = "";
+    idx->node[0].hash = idx->node[0].len = 0;
+    idx->node[0].par = idx->node[0].child = idx->node[0].last =
+      idx->node[0].next = -1;
+    cfg->index = idx;
+  }
+
+  const cfgcli_param_valid_t *par = (cfgcli_param_valid_t *) cfg->params + ipar;
+  const size_t len = par->nlen - 1;
+  int n = 0;
+  for (size_t i = 0; i <= len; i++) {
+    if (i < len && par->name[i] != CFGCLI_SYM_SECTION_SEP) continue;
+    if ((n = cfgcli_index_add(idx, par->name, i, n)) < 0)
+      return CFGCLI_ERR_MEMORY;
+  }
+  if (idx->node[n].par >= 0) return CFGCLI_ERR_EXIST;
+  idx->node[n].par = ipar;
+  return 0;
+}
+
+/******************************************************************************
+Function `cfgcli_index_visit`:
+  Call a function for all parameters of a subtree of the name index.
+Arguments:
+  * `cfg`:      entry for all configurations;
+  * `n`:        index of the root node of the subtree;
+  * `func`:     the function to be called;
+  * `arg`:      argument passed to the function.
+Return:
+  Zero if all parameters are visited; the non-zero value returned by `func`.
+******************************************************************************/
+static int cfgcli_index_visit(const cfgcli_t *cfg, const int n,
+    int (*func) (const char *, void *, void *), void *arg) {
+  const cfgcli_index_t *idx = (cfgcli_index_t *) cfg->index;
+  const cfgcli_node_t *node = idx->node + n;
+  int err;
+  if (node->par >= 0 && node->par < cfg->npar) {
+    cfgcli_param_valid_t *par = (cfgcli_param_valid_t *) cfg->params + node->par;
+    if ((err = func(par->name, par->var, arg))) return err;
+  }
+  for (int i = node->child; i >= 0; i = idx->node[i].next)
+    if ((err = cfgcli_index_visit(cfg, i, func, arg))) return err;
+  return 0;
+}
+
+/******************************************************************************
+Function `cfgcli_in_scope`:
+  Check if a parameter has to be read, when reloading only a section.
+Arguments:
+  * `cfg`:      entry for all configurations;
+  * `name`:     the null terminated full name of the parameter.
+Return:
+  True if the parameter is in the section being read; false otherwise.
+******************************************************************************/
+static bool cfgcli_in_scope(const cfgcli_t *cfg, const char *name) {
+  const cfgcli_index_t *idx = (cfgcli_index_t *) cfg->index;
+  if (!idx || !idx->scope) return true;
+  return !strncmp(name, idx->scope, idx->sclen) &&
+    (name[idx->sclen] == '\0' || name[idx->sclen] == CFGCLI_SYM_SECTION_SEP);
+}
+
+/******************************************************************************
+Function `cfgcli_section_set`:
+  Start a section of a configuration file.
+Arguments:
+  * `cfg`:      entry for all configurations;
+  * `sec`:      the current section;
+  * `name`:     the null terminated name of the new section.
+******************************************************************************/
+static void cfgcli_section_set(cfgcli_t *cfg, cfgcli_section_t *sec,
+    const char *name) {
+  const size_t len = strlen(name);      /* the length is checked by parser */
+  sec->skip = false;
+  sec->len = 0;
+  if (!len) return;                     /* back to the top level */
+  if (cfgcli_index_find(cfg->index, name, len) < 0) {
+    cfgcli_msg(cfg, "unregistered section name", name);
+    sec->skip = true;                   /* skip all entries of the section */
+  }
+  memcpy(sec->name, name, len);
+  sec->name[len] = CFGCLI_SYM_SECTION_SEP;
+  sec->len = len + 1;
+}
+
+/******************************************************************************
+Function `cfgcli_section_key`:
+  Return the full name of a parameter defined in a section.
+Arguments:
+  * `cfg`:      entry for all configurations;
+  * `sec`:      the current section;
+  * `key`:      the null terminated name in the section.
+Return:
+  The null terminated full name; NULL if the entry has to be skipped.
+******************************************************************************/
+static const char *cfgcli_section_key(cfgcli_t *cfg, cfgcli_section_t *sec,
+    const char *key) {
+  if (!sec->len) return key;
+  if (sec->skip) return NULL;
+  const size_t klen = strlen(key);
+  if (sec->len + klen >= CFGCLI_MAX_NAME_LEN) {
+    cfgcli_msg(cfg, "unregistered parameter name", key);
+    return NULL;
+  }
+  memcpy(sec->name + sec->len, key, klen + 1);
+  return sec->name;
+}
+
+
+/*============================================================================*\
+              Functions for matching long command line options
+\*============================================================================*/
+
+/******************************************************************************
+Function `cfgcli_trie_child`:
+  Find the child of a trie node leading by a character.
+Arguments:
+  * `trie`:     the trie of long options;
+  * `n`:        index of the parent node;
+  * `c`:        the character;
+  * `prev`:     the preceding sibling of the child or its insertion point,
+                -1 if it is the first child; not reported if NULL.
+Return:
+  Index of the child node; -1 if it is not found.
+******************************************************************************/
+static int cfgcli_trie_child(const cfgcli_trie_t *trie, const int n,
+    const char c, int *prev) {
+  int p = -1;
+  int i;
+  /* Children are sorted by their characters. */
+  for (i = trie->node[n].child; i >= 0 && trie->node[i].c < c;
+      i = trie->node[i].next) p = i;
+  if (prev) *prev = p;
+  return (i >= 0 && trie->node[i].c == c) ? i : -1;
+}
+
+/******************************************************************************
+Function `cfgcli_trie_add`:
+  Add a long command line option to the trie.
+Arguments:
+  * `cfg`:      entry for all configurations;
+  * `lopt`:     the long option;
+  * `len`:      length of the long option;
+  * `opt`:      the encoded index of the parameter or function.
+Return:
+  Zero on success; non-zero on error.
+******************************************************************************/
+static int cfgcli_trie_add(cfgcli_t *cfg, const char *lopt, const size_t len,
+    const int opt) {
+  cfgcli_trie_t *trie = (cfgcli_trie_t *) cfg->lopts;
+  if (!trie) {                          /* create the trie with the root */
+    if (!(trie = calloc(1, sizeof(cfgcli_trie_t)))) return CFGCLI_ERR_MEMORY;
+    if (!(trie->node = malloc(CFGCLI_TRIE_INIT_NODES * sizeof *trie->node))) {
+      free(trie);
+      return CFGCLI_ERR_MEMORY;
+    }
+    trie->num = 1;
+    trie->max = CFGCLI_TRIE_INIT_NODES;
+    trie->node[0].child = trie->node[0].next = trie->node[0].opt = -1;
+    trie->node[0].any = -1;
+    trie->node[0].num = 0;
+    trie->node[0].c = '\0';
+    cfg->lopts = trie;
+  }
+
+  /* Check the duplicate before updating the counts along the path. */
+  int n = 0;
+  for (size_t i = 0; i < len && n >= 0; i++)
+    n = cfgcli_trie_child(trie, n, lopt[i], NULL);
+  if (n >= 0 && trie->node[n].opt >= 0) return CFGCLI_ERR_EXIST;
+
+  n = 0;
+  for (size_t i = 0;; i++) {
+    trie->node[n].num += 1;
+    trie->node[n].any = opt;
+    if (i == len) break;
+
+    int prev;
+    int m = cfgcli_trie_child(trie, n, lopt[i], &prev);
+    if (m < 0) {                        /* create the child */
+      if (trie->num == trie->max) {
+        cfgcli_trie_node_t *node = realloc(trie->node,
+            2 * trie->max * sizeof *node);
+        if (!node) return CFGCLI_ERR_MEMORY;
+        trie->node = node;
+        trie->max *= 2;
+      }
+      m = trie->num++;
+      trie->node[m].child = trie->node[m].opt = trie->node[m].any = -1;
+      trie->node[m].num = 0;
+      trie->node[m].c = lopt[i];
+      if (prev < 0) {
+        trie->node[m].next = trie->node[n].child;
+        trie->node[n].child = m;
+      }
+      else {
+        trie->node[m].next = trie->node[prev].next;
+        trie->node[prev].next = m;
+      }
+    }
+    n = m;
+  }
+  trie->node[n].opt = opt;
+  return 0;
+}
+
+/******************************************************************************
+Function `cfgcli_trie_match`:
+  Match a long command line option, or an unambiguous prefix of it.
+Arguments:
+  * `trie`:     the trie of long options;
+  * `lopt`:     the long option, not necessarily null terminated;
+  * `len`:      length of the long option;
+  * `node`:     the node matching `lopt`, for listing ambiguous options.
+Return:
+  The encoded index of the parameter or function; -1 if it is not found;
+  CFGCLI_TRIE_AMBIGUOUS if the prefix matches multiple options.
+******************************************************************************/
+static int cfgcli_trie_match(const cfgcli_trie_t *trie, const char *lopt,
+    const size_t len, int *node) {
+  if (!trie) return -1;
+  int n = 0;
+  for (size_t i = 0; i < len; i++)
+    if ((n = cfgcli_trie_child(trie, n, lopt[i], NULL)) < 0) return -1;
+  *node = n;
+  if (trie->node[n].opt >= 0) return trie->node[n].opt;   /* exact match */
+  return (trie->node[n].num == 1) ? trie->node[n].any : CFGCLI_TRIE_AMBIGUOUS;
+}
+
+/******************************************************************************
+Function `cfgcli_trie_list`:
+  List all long options in a subtree of the trie, in the form of
+  "--lopt1, --lopt2".
+Arguments:
+  * `cfg`:      entry for all configurations;
+  * `n`:        index of the root node of the subtree;
+  * `buf`:      buffer for the list, only the length is counted if NULL;
+  * `len`:      length of the list.
+******************************************************************************/
+static void cfgcli_trie_list(const cfgcli_t *cfg, const int n, char *buf,
+    size_t *len) {
+  const cfgcli_trie_t *trie = (cfgcli_trie_t *) cfg->lopts;
+  const int opt = trie->node[n].opt;
+  if (opt >= 0) {
+    const char *lopt = (opt & 1) ?
+      ((cfgcli_func_valid_t *) cfg->funcs)[opt >> 1].lopt :
+      ((cfgcli_param_valid_t *) cfg->params)[opt >> 1].lopt;
+    const size_t llen = strlen(lopt);
+    if (buf) {
+      if (*len) {
+        buf[(*len)++] = ',';
+        buf[(*len)++] = ' ';
+      }
+      buf[(*len)++] = CFGCLI_CMD_FLAG;
+      buf[(*len)++] = CFGCLI_CMD_FLAG;
+      memcpy(buf + *len, lopt, llen);
+      *len += llen;
+    }
+    else *len += llen + 4;
+  }
+  for (int i = trie->node[n].child; i >= 0; i = trie->node[i].next)
+    cfgcli_trie_list(cfg, i, buf, len);
+}
+
+/******************************************************************************
+Function `cfgcli_trie_ambiguous`:
+  Report an ambiguous long command line option with the candidates, in the
+  form of "--lopt (--lopt1, --lopt2)".
+Arguments:
+  * `cfg`:      entry for all configurations;
+  * `arg`:      the command line argument;
+  * `alen`:     length of the option in the argument;
+  * `n`:        the trie node matching the argument.
+Return:
+  Non-zero error code.
+******************************************************************************/
+static int cfgcli_trie_ambiguous(cfgcli_t *cfg, const char *arg,
+    const size_t alen, const int n) {
+  size_t len = 0;
+  cfgcli_trie_list(cfg, n, NULL, &len);
+  char *buf = malloc(alen + len + 4);
+  if (!buf) {
+    cfgcli_msg(cfg, "failed to allocate memory for the ambiguous option", arg);
+    return CFGCLI_ERRNO(cfg) = CFGCLI_ERR_MEMORY;
+  }
+  memcpy(buf, arg, alen);
+  buf[alen] = ' ';
+  buf[alen + 1] = '(';
+  len = 0;
+  cfgcli_trie_list(cfg, n, buf + alen + 2, &len);
+  buf[alen + len + 2] = ')';
+  buf[alen + len + 3] = '\0';
+  cfgcli_msg(cfg, "ambiguous command line option", buf);
+  free(buf);
+  return CFGCLI_ERRNO(cfg) = CFGCLI_ERR_CMD;
+}
+
+
+/*============================================================================*\
+              Functions for initialising parameters and functions
+\*============================================================================*/
+
+/******************************************************************************
+Function `cfgcli_init`:
+  Initialise the entry for all parameters and command line functions.
+Return:
+  The address of the structure.
+******************************************************************************/
+cfgcli_t *cfgcli_init(void) {
+  cfgcli_t *cfg = calloc(1, sizeof(cfgcli_t));
+  if (!cfg) return NULL;
+
+  cfgcli_error_t *err = calloc(1, sizeof(cfgcli_error_t));
+  if (!err) {
+    free(cfg);
+    return NULL;
+  }
+  err->msg = NULL;
+
+  cfg->params = cfg->funcs = cfg->blocks = cfg->intern = NULL;
+  cfg->includes = cfg->index = cfg->defer = cfg->maps = NULL;
+  cfg->lopts = NULL;
+  cfg->cmds = NULL;
+  cfg->cmd = NULL;
+  cfg->error = err;
+  return cfg;
+}
+
+/******************************************************************************
+Function `cfgcli_print_help_line`:
+  Print short and long options with their dashes
+Arguments:
+  * `buffer`:  output buffer with options sets
+  * `help_line`:  content to use for display
+Return:
+  Output string length.
+******************************************************************************/
+static size_t cfgcli_print_help_line(char *buffer, const cfgcli_help_line_t *help_line) {
+  size_t len = 0;
+  if (help_line->opt) {
+    len += sprintf(buffer, " -%c", help_line->opt);
+    if (help_line->lopt) {
+      len += sprintf(buffer + len, ",");
+    }
+  }
+  if (help_line->lopt) {
+    len += sprintf(buffer + len, " --%s", help_line->lopt);
+  }
+  if (help_line->dtype != CFGCLI_DTYPE_NULL && help_line->dtype != CFGCLI_DTYPE_BOOL) {
+    len += sprintf(buffer + len, " %s", help_line->name);
+  }
+  if (help_line->help) {
+    len += sprintf(buffer + len, "\n    %s", help_line->help);
+  }
+  return len;
+}
+
+/******************************************************************************
+Function `cfgcli_print_param`:
+  Wrapper to `cfgcli_print_help_line` for `cfgcli_param_valid_t` parameter
+Arguments:
+  * `buffer`:  output buffer with options sets
+  * `param`:  parameter to display
+Return:
+  Output string length.
+******************************************************************************/
+static size_t cfgcli_print_param(char *buffer, const cfgcli_param_valid_t *param) {
+  cfgcli_help_line_t *help_content = malloc(sizeof(cfgcli_help_line_t));
+  help_content->dtype = param->dtype;
+  help_content->opt = param->opt;
+  help_content->lopt = param->lopt;
+  help_content->name = param->name;
+  help_content->help = param->help;
+  return cfgcli_print_help_line(buffer, help_content);
+}
+
+/******************************************************************************
+Function `cfgcli_print_func`:
+  Wrapper to `cfgcli_print_help_line` for `cfgcli_func_valid_t` parameter
+Arguments:
+  * `buffer`:  output buffer with options sets
+  * `func`:  function to display
+Return:
+  Output string length.
+******************************************************************************/
+static size_t cfgcli_print_func(char *buffer, const cfgcli_func_valid_t *func) {
+  cfgcli_help_line_t *help_content = malloc(sizeof(cfgcli_help_line_t));
+  help_content->dtype = CFGCLI_DTYPE_NULL;
+  help_content->opt = func->opt;
+  help_content->lopt = func->lopt;
+  help_content->name = NULL;
+  help_content->help = func->help;
+  return cfgcli_print_help_line(buffer, help_content);
+}
+
+/******************************************************************************
+Function `cfgcli_print_help`:
+  Print help messages based on validated parameters
+Arguments:
+  * `cfg`:      entry for all configuration parameters;
+******************************************************************************/
+void cfgcli_print_help(cfgcli_t *cfg) {
+	size_t used_len = 0;
+	int dash_size_overload = 13;
+	char buffer[CFGCLI_MAX_LOPT_LEN + CFGCLI_MAX_NAME_LEN + dash_size_overload + CFGCLI_MAX_HELP_LEN];
+	bzero(buffer, CFGCLI_MAX_LOPT_LEN + CFGCLI_MAX_NAME_LEN + dash_size_overload + CFGCLI_MAX_HELP_LEN);
+	if (cfg && !CFGCLI_IS_ERROR(cfg)) {
+		if (cfg->npar > 0) {
+			const cfgcli_param_valid_t *param = (cfgcli_param_valid_t *)cfg->params;
+			printf("Option%c:\n", cfg->npar > 1 ? 's' : '\0');
+			for (size_t i = 0; i < cfg->npar; ++i) {
+				used_len = cfgcli_print_param(buffer, &param[i]);
+				printf("%s\n", buffer);
+				bzero(buffer, used_len);
+			}
+			printf("\n");
+		}
+		else {
+			cfgcli_msg(cfg, "the parameter list is not set", NULL);
+		}
+		if (cfg->nfunc > 0) {
+			const cfgcli_func_valid_t *param = (cfgcli_func_valid_t *)cfg->funcs;
+			printf("Function%c:\n", cfg->nfunc > 1 ? 's' : '\0');
+			for (size_t i = 0; i < cfg->nfunc; ++i) {
+				used_len = cfgcli_print_func(buffer, &param[i]);
+				printf("%s\n", buffer);
+				bzero(buffer, used_len);
+			}
+			printf("\n");
+		}
+		else {
+			cfgcli_msg(cfg, "the function list is not set", NULL);
+		}
+		if (cfg->ncmd > 0) {
+			const cfgcli_cmd_valid_t *cmd = (cfgcli_cmd_valid_t *)cfg->cmds;
+			printf("Subcommand%s:\n", cfg->ncmd > 1 ? "s" : "");
+			for (size_t i = 0; i < cfg->ncmd; ++i)
+				printf("  %-24s %s\n", cmd[i].name, cmd[i].help ? cmd[i].help : "");
+			printf("\n");
+		}
+	}
+}
+
+/******************************************************************************
+Function `cfgcli_print_usage`:
+  Print usage messages based on validated parameters and provided progname
+Arguments:
+  * `cfg`:      entry for all configuration parameters;
+  * `progname`: program name to be displayed
 ******************************************************************************/
 void cfgcli_print_usage(cfgcli_t *cfg, char *progname) {
   if (cfg && !CFGCLI_IS_ERROR(cfg)) {
@@ -386,7 +1472,8 @@ void cfgcli_print_usage(cfgcli_t *cfg, char *progname) {
     }  // Singularize
     else if (cfg->nfunc == 0)
       *functions = '\0'; // Remove functions
-    printf("Usage: %s%s%s\n", progname, options, functions);
+    printf("Usage: %s%s%s%s\n", progname, options, functions,
+        cfg->ncmd > 0 ? " COMMAND [ARGS]" : "");
   }
 }
 
@@ -440,7 +1527,13 @@ int cfgcli_set_params(cfgcli_t *cfg, const cfgcli_param_t *param, const int npar
     }
     int j = 1;
     while (str[j] != '\0') {
-      if (!isalnum(str[j]) && str[j] != '_' && str[j] != '-') {
+      if (str[j] == CFGCLI_SYM_SECTION_SEP) {      /* start of a name segment */
+        if (!isalpha(str[j + 1]) && str[j + 1] != '_' && str[j + 1] != '-') {
+          cfgcli_msg(cfg, "invalid parameter name in the list with index", tmp);
+          return CFGCLI_ERRNO(cfg) = CFGCLI_ERR_INPUT;
+        }
+      }
+      else if (!isalnum(str[j]) && str[j] != '_' && str[j] != '-') {
         cfgcli_msg(cfg, "invalid parameter name in the list with index", tmp);
         return CFGCLI_ERRNO(cfg) = CFGCLI_ERR_INPUT;
       }
@@ -513,20 +1606,21 @@ int cfgcli_set_params(cfgcli_t *cfg, const cfgcli_param_t *param, const int npar
     par->hlen = j + 1;       /* length of help with the ending '\0' */
 
     /* Check duplicates with the registered parameters. */
-    for (j = 0; j < cfg->npar + i; j++) {
-      if (!strncmp(par->name, vpar[j].name, par->nlen)) {
+    switch (cfgcli_index_param(cfg, cfg->npar + i)) {
+      case 0:
+        break;
+      case CFGCLI_ERR_EXIST:
         cfgcli_msg(cfg, "duplicate parameter name", par->name);
         return CFGCLI_ERRNO(cfg) = CFGCLI_ERR_EXIST;
-      }
+      default:
+        cfgcli_msg(cfg, "failed to allocate memory for parameters", NULL);
+        return CFGCLI_ERRNO(cfg) = CFGCLI_ERR_MEMORY;
+    }
+    for (j = 0; j < cfg->npar + i; j++) {
       if (par->opt && par->opt == vpar[j].opt) {
         cfgcli_msg(cfg, "duplicate short command line option", tmp);
         return CFGCLI_ERRNO(cfg) = CFGCLI_ERR_EXIST;
       }
-      if (par->lopt && vpar[j].lopt &&
-          !strncmp(par->lopt, vpar[j].lopt, par->llen)) {
-        cfgcli_msg(cfg, "duplicate long command line option", par->lopt);
-        return CFGCLI_ERRNO(cfg) = CFGCLI_ERR_EXIST;
-      }
     }
 
     /* Check duplicates with the registered functions. */
@@ -536,11 +1630,21 @@ int cfgcli_set_params(cfgcli_t *cfg, const cfgcli_param_t *param, const int npar
         cfgcli_msg(cfg, "duplicate short command line option", tmp);
         return CFGCLI_ERRNO(cfg) = CFGCLI_ERR_EXIST;
       }
-      if (par->lopt && cfunc[j].lopt &&
-          !strncmp(par->lopt, cfunc[j].lopt, par->llen)) {
-        cfgcli_msg(cfg, "duplicate long command line option", par->lopt);
-        return CFGCLI_ERRNO(cfg) = CFGCLI_ERR_EXIST;
-      }
+    }
+
+    /* Long options of both parameters and functions are in the trie. */
+    if (par->lopt) {
+      switch (cfgcli_trie_add(cfg, par->lopt, par->llen - 1,
+          CFGCLI_TRIE_PARAM(cfg->npar + i))) {
+        case 0:
+          break;
+        case CFGCLI_ERR_EXIST:
+          cfgcli_msg(cfg, "duplicate long command line option", par->lopt);
+          return CFGCLI_ERRNO(cfg) = CFGCLI_ERR_EXIST;
+        default:
+          cfgcli_msg(cfg, "failed to allocate memory for parameters", NULL);
+          return CFGCLI_ERRNO(cfg) = CFGCLI_ERR_MEMORY;
+      }
     }
   }
 
@@ -661,11 +1765,6 @@ int cfgcli_set_funcs(cfgcli_t *cfg, const cfgcli_func_t *func, const int nfunc)
         cfgcli_msg(cfg, "duplicate short command line option", tmp);
         return CFGCLI_ERRNO(cfg) = CFGCLI_ERR_EXIST;
       }
-      if (fun->lopt && vfunc[j].lopt &&
-          !strncmp(fun->lopt, vfunc[j].lopt, fun->llen)) {
-        cfgcli_msg(cfg, "duplicate long command line option", fun->lopt);
-        return CFGCLI_ERRNO(cfg) = CFGCLI_ERR_EXIST;
-      }
     }
 
     /* Check duplicates with the registered parameters. */
@@ -677,10 +1776,20 @@ int cfgcli_set_funcs(cfgcli_t *cfg, const cfgcli_func_t *func, const int nfunc)
         cfgcli_msg(cfg, "duplicate short command line option", tmp);
         return CFGCLI_ERRNO(cfg) = CFGCLI_ERR_EXIST;
       }
-      if (fun->lopt && cpar[j].lopt &&
-          !strncmp(fun->lopt, cpar[j].lopt, fun->llen)) {
-        cfgcli_msg(cfg, "duplicate long command line option", fun->lopt);
-        return CFGCLI_ERRNO(cfg) = CFGCLI_ERR_EXIST;
+    }
+
+    /* Long options of both parameters and functions are in the trie. */
+    if (fun->lopt) {
+      switch (cfgcli_trie_add(cfg, fun->lopt, fun->llen - 1,
+          CFGCLI_TRIE_FUNC(cfg->nfunc + i))) {
+        case 0:
+          break;
+        case CFGCLI_ERR_EXIST:
+          cfgcli_msg(cfg, "duplicate long command line option", fun->lopt);
+          return CFGCLI_ERRNO(cfg) = CFGCLI_ERR_EXIST;
+        default:
+          cfgcli_msg(cfg, "failed to allocate memory for functions", NULL);
+          return CFGCLI_ERRNO(cfg) = CFGCLI_ERR_MEMORY;
       }
     }
   }
@@ -689,19 +1798,208 @@ int cfgcli_set_funcs(cfgcli_t *cfg, const cfgcli_func_t *func, const int nfunc)
   return 0;
 }
 
+/******************************************************************************
+Function `cfgcli_set_cmds`:
+  Verify and register subcommands.
+Arguments:
+  * `cfg`:      entry for all subcommands;
+  * `cmd`:      stucture for the input subcommands;
+  * `ncmd`:     number of input subcommands.
+Return:
+  Zero on success; non-zero on error.
+******************************************************************************/
+int cfgcli_set_cmds(cfgcli_t *cfg, const cfgcli_cmd_t *cmd, const int ncmd) {
+  /* Validate arguments. */
+  if (!cfg) return CFGCLI_ERR_INIT;
+  if (CFGCLI_IS_ERROR(cfg)) return CFGCLI_ERRNO(cfg);
+  if (!cmd || ncmd <= 0) {
+    cfgcli_msg(cfg, "the subcommand list is not set", NULL);
+    return CFGCLI_ERRNO(cfg) = CFGCLI_ERR_INPUT;
+  }
+
+  /* Allocate memory for subcommands. */
+  cfgcli_cmd_valid_t *vcmd = realloc(cfg->cmds,
+      (ncmd + cfg->ncmd) * sizeof *vcmd);
+  if (!vcmd) {
+    cfgcli_msg(cfg, "failed to allocate memory for subcommands", NULL);
+    return CFGCLI_ERRNO(cfg) = CFGCLI_ERR_MEMORY;
+  }
+  memset(vcmd + cfg->ncmd, 0, ncmd * sizeof *vcmd);
+  cfg->cmds = vcmd;
+
+  /* Register subcommands. */
+  for (int i = 0; i < ncmd; i++) {
+    cfgcli_cmd_valid_t *sub = vcmd + cfg->ncmd + i;
+    char tmp[CFGCLI_NUM_MAX_SIZE(int)];
+    sprintf(tmp, "%d", i);
+
+    /* Verify the name, which must not look like an option. */
+    char *str = cmd[i].name;
+    if (!str || str[0] == '\0' || str[0] == CFGCLI_CMD_FLAG ||
+        str[0] == CFGCLI_CMD_RESPONSE) {
+      cfgcli_msg(cfg, "invalid name of subcommand index", tmp);
+      return CFGCLI_ERRNO(cfg) = CFGCLI_ERR_INPUT;
+    }
+    size_t j = 0;
+    while (str[j] != '\0') {
+      if (!isgraph(str[j]) || ++j >= CFGCLI_MAX_NAME_LEN) {
+        cfgcli_msg(cfg, "invalid name of subcommand index", tmp);
+        return CFGCLI_ERRNO(cfg) = CFGCLI_ERR_INPUT;
+      }
+    }
+    sub->name = str;
+    sub->nlen = j;
+
+    /* Verify the registration function. */
+    if (!(sub->func = cmd[i].func)) {
+      cfgcli_msg(cfg, "registration function not set for subcommand",
+          sub->name);
+      return CFGCLI_ERRNO(cfg) = CFGCLI_ERR_INPUT;
+    }
+    sub->args = cmd[i].args;
+
+    /* Verify the help message. */
+    if ((str = cmd[i].help)) {
+      for (j = 0; str[j] != '\0'; j++) {
+        if (j + 1 >= CFGCLI_MAX_HELP_LEN) {
+          cfgcli_msg(cfg, "invalid help (too long) for subcommand", sub->name);
+          return CFGCLI_ERRNO(cfg) = CFGCLI_ERR_INPUT;
+        }
+      }
+      sub->help = str;
+    }
+
+    /* Check duplicates with the registered subcommands. */
+    for (int k = 0; k < cfg->ncmd + i; k++) {
+      if (sub->nlen == vcmd[k].nlen && !memcmp(sub->name, vcmd[k].name,
+          sub->nlen)) {
+        cfgcli_msg(cfg, "duplicate subcommand", sub->name);
+        return CFGCLI_ERRNO(cfg) = CFGCLI_ERR_EXIST;
+      }
+    }
+  }
+
+  cfg->ncmd += ncmd;
+  return 0;
+}
+
+/******************************************************************************
+Function `cfgcli_get_cmd`:
+  Get the name of the innermost subcommand selected from the command line.
+Arguments:
+  * `cfg`:      entry for all subcommands.
+Return:
+  The name of the subcommand; NULL if no subcommand is selected.
+******************************************************************************/
+const char *cfgcli_get_cmd(const cfgcli_t *cfg) {
+  return cfg ? cfg->cmd : NULL;
+}
+
 
 /*============================================================================*\
           Functions for parsing configurations represented by strings
 \*============================================================================*/
 
+/******************************************************************************
+Function `cfgcli_elem_dtype`:
+  Return the data type of elements for an array data type.
+Arguments:
+  * `dtype`:    data type of the array.
+Return:
+  Data type of the array elements; CFGCLI_DTYPE_NULL for non-array types.
+******************************************************************************/
+static cfgcli_dtype_t cfgcli_elem_dtype(const cfgcli_dtype_t dtype) {
+  switch (dtype) {
+    case CFGCLI_ARRAY_BOOL: return CFGCLI_DTYPE_BOOL;
+    case CFGCLI_ARRAY_CHAR: return CFGCLI_DTYPE_CHAR;
+    case CFGCLI_ARRAY_INT:  return CFGCLI_DTYPE_INT;
+    case CFGCLI_ARRAY_LONG: return CFGCLI_DTYPE_LONG;
+    case CFGCLI_ARRAY_FLT:  return CFGCLI_DTYPE_FLT;
+    case CFGCLI_ARRAY_DBL:  return CFGCLI_DTYPE_DBL;
+    case CFGCLI_ARRAY_STR:  return CFGCLI_DTYPE_STR;
+    case CFGCLI_ARRAY_STRV: return CFGCLI_DTYPE_STRV;
+    case CFGCLI_ARRAY_INT8:   return CFGCLI_DTYPE_INT8;
+    case CFGCLI_ARRAY_INT16:  return CFGCLI_DTYPE_INT16;
+    case CFGCLI_ARRAY_INT32:  return CFGCLI_DTYPE_INT32;
+    case CFGCLI_ARRAY_INT64:  return CFGCLI_DTYPE_INT64;
+    case CFGCLI_ARRAY_UINT8:  return CFGCLI_DTYPE_UINT8;
+    case CFGCLI_ARRAY_UINT16: return CFGCLI_DTYPE_UINT16;
+    case CFGCLI_ARRAY_UINT32: return CFGCLI_DTYPE_UINT32;
+    case CFGCLI_ARRAY_UINT64: return CFGCLI_DTYPE_UINT64;
+    case CFGCLI_ARRAY_SIZE:   return CFGCLI_DTYPE_SIZE;
+    case CFGCLI_ARRAY_BITS:   return CFGCLI_DTYPE_BOOL;
+    case CFGCLI_NDARRAY_INT:  return CFGCLI_DTYPE_INT;
+    case CFGCLI_NDARRAY_LONG: return CFGCLI_DTYPE_LONG;
+    case CFGCLI_NDARRAY_FLT:  return CFGCLI_DTYPE_FLT;
+    case CFGCLI_NDARRAY_DBL:  return CFGCLI_DTYPE_DBL;
+    default:                return CFGCLI_DTYPE_NULL;
+  }
+}
+
+/******************************************************************************
+Function `cfgcli_dtype_size`:
+  Return the size of a variable, or an array element, of a given data type.
+Arguments:
+  * `dtype`:    the data type.
+Return:
+  Size of the variable or element in bytes; 0 for invalid data types.
+******************************************************************************/
+static size_t cfgcli_dtype_size(const cfgcli_dtype_t dtype) {
+  switch (dtype) {
+    case CFGCLI_DTYPE_BOOL: case CFGCLI_ARRAY_BOOL: return sizeof(bool);
+    case CFGCLI_DTYPE_CHAR: case CFGCLI_ARRAY_CHAR: return sizeof(char);
+    case CFGCLI_DTYPE_INT:  case CFGCLI_ARRAY_INT:  return sizeof(int);
+    case CFGCLI_DTYPE_LONG: case CFGCLI_ARRAY_LONG: return sizeof(long);
+    case CFGCLI_DTYPE_FLT:  case CFGCLI_ARRAY_FLT:  return sizeof(float);
+    case CFGCLI_DTYPE_DBL:  case CFGCLI_ARRAY_DBL:  return sizeof(double);
+    case CFGCLI_DTYPE_STR:  case CFGCLI_ARRAY_STR:  return sizeof(char *);
+    case CFGCLI_DTYPE_STRV: case CFGCLI_ARRAY_STRV:
+      return sizeof(cfgcli_strview_t);
+    case CFGCLI_DTYPE_INT8:   case CFGCLI_ARRAY_INT8:   return sizeof(int8_t);
+    case CFGCLI_DTYPE_INT16:  case CFGCLI_ARRAY_INT16:  return sizeof(int16_t);
+    case CFGCLI_DTYPE_INT32:  case CFGCLI_ARRAY_INT32:  return sizeof(int32_t);
+    case CFGCLI_DTYPE_INT64:  case CFGCLI_ARRAY_INT64:  return sizeof(int64_t);
+    case CFGCLI_DTYPE_UINT8:  case CFGCLI_ARRAY_UINT8:  return sizeof(uint8_t);
+    case CFGCLI_DTYPE_UINT16: case CFGCLI_ARRAY_UINT16: return sizeof(uint16_t);
+    case CFGCLI_DTYPE_UINT32: case CFGCLI_ARRAY_UINT32: return sizeof(uint32_t);
+    case CFGCLI_DTYPE_UINT64: case CFGCLI_ARRAY_UINT64: return sizeof(uint64_t);
+    case CFGCLI_DTYPE_SIZE:   case CFGCLI_ARRAY_SIZE:   return sizeof(size_t);
+    case CFGCLI_ARRAY_BITS:   return sizeof(uint64_t);  /* size of words */
+    case CFGCLI_NDARRAY_INT:  return sizeof(int);
+    case CFGCLI_NDARRAY_LONG: return sizeof(long);
+    case CFGCLI_NDARRAY_FLT:  return sizeof(float);
+    case CFGCLI_NDARRAY_DBL:  return sizeof(double);
+    case CFGCLI_DTYPE_BLOB:   return sizeof(unsigned char *);
+    default:                                        return 0;
+  }
+}
+
+/******************************************************************************
+Function `cfgcli_find_param`:
+  Search for a registered parameter given its name.
+Arguments:
+  * `cfg`:      entry for all configurations;
+  * `name`:     the null terminated name of the parameter.
+Return:
+  Address of the parameter on success; NULL if it is not registered.
+******************************************************************************/
+static cfgcli_param_valid_t *cfgcli_find_param(const cfgcli_t *cfg,
+    const char *name) {
+  const cfgcli_index_t *idx = (cfgcli_index_t *) cfg->index;
+  const int n = cfgcli_index_find(idx, name, strlen(name));
+  if (n < 0 || idx->node[n].par < 0 || idx->node[n].par >= cfg->npar)
+    return NULL;
+  return (cfgcli_param_valid_t *) cfg->params + idx->node[n].par;
+}
+
 /******************************************************************************
 Function `cfgcli_parse_line`:
   Read the configuration from a line of a configration file.
 Arguments:
   * `line`:     the null terminated string line;
   * `len`:      length of the line, NOT including the first '\0';
-  * `key`:      address of the retrieved keyword;
-  * `value`:    address of the retrieved value;
+  * `key`:      address of the retrieved keyword, or section name;
+  * `value`:    address of the retrieved value, or path of the included file;
   * `state`:    initial state for the parser.
 Return:
   Parser status.
@@ -711,6 +2009,9 @@ static cfgcli_parse_return_t cfgcli_parse_line(char *line, const size_t len,
   if (!line || *line == '\0' || len == 0) return CFGCLI_PARSE_PASS;
   char quote = '\0';            /* handle quotation marks */
   char *newline = NULL;                /* handle line continuation */
+  /* Depth of nested arrays, which is unknown for continued lines. */
+  const bool continued = (state != CFGCLI_PARSE_START);
+  int depth = 0;
   for (size_t i = 0; i < len; i++) {
     char c = line[i];
     switch (state) {
@@ -719,6 +2020,10 @@ static cfgcli_parse_return_t cfgcli_parse_line(char *line, const size_t len,
           *key = line + i;
           state = CFGCLI_PARSE_KEYWORD;
         }
+        else if (c == CFGCLI_SYM_SECTION_START) {  /* section header */
+          *key = line + i + 1;
+          state = CFGCLI_PARSE_SECTION_NAME;
+        }
         else if (c == CFGCLI_SYM_COMMENT) return CFGCLI_PARSE_PASS;
         else if (!isspace(c)) return CFGCLI_PARSE_ERROR;
         break;
@@ -730,10 +2035,40 @@ static cfgcli_parse_return_t cfgcli_parse_line(char *line, const size_t len,
           state = (c == CFGCLI_SYM_EQUAL) ?
             CFGCLI_PARSE_VALUE_START : CFGCLI_PARSE_EQUAL;
         }
-        else if (!isalnum(c) && c != '_' && c != '-') return CFGCLI_PARSE_ERROR;
+        else if (!isalnum(c) && c != '_' && c != '-' &&
+            c != CFGCLI_SYM_SECTION_SEP) return CFGCLI_PARSE_ERROR;
+        break;
+      case CFGCLI_PARSE_SECTION_NAME:
+        if (c == CFGCLI_SYM_SECTION_END) {
+          if (line + i - *key >= CFGCLI_MAX_NAME_LEN) return CFGCLI_PARSE_ERROR;
+          line[i] = '\0';                       /* terminate the section */
+          state = CFGCLI_PARSE_SECTION_END;
+        }
+        else if (!isalnum(c) && c != '_' && c != '-' &&
+            c != CFGCLI_SYM_SECTION_SEP) return CFGCLI_PARSE_ERROR;
+        break;
+      case CFGCLI_PARSE_SECTION_END:
+        if (c == CFGCLI_SYM_COMMENT) return CFGCLI_PARSE_SECTION;
+        else if (!isspace(c)) return CFGCLI_PARSE_ERROR;
         break;
       case CFGCLI_PARSE_EQUAL:
         if (c == CFGCLI_SYM_EQUAL) state = CFGCLI_PARSE_VALUE_START;
+        else if ((c == '"' || c == '\'') &&
+            !strcmp(*key, CFGCLI_SYM_INCLUDE)) {   /* include directive */
+          quote = c;
+          *value = line + i + 1;
+          state = CFGCLI_PARSE_INCLUDE_PATH;
+        }
+        else if (!isspace(c)) return CFGCLI_PARSE_ERROR;
+        break;
+      case CFGCLI_PARSE_INCLUDE_PATH:
+        if (c == quote) {
+          line[i] = '\0';                       /* terminate the path */
+          state = CFGCLI_PARSE_INCLUDE_END;
+        }
+        break;
+      case CFGCLI_PARSE_INCLUDE_END:
+        if (c == CFGCLI_SYM_COMMENT) return CFGCLI_PARSE_INCLUDE;
         else if (!isspace(c)) return CFGCLI_PARSE_ERROR;
         break;
       case CFGCLI_PARSE_VALUE_START:
@@ -744,6 +2079,7 @@ static cfgcli_parse_return_t cfgcli_parse_line(char *line, const size_t len,
         }
         else if (c == CFGCLI_SYM_ARRAY_START) {    /* beginning of array */
           *value = line + i;
+          depth = 1;
           state = CFGCLI_PARSE_ARRAY_START;
         }
         else if (c == CFGCLI_SYM_COMMENT) return CFGCLI_PARSE_PASS;   /* no value */
@@ -765,6 +2101,7 @@ static cfgcli_parse_return_t cfgcli_parse_line(char *line, const size_t len,
           newline = line + i;
           state = CFGCLI_PARSE_ARRAY_NEWLINE;
         }
+        else if (c == CFGCLI_SYM_ARRAY_START) depth++;     /* nested array */
         else if (isgraph(c)) state = CFGCLI_PARSE_ARRAY_VALUE;
         else if (!isspace(c)) return CFGCLI_PARSE_ERROR;
         break;
@@ -778,8 +2115,10 @@ static cfgcli_parse_return_t cfgcli_parse_line(char *line, const size_t len,
       case CFGCLI_PARSE_ARRAY_VALUE:
         if (c == CFGCLI_SYM_ARRAY_SEP)             /* new array element */
           state = CFGCLI_PARSE_ARRAY_START;
-        else if (c == CFGCLI_SYM_ARRAY_END)        /* end of array */
+        else if (c == CFGCLI_SYM_ARRAY_END) {      /* end of array */
+          depth--;
           state = CFGCLI_PARSE_ARRAY_END;
+        }
         else if (c == CFGCLI_SYM_COMMENT || !isprint(c)) return CFGCLI_PARSE_ERROR;
         break;
       case CFGCLI_PARSE_QUOTE:
@@ -788,8 +2127,20 @@ static cfgcli_parse_return_t cfgcli_parse_line(char *line, const size_t len,
       case CFGCLI_PARSE_ARRAY_QUOTE:
         if (c == quote) state = CFGCLI_PARSE_ARRAY_QUOTE_END;
         break;
-      case CFGCLI_PARSE_QUOTE_END:
       case CFGCLI_PARSE_ARRAY_END:
+        /* Nested arrays are closed, or followed by other ones. */
+        if ((continued || depth > 0) && c == CFGCLI_SYM_ARRAY_SEP) {
+          state = CFGCLI_PARSE_ARRAY_START;
+          break;
+        }
+        if ((continued || depth > 0) && c == CFGCLI_SYM_ARRAY_END) {
+          depth--;
+          break;
+        }
+#if __STDC_VERSION__ > 201710L
+        [[fallthrough]];
+#endif
+      case CFGCLI_PARSE_QUOTE_END:
         if (c == CFGCLI_SYM_COMMENT) {
           line[i] = '\0';
           return CFGCLI_PARSE_DONE;
@@ -798,7 +2149,10 @@ static cfgcli_parse_return_t cfgcli_parse_line(char *line, const size_t len,
         break;
       case CFGCLI_PARSE_ARRAY_QUOTE_END:
         if (c == CFGCLI_SYM_ARRAY_SEP) state = CFGCLI_PARSE_ARRAY_START;
-        else if (c == CFGCLI_SYM_ARRAY_END) state = CFGCLI_PARSE_ARRAY_END;
+        else if (c == CFGCLI_SYM_ARRAY_END) {
+          depth--;
+          state = CFGCLI_PARSE_ARRAY_END;
+        }
         else if (!isspace(c)) return CFGCLI_PARSE_ERROR;
         break;
       case CFGCLI_PARSE_ARRAY_NEWLINE:             /* line continuation */
@@ -827,6 +2181,10 @@ static cfgcli_parse_return_t cfgcli_parse_line(char *line, const size_t len,
     case CFGCLI_PARSE_QUOTE_END:
     case CFGCLI_PARSE_ARRAY_END:
       return CFGCLI_PARSE_DONE;
+    case CFGCLI_PARSE_INCLUDE_END:
+      return CFGCLI_PARSE_INCLUDE;
+    case CFGCLI_PARSE_SECTION_END:
+      return CFGCLI_PARSE_SECTION;
     case CFGCLI_PARSE_START:
     case CFGCLI_PARSE_VALUE_START:
       return CFGCLI_PARSE_PASS;
@@ -854,7 +2212,7 @@ static int cfgcli_parse_array(cfgcli_param_valid_t *par) {
   par->narr = 0;                /* no need to check whether `par` is NULL */
   if (!par->value || !par->vlen) return 0;              /* empty string */
 
-  int n = 0;
+  size_t n = 0;
   char quote = '\0';
   cfgcli_parse_state_t state = CFGCLI_PARSE_START;
   char *start, *end;
@@ -935,652 +2293,5295 @@ static int cfgcli_parse_array(cfgcli_param_valid_t *par) {
   return 0;
 }
 
+/******************************************************************************
+Function `cfgcli_get_integer`:
+  Convert a decimal integer to a fixed-width variable, with overflow check.
+Arguments:
+  * `var`:      pointer to the variable to be assigned value;
+  * `str`:      the string without leading whitespaces;
+  * `len`:      length of the string, no character beyond it is read;
+  * `dtype`:    data type of the variable;
+  * `n`:        number of characters converted.
+Return:
+  Zero on success; non-zero on error.
+******************************************************************************/
+static int cfgcli_get_integer(void *var, const char *str, const size_t len,
+    const cfgcli_dtype_t dtype, int *n) {
+  uint64_t max, v = 0;
+  int64_t min = 0;
+  switch (dtype) {
+    case CFGCLI_DTYPE_INT:    min = INT_MIN;   max = INT_MAX;    break;
+    case CFGCLI_DTYPE_LONG:   min = LONG_MIN;  max = LONG_MAX;   break;
+    case CFGCLI_DTYPE_INT8:   min = INT8_MIN;  max = INT8_MAX;   break;
+    case CFGCLI_DTYPE_INT16:  min = INT16_MIN; max = INT16_MAX;  break;
+    case CFGCLI_DTYPE_INT32:  min = INT32_MIN; max = INT32_MAX;  break;
+    case CFGCLI_DTYPE_INT64:  min = INT64_MIN; max = INT64_MAX;  break;
+    case CFGCLI_DTYPE_UINT8:  max = UINT8_MAX;                   break;
+    case CFGCLI_DTYPE_UINT16: max = UINT16_MAX;                  break;
+    case CFGCLI_DTYPE_UINT32: max = UINT32_MAX;                  break;
+    case CFGCLI_DTYPE_UINT64: max = UINT64_MAX;                  break;
+    case CFGCLI_DTYPE_SIZE:   max = SIZE_MAX;                    break;
+    default: return CFGCLI_ERR_DTYPE;
+  }
+
+  /* Accumulate the magnitude, and stop before it overflows. */
+  size_t i = 0;
+  bool neg = false;
+  if (i < len && (str[i] == '+' || str[i] == '-')) neg = (str[i++] == '-');
+  if (i == len || !isdigit(str[i])) return CFGCLI_ERR_PARSE;
+  for (; i < len && isdigit(str[i]); i++) {
+    const unsigned d = str[i] - '0';
+    if (v > (UINT64_MAX - d) / 10) return CFGCLI_ERR_VALUE;
+    v = v * 10 + d;
+  }
+  *n = (int) i;
+
+  /* Range check, with the magnitude of `min` being -(min + 1) + 1. */
+  if (neg && v) {
+    if (!min || v - 1 > (uint64_t) -(min + 1)) return CFGCLI_ERR_VALUE;
+    v = -v;                     /* two's complement, truncated on storage */
+  }
+  else if (v > max) return CFGCLI_ERR_VALUE;
+
+  switch (cfgcli_dtype_size(dtype)) {
+    case 1: *((uint8_t *) var) = (uint8_t) v;   break;
+    case 2: *((uint16_t *) var) = (uint16_t) v; break;
+    case 4: *((uint32_t *) var) = (uint32_t) v; break;
+    case 8: *((uint64_t *) var) = v;            break;
+    default: return CFGCLI_ERR_DTYPE;
+  }
+  return 0;
+}
+
 /******************************************************************************
 Function `cfgcli_get_value`:
-  Retrieve the parameter value and assign it to a variable.
+  Retrieve the parameter value and assign it to a variable, without
+  modifying the source string.
 Arguments:
   * `var`:      pointer to the variable to be assigned value;
   * `str`:      string storing the parameter value;
-  * `size`:     length of `value`, including the ending '\0';
+  * `size`:     length of `value`, the value ends earlier at the first '\0';
   * `dtype`:    data type;
   * `src`:      source of this value.
 Return:
   Zero on success; non-zero on error.
 ******************************************************************************/
-static int cfgcli_get_value(void *var, char *str, const size_t size,
+static int cfgcli_get_value(void *var, const char *str, const size_t size,
                          const cfgcli_dtype_t dtype, int src) {
   (void) src;
   if (!str || !size) return 0;
-  char *value = str;
+  const char *value = str;
+  const char *end = memchr(str, '\0', size);
+  if (!end) end = str + size;
+  size_t len;
   int n;
 
-  /* Validate the value. */
-  while (*value && isspace(*value)) value++;          /* omit whitespaces */
-  if (*value == '\0') return CFGCLI_ERR_VALUE;           /* empty string */
+  /* Validate the value, and locate it within [value, end). */
+  while (value < end && isspace(*value)) value++;     /* omit whitespaces */
+  if (value == end) return CFGCLI_ERR_VALUE;             /* empty string */
   if (*value == '"' || *value == '\'') {              /* remove quotes */
-    char quote = *value;
-    value++;
-    for (n = 0; value[n]; n++) {      /* the string is surely terminated */
-      if (value[n] == quote) {
-        value[n] = '\0';
-        quote = 0;    /* a flag indicating the other quote is found */
-        break;
-      }
-    }
+    const char quote = *value++;
+    const char *close = memchr(value, quote, end - value);
+    if (!close) return CFGCLI_ERR_VALUE;         /* open quotation marks */
+    for (const char *c = close + 1; c < end; c++)
+      if (!isspace(*c)) return CFGCLI_ERR_VALUE;
+    end = close;
     /* empty string with quotes is valid for char or string type variable */
-    if (*value == '\0' && dtype != CFGCLI_DTYPE_CHAR && dtype != CFGCLI_DTYPE_STR)
+    if (value == end && dtype != CFGCLI_DTYPE_CHAR &&
+        dtype != CFGCLI_DTYPE_STR && dtype != CFGCLI_DTYPE_STRV)
       return CFGCLI_ERR_VALUE;
-    if (quote) return CFGCLI_ERR_VALUE;          /* open quotation marks */
-    for (++n; value[n]; n++) if (!isspace(value[n])) return CFGCLI_ERR_VALUE;
   }
   else {                              /* remove trailing whitespaces */
-    char *val = str + size - 2;
-    while (isspace(*val)) {
-      *val = '\0';
-      val--;
-    }
+    while (isspace(end[-1])) end--;
   }
+  len = end - value;
 
-  /* Variable assignment. */
+  /* Variable assignment. Integers are converted in place, and real numbers
+     from a null terminated copy, so nothing beyond `end` is read. */
   n = 0;
   switch (dtype) {
     case CFGCLI_DTYPE_BOOL:
-      if (!strncmp(value, "1", 2) || !strncmp(value, "T", 2) ||
-          !strncmp(value, "t", 2) || !strncmp(value, "true", 5) ||
-          !strncmp(value, "TRUE", 5) || !strncmp(value, "True", 5))
+      if ((len == 1 && (*value == '1' || *value == 'T' || *value == 't')) ||
+          (len == 4 && (!memcmp(value, "true", 4) ||
+          !memcmp(value, "TRUE", 4) || !memcmp(value, "True", 4))))
         *((bool *) var) = true;
-      else if (!strncmp(value, "0", 2) || !strncmp(value, "F", 2) ||
-          !strncmp(value, "f", 2) || !strncmp(value, "false", 6) ||
-          !strncmp(value, "FALSE", 6) || !strncmp(value, "False", 6))
+      else if ((len == 1 && (*value == '0' || *value == 'F' || *value == 'f')) ||
+          (len == 5 && (!memcmp(value, "false", 5) ||
+          !memcmp(value, "FALSE", 5) || !memcmp(value, "False", 5))))
         *((bool *) var) = false;
       else return CFGCLI_ERR_PARSE;
       break;
     case CFGCLI_DTYPE_CHAR:
-      *((char *) var) = *value;
-      n = 1;
-      break;
-    case CFGCLI_DTYPE_INT:
-      if (sscanf(value, "%d%n", (int *) var, &n) != 1) return CFGCLI_ERR_PARSE;
-      break;
-    case CFGCLI_DTYPE_LONG:
-      if (sscanf(value, "%ld%n", (long *) var, &n) != 1) return CFGCLI_ERR_PARSE;
+      *((char *) var) = len ? *value : '\0';
+      n = len ? 1 : 0;
       break;
     case CFGCLI_DTYPE_FLT:
-      if (sscanf(value, "%f%n", (float *) var, &n) != 1) return CFGCLI_ERR_PARSE;
+    case CFGCLI_DTYPE_DBL: {
+      char num[CFGCLI_REAL_MAX_LEN + 1];
+      char *stop;
+      if (len > CFGCLI_REAL_MAX_LEN) return CFGCLI_ERR_VALUE;
+      memcpy(num, value, len);
+      num[len] = '\0';
+      if (dtype == CFGCLI_DTYPE_FLT) *((float *) var) = strtof(num, &stop);
+      else *((double *) var) = strtod(num, &stop);
+      if (stop == num) return CFGCLI_ERR_PARSE;
+      n = stop - num;
       break;
-    case CFGCLI_DTYPE_DBL:
-      if (sscanf(value, "%lf%n", (double *) var, &n) != 1) return CFGCLI_ERR_PARSE;
+    }
+    case CFGCLI_DTYPE_STR:      /* the destination has at least `size` bytes */
+      memcpy(*((char **) var), value, len);
+      (*((char **) var))[len] = '\0';
       break;
-    case CFGCLI_DTYPE_STR:
-      strcpy(*((char **) var), value);  /* the usage of strcpy is safe here */
+    case CFGCLI_DTYPE_STRV:             /* point to the source directly */
+      ((cfgcli_strview_t *) var)->ptr = value;
+      ((cfgcli_strview_t *) var)->len = len;
+      break;
+    case CFGCLI_DTYPE_INT:    case CFGCLI_DTYPE_LONG:
+    case CFGCLI_DTYPE_INT8:   case CFGCLI_DTYPE_INT16:
+    case CFGCLI_DTYPE_INT32:  case CFGCLI_DTYPE_INT64:
+    case CFGCLI_DTYPE_UINT8:  case CFGCLI_DTYPE_UINT16:
+    case CFGCLI_DTYPE_UINT32: case CFGCLI_DTYPE_UINT64:
+    case CFGCLI_DTYPE_SIZE: {
+      const int err = cfgcli_get_integer(var, value, len, dtype, &n);
+      if (err) return err;
       break;
+    }
     default:
       return CFGCLI_ERR_DTYPE;
   }
 
   if (n) {                      /* check remaining characters */
-    value += n;
-    while (*value != '\0') {
+    if ((size_t) n > len) return CFGCLI_ERR_VALUE;
+    for (value += n; value < end; value++)
       if (!isspace(*value)) return CFGCLI_ERR_VALUE;
-      value++;
-    }
   }
 
   return 0;
 }
 
 /******************************************************************************
-Function `cfgcli_get_array`:
-  Retrieve the parameter values and assign them to an array.
+Function `cfgcli_get_intern`:
+  Retrieve a string value and assign the interned copy to a variable.
 Arguments:
-  * `par`:      address of the verified configuration parameter;
-  * `src`:      source of the value.
+  * `cfg`:      entry for the configurations;
+  * `var`:      pointer to the string variable;
+  * `str`:      string storing the parameter value;
+  * `size`:     length of `str`, including the ending '\0';
+  * `src`:      source of this value.
 Return:
   Zero on success; non-zero on error.
 ******************************************************************************/
-static int cfgcli_get_array(cfgcli_param_valid_t *par, int src) {
-  size_t len;
-  int i, err;
-
-  /* Split the value string for array elements. */
-  if ((err = cfgcli_parse_array(par))) return err;
-  char *value = par->value;   /* array elements are separated by '\0' */
+static int cfgcli_get_intern(cfgcli_t *cfg, char **var, char *str,
+    const size_t size, const int src) {
+  /* Locate the value in place before interning it. */
+  cfgcli_strview_t view;
+  int err = cfgcli_get_value(&view, str, size, CFGCLI_DTYPE_STRV, src);
+  if (err) return err;
+  const char *istr = cfgcli_intern(cfg, view.ptr, view.len);
+  if (!istr) return CFGCLI_ERR_MEMORY;
+  *var = (char *) istr;
+  return 0;
+}
 
-  /* Allocate memory and assign values for arrays. */
-  switch (par->dtype) {
-    case CFGCLI_ARRAY_BOOL:
-      *((bool **) par->var) = calloc(par->narr, sizeof(bool));
-      if (!(*((bool **) par->var))) return CFGCLI_ERR_MEMORY;
-      /* call the value assignment function for each segment */
-      for (i = 0; i < par->narr; i++) {
-        len = strlen(value) + 1;      /* strlen is safe here */
-        if ((err = cfgcli_get_value(*((bool **) par->var) + i, value, len,
-            CFGCLI_DTYPE_BOOL, src))) return err;
-        value += len;
-      }
-      break;
-    case CFGCLI_ARRAY_CHAR:
-      *((char **) par->var) = calloc(par->narr, sizeof(char));
-      if (!(*((char **) par->var))) return CFGCLI_ERR_MEMORY;
-      for (i = 0; i < par->narr; i++) {
-        len = strlen(value) + 1;
-        if ((err = cfgcli_get_value(*((char **) par->var) + i, value, len,
-            CFGCLI_DTYPE_CHAR, src))) return err;
-        value += len;
-      }
-      break;
-    case CFGCLI_ARRAY_INT:
-      *((int **) par->var) = calloc(par->narr, sizeof(int));
-      if (!(*((int **) par->var))) return CFGCLI_ERR_MEMORY;
-      for (i = 0; i < par->narr; i++) {
-        len = strlen(value) + 1;
-        if ((err = cfgcli_get_value(*((int **) par->var) + i, value, len,
-            CFGCLI_DTYPE_INT, src))) return err;
-        value += len;
-      }
-      break;
-    case CFGCLI_ARRAY_LONG:
-      *((long **) par->var) = calloc(par->narr, sizeof(long));
-      if (!(*((long **) par->var))) return CFGCLI_ERR_MEMORY;
-      for (i = 0; i < par->narr; i++) {
-        len = strlen(value) + 1;
-        if ((err = cfgcli_get_value(*((long **) par->var) + i, value, len,
-            CFGCLI_DTYPE_LONG, src))) return err;
-        value += len;
-      }
-      break;
-    case CFGCLI_ARRAY_FLT:
-      *((float **) par->var) = calloc(par->narr, sizeof(float));
-      if (!(*((float **) par->var))) return CFGCLI_ERR_MEMORY;
-      for (i = 0; i < par->narr; i++) {
-        len = strlen(value) + 1;
-        if ((err = cfgcli_get_value(*((float **) par->var) + i, value, len,
-            CFGCLI_DTYPE_FLT, src))) return err;
-        value += len;
-      }
-      break;
-    case CFGCLI_ARRAY_DBL:
-      *((double **) par->var) = calloc(par->narr, sizeof(double));
-      if (!(*((double **) par->var))) return CFGCLI_ERR_MEMORY;
-      for (i = 0; i < par->narr; i++) {
-        len = strlen(value) + 1;
-        if ((err = cfgcli_get_value(*((double **) par->var) + i, value, len,
-            CFGCLI_DTYPE_DBL, src))) return err;
-        value += len;
-      }
-      break;
-    case CFGCLI_ARRAY_STR:
-      *((char ***) par->var) = calloc(par->narr, sizeof(char *));
-      if (!(*((char ***) par->var))) return CFGCLI_ERR_MEMORY;
-      /* Allocate enough memory for the first element of the string array. */
-      *(*((char ***) par->var)) = calloc(par->vlen, sizeof(char));
-      char *tmp = *(*((char ***) par->var));
-      if (!tmp) return CFGCLI_ERR_MEMORY;
-      /* The rest elements point to different positions of the space. */
-      for (i = 0; i < par->narr; i++) {
-        (*((char ***) par->var))[i] = tmp;
-        len = strlen(value) + 1;
-        if ((err = cfgcli_get_value(&tmp, value, len, CFGCLI_DTYPE_STR, src)))
-          return err;
-        tmp += strlen(tmp) + 1;       /* null termination ensured by calloc */
-        value += len;
-      }
+/******************************************************************************
+Function `cfgcli_convert_range`:
+  Convert the array elements that start in the range of a task.
+Arguments:
+  * `task`:     the task, with `first` set for the range.
+Return:
+  NULL; the error of the first failed element is saved in the task.
+******************************************************************************/
+static void *cfgcli_convert_range(void *arg) {
+  cfgcli_task_t *task = (cfgcli_task_t *) arg;
+  char *p = task->lo;
+  size_t i = task->first;
+  /* Skip the element that starts before the range. */
+  if (i && p[-1] != '\0') {
+    p += strlen(p) + 1;
+    i += 1;
+  }
+  for (; p < task->hi && i < task->narr; i++) {
+    const size_t len = strlen(p) + 1;
+    if ((task->err = cfgcli_get_value(task->arr + i * task->size, p, len,
+        task->dtype, task->src))) {
+      task->fail = i;
       break;
-    default:
-      return CFGCLI_ERR_DTYPE;             /* is CFGCLI_DTYPE_IS_ARRAY correct? */
+    }
+    p += len;
   }
-  return 0;
+  return NULL;
 }
 
+#ifdef HAVE_PTHREAD
 /******************************************************************************
-Function `cfgcli_get`:
-  Retrieve the parameter value and assign it to a variable.
+Function `cfgcli_count_sep`:
+  Count the '\0' separators of array elements in the range of a task.
+Arguments:
+  * `task`:     the task.
+Return:
+  NULL; the number of separators is saved in the task.
+******************************************************************************/
+static void *cfgcli_count_sep(void *arg) {
+  cfgcli_task_t *task = (cfgcli_task_t *) arg;
+  const char *p = task->lo;
+  task->nsep = 0;
+  while ((p = memchr(p, '\0', task->hi - p))) {
+    task->nsep += 1;
+    p += 1;
+  }
+  return NULL;
+}
+
+/******************************************************************************
+Function `cfgcli_run_tasks`:
+  Run a function for all tasks, with one thread for each task. Tasks for
+  which threads cannot be created are run by the calling thread.
+Arguments:
+  * `task`:     the tasks;
+  * `ntask`:    number of tasks;
+  * `func`:     the function to be run.
+******************************************************************************/
+static void cfgcli_run_tasks(cfgcli_task_t *task, const int ntask,
+    void *(*func) (void *)) {
+  pthread_t tid[CFGCLI_MAX_THREADS];
+  int i;
+  for (i = 1; i < ntask; i++)           /* the first task is run here */
+    if (pthread_create(tid + i, NULL, func, task + i)) break;
+  func(task);
+  for (int j = i; j < ntask; j++) func(task + j);
+  while (--i > 0) pthread_join(tid[i], NULL);
+}
+#endif
+
+/******************************************************************************
+Function `cfgcli_convert_elements`:
+  Convert the array elements separated by '\0', in parallel for large arrays.
 Arguments:
   * `cfg`:      entry for all configurations;
-  * `par`:      address of the verified configuration parameter;
-  * `src`:      source of the value;
+  * `arr`:      the destination array;
+  * `narr`:     number of elements;
+  * `dtype`:    data type of the elements;
+  * `value`:    the first element;
+  * `end`:      end of the string containing all elements;
+  * `src`:      source of the value.
 Return:
-  Zero on success; non-zero on error.
+  Zero on success; the error of the first failed element otherwise.
 ******************************************************************************/
-static int cfgcli_get(cfgcli_t *cfg, cfgcli_param_valid_t *par, int src) {
-  int err = 0;
-  /* Validate function arguments. */
-  if (CFGCLI_IS_ERROR(cfg)) return CFGCLI_ERRNO(cfg);
-  if (!par->value || *par->value == '\0') return 0;     /* value not set */
+static int cfgcli_convert_elements(cfgcli_t *cfg, char *arr, const size_t narr,
+    const cfgcli_dtype_t dtype, char *value, char *end, const int src) {
+  cfgcli_task_t task[CFGCLI_MAX_THREADS];
+  int ntask = 1;
+#ifdef HAVE_PTHREAD
+  if (cfg->nthread > 1 && narr >= 2 * CFGCLI_PARALLEL_MIN_ELEM) {
+    ntask = (narr / CFGCLI_PARALLEL_MIN_ELEM < (size_t) cfg->nthread) ?
+      (size_t) (narr / CFGCLI_PARALLEL_MIN_ELEM) : (size_t) cfg->nthread;
+  }
+#endif
+  const size_t len = end - value;
+  for (int i = 0; i < ntask; i++) {
+    task[i].lo = value + len * i / ntask;
+    task[i].hi = value + len * (i + 1) / ntask;
+    task[i].arr = arr;
+    task[i].size = cfgcli_dtype_size(dtype);
+    task[i].narr = narr;
+    task[i].first = task[i].nsep = 0;
+    task[i].dtype = dtype;
+    task[i].src = src;
+    task[i].err = 0;
+  }
 
-  /* Deal with arrays and scalars separately. */
-  if (CFGCLI_DTYPE_IS_ARRAY(par->dtype))   /* force preprocessing the value */
-    err = cfgcli_get_array(par, src);
-  else {
-    /* Allocate memory only for string. */
-    if (par->dtype == CFGCLI_DTYPE_STR) {
-      *((char **) par->var) = calloc(par->vlen, sizeof(char));
-      if (!(*((char **) par->var))) err = CFGCLI_ERR_MEMORY;
-    }
+#ifdef HAVE_PTHREAD
+  /* Index elements by the separators before the ranges. */
+  if (ntask > 1) {
+    cfgcli_run_tasks(task, ntask, cfgcli_count_sep);
+    for (int i = 1; i < ntask; i++)
+      task[i].first = task[i - 1].first + task[i - 1].nsep;
+    cfgcli_run_tasks(task, ntask, cfgcli_convert_range);
+  }
+  else
+#endif
+  cfgcli_convert_range(task);
 
-    /* Assign values to the variable.  */
-    if (!err)
-      err = cfgcli_get_value(par->var, par->value, par->vlen, par->dtype, src);
+  /* Report the first failed element, regardless of the number of threads. */
+  for (int i = 0; i < ntask; i++) {
+    if (task[i].err) {
+      char msg[CFGCLI_NUM_MAX_SIZE(size_t)];
+      sprintf(msg, "%zu", task[i].fail);
+      cfgcli_msg(cfg, "failed to convert the array element with index", msg);
+      return task[i].err;
+    }
   }
+  return 0;
+}
 
-  switch (err) {
-    case 0:
-      return 0;
-    case CFGCLI_ERR_MEMORY:
-      cfgcli_msg(cfg, "failed to allocate memory for parameter", par->name);
-      return CFGCLI_ERRNO(cfg) = err;
-    case CFGCLI_ERR_VALUE:
-      cfgcli_msg(cfg, "invalid value for parameter", par->name);
-      return CFGCLI_ERRNO(cfg) = err;
-    case CFGCLI_ERR_PARSE:
-      cfgcli_msg(cfg, "failed to parse the value for parameter", par->name);
-      return CFGCLI_ERRNO(cfg) = err;
-    case CFGCLI_ERR_DTYPE:
-      cfgcli_msg(cfg, "invalid data type for parameter", par->name);
-      return CFGCLI_ERRNO(cfg) = err;
-    default:
-      cfgcli_msg(cfg, "unknown error occurred for parameter", par->name);
-      return CFGCLI_ERRNO(cfg) = err;
+/******************************************************************************
+Function `cfgcli_set_threads`:
+  Set the number of threads for converting large arrays.
+Arguments:
+  * `cfg`:      entry for the configurations;
+  * `nthread`:  number of threads, 1 or 0 for sequential conversions.
+Return:
+  Zero on success; non-zero on error.
+******************************************************************************/
+int cfgcli_set_threads(cfgcli_t *cfg, const int nthread) {
+  if (!cfg) return CFGCLI_ERR_INIT;
+  if (CFGCLI_IS_ERROR(cfg)) return CFGCLI_ERRNO(cfg);
+  if (nthread < 0 || nthread > CFGCLI_MAX_THREADS) {
+    cfgcli_msg(cfg, "invalid number of threads", NULL);
+    return CFGCLI_ERRNO(cfg) = CFGCLI_ERR_INPUT;
   }
+  cfg->nthread = nthread;
+  return 0;
 }
 
-
-/*============================================================================*\
-                High-level functions for reading configurations
-                    from command line options and text files
-\*============================================================================*/
-
 /******************************************************************************
-Function `cfgcli_read_opts`:
-  Parse command line options.
+Function `cfgcli_set_sink`:
+  Attach a callback to an array parameter, which receives the converted
+  elements in batches instead of the variable.
 Arguments:
   * `cfg`:      entry for the configurations;
-  * `argc`:     number of arguments passed via command line;
-  * `argv`:     array of command line arguments;
-  * `prior`:    priority of values set via command line options;
-  * `optidx`:   position of the first unparsed argument.
+  * `var`:      address of the registered variable;
+  * `func`:     the callback, or NULL for detaching the callback;
+  * `arg`:      the argument passed to the callback.
 Return:
   Zero on success; non-zero on error.
 ******************************************************************************/
-int cfgcli_read_opts(cfgcli_t *cfg, const int argc, char *const *argv,
-    const int prior, int *optidx) {
-  /* Validate function arguments. */
+int cfgcli_set_sink(cfgcli_t *cfg, const void *var, cfgcli_sink_t func,
+    void *arg) {
   if (!cfg) return CFGCLI_ERR_INIT;
   if (CFGCLI_IS_ERROR(cfg)) return CFGCLI_ERRNO(cfg);
-  if (cfg->npar <= 0 && cfg->nfunc <= 0) {
-    cfgcli_msg(cfg, "no parameter or function has been registered", NULL);
-    return CFGCLI_ERRNO(cfg) = CFGCLI_ERR_INIT;
-  }
-  if (prior <= CFGCLI_SRC_NULL) {
-    cfgcli_msg(cfg, "invalid priority for command line options", NULL);
+  if (!var) {
+    cfgcli_msg(cfg, "the variable is not set", NULL);
     return CFGCLI_ERRNO(cfg) = CFGCLI_ERR_INPUT;
   }
+  for (int i = 0; i < cfg->npar; i++) {
+    cfgcli_param_valid_t *par = (cfgcli_param_valid_t *) cfg->params + i;
+    if (par->var != var) continue;
+    /* Bit arrays and nested arrays need all elements at once. */
+    if (!CFGCLI_DTYPE_IS_ARRAY(par->dtype) || par->dtype == CFGCLI_ARRAY_BITS ||
+        CFGCLI_DTYPE_IS_NDARRAY(par->dtype)) {
+      cfgcli_msg(cfg, "element sink not supported for parameter", par->name);
+      return CFGCLI_ERRNO(cfg) = CFGCLI_ERR_DTYPE;
+    }
+    par->sink = func;
+    par->sink_arg = arg;
+    return 0;
+  }
+  cfgcli_msg(cfg, "the variable is not registered", NULL);
+  return CFGCLI_ERRNO(cfg) = CFGCLI_ERR_EXIST;
+}
 
-  *optidx = 0;
-  if (argc <= 0 || !argv || !(*argv)) return 0;
-  int i;
+/******************************************************************************
+Function `cfgcli_check_cmp`:
+  Compare two double-precision numbers, for sorting the allowed values.
+******************************************************************************/
+static int cfgcli_check_cmp(const void *a, const void *b) {
+  const double x = *((const double *) a);
+  const double y = *((const double *) b);
+  return (x > y) - (x < y);
+}
 
-  /* Start parsing command line options. */
-  for (i = 1; i < argc; i++) {
-    char *arg = argv[i];
-    if (!(CFGCLI_IS_OPT(arg))) {           /* unrecognised option */
-      cfgcli_msg(cfg, "unrecognised command line option", arg);
-      continue;
+/******************************************************************************
+Function `cfgcli_set_check`:
+  Attach constraints to a numeric parameter.
+Arguments:
+  * `cfg`:      entry for the configurations;
+  * `var`:      address of the registered variable;
+  * `check`:    the constraints, or NULL for removing the constraints.
+Return:
+  Zero on success; non-zero on error.
+******************************************************************************/
+int cfgcli_set_check(cfgcli_t *cfg, const void *var,
+    const cfgcli_check_t *check) {
+  if (!cfg) return CFGCLI_ERR_INIT;
+  if (CFGCLI_IS_ERROR(cfg)) return CFGCLI_ERRNO(cfg);
+  if (!var) {
+    cfgcli_msg(cfg, "the variable is not set", NULL);
+    return CFGCLI_ERRNO(cfg) = CFGCLI_ERR_INPUT;
+  }
+  cfgcli_param_valid_t *par = NULL;
+  for (int i = 0; i < cfg->npar; i++) {
+    if (((cfgcli_param_valid_t *) cfg->params)[i].var == var) {
+      par = (cfgcli_param_valid_t *) cfg->params + i;
+      break;
     }
+  }
+  if (!par) {
+    cfgcli_msg(cfg, "the variable is not registered", NULL);
+    return CFGCLI_ERRNO(cfg) = CFGCLI_ERR_EXIST;
+  }
 
-    int j;
-    char *optarg = NULL;
+  /* Constraints are only defined for numbers. */
+  const bool array = CFGCLI_DTYPE_IS_ARRAY(par->dtype);
+  const cfgcli_dtype_t dtype = array ? cfgcli_elem_dtype(par->dtype) :
+    par->dtype;
+  if (dtype == CFGCLI_DTYPE_NULL || dtype == CFGCLI_DTYPE_BOOL ||
+      dtype == CFGCLI_DTYPE_STR || dtype == CFGCLI_DTYPE_STRV ||
+      dtype == CFGCLI_DTYPE_BLOB || par->dtype == CFGCLI_ARRAY_BITS) {
+    cfgcli_msg(cfg, "constraints not supported for parameter", par->name);
+    return CFGCLI_ERRNO(cfg) = CFGCLI_ERR_DTYPE;
+  }
 
-    for (j = 0; j < CFGCLI_MAX_LOPT_LEN + 2; j++)  /* check if '=' exists */
-      if (arg[j] == '\0' || arg[j] == CFGCLI_CMD_ASSIGN) break;
-    if (arg[j] == '\0') {                       /* '=' is not found */
-      j = i + 1;
-      if (j < argc && !(CFGCLI_IS_OPT(argv[j]))) optarg = argv[++i];
-    }
-    else if (arg[j] == CFGCLI_CMD_ASSIGN) {        /* '=' is found */
-      arg[j] = '\0';
-      optarg = &arg[j + 1];
+  cfgcli_check_valid_t *chk = (cfgcli_check_valid_t *) par->check;
+  if (chk) free(chk->set);
+  free(chk);
+  par->check = NULL;
+  if (!check) return 0;
+
+  /* Validate the constraints. */
+  const int all = CFGCLI_CHECK_MIN | CFGCLI_CHECK_MAX | CFGCLI_CHECK_NOT_NAN |
+    CFGCLI_CHECK_INCREASING | CFGCLI_CHECK_DECREASING | CFGCLI_CHECK_SET;
+  const int order = CFGCLI_CHECK_INCREASING | CFGCLI_CHECK_DECREASING;
+  if (!check->flags || (check->flags & ~all) ||
+      (!array && (check->flags & order)) ||
+      ((check->flags & CFGCLI_CHECK_MIN) && check->min != check->min) ||
+      ((check->flags & CFGCLI_CHECK_MAX) && check->max != check->max) ||
+      ((check->flags & CFGCLI_CHECK_MIN) && (check->flags & CFGCLI_CHECK_MAX)
+       && check->min > check->max) ||
+      ((check->flags & CFGCLI_CHECK_SET) && (!check->set || !check->nset))) {
+    cfgcli_msg(cfg, "invalid constraints for parameter", par->name);
+    return CFGCLI_ERRNO(cfg) = CFGCLI_ERR_INPUT;
+  }
+  /* NaN cannot be ordered for sorting and binary searches. */
+  for (size_t i = 0; (check->flags & CFGCLI_CHECK_SET) && i < check->nset;
+      i++) {
+    if (check->set[i] != check->set[i]) {
+      cfgcli_msg(cfg, "NaN in the allowed values for parameter", par->name);
+      return CFGCLI_ERRNO(cfg) = CFGCLI_ERR_INPUT;
     }
-    else {
-      cfgcli_msg(cfg, "the command line option is too long", arg);
-      return CFGCLI_ERRNO(cfg) = CFGCLI_ERR_CMD;
+  }
+
+  if (!(chk = calloc(1, sizeof(cfgcli_check_valid_t)))) {
+    cfgcli_msg(cfg, "failed to allocate memory for constraints", par->name);
+    return CFGCLI_ERRNO(cfg) = CFGCLI_ERR_MEMORY;
+  }
+  chk->flags = check->flags;
+  chk->min = check->min;
+  chk->max = check->max;
+  if (check->flags & CFGCLI_CHECK_SET) {
+    /* Allowed values are sorted for binary searches. */
+    if (!(chk->set = malloc(check->nset * sizeof(double)))) {
+      free(chk);
+      cfgcli_msg(cfg, "failed to allocate memory for constraints", par->name);
+      return CFGCLI_ERRNO(cfg) = CFGCLI_ERR_MEMORY;
     }
+    memcpy(chk->set, check->set, check->nset * sizeof(double));
+    chk->nset = check->nset;
+    qsort(chk->set, chk->nset, sizeof(double), cfgcli_check_cmp);
+  }
+  par->check = chk;
+  return 0;
+}
 
-    cfgcli_param_valid_t *params = (cfgcli_param_valid_t *) cfg->params;
-    cfgcli_func_valid_t *funcs = (cfgcli_func_valid_t *) cfg->funcs;
-    enum { not_found, is_param, is_func } status;
-    status = not_found;
+/******************************************************************************
+Function `cfgcli_check_load`:
+  Read a numeric element, which is exact for all integer types.
+Arguments:
+  * `dtype`:    data type of the element;
+  * `elems`:    the elements;
+  * `i`:        index of the element.
+Return:
+  Value of the element.
+******************************************************************************/
+static inline long double cfgcli_check_load(const cfgcli_dtype_t dtype,
+    const void *elems, const size_t i) {
+  switch (dtype) {
+    case CFGCLI_DTYPE_CHAR:   return ((const char *) elems)[i];
+    case CFGCLI_DTYPE_INT:    return ((const int *) elems)[i];
+    case CFGCLI_DTYPE_LONG:   return ((const long *) elems)[i];
+    case CFGCLI_DTYPE_FLT:    return ((const float *) elems)[i];
+    case CFGCLI_DTYPE_DBL:    return ((const double *) elems)[i];
+    case CFGCLI_DTYPE_INT8:   return ((const int8_t *) elems)[i];
+    case CFGCLI_DTYPE_INT16:  return ((const int16_t *) elems)[i];
+    case CFGCLI_DTYPE_INT32:  return ((const int32_t *) elems)[i];
+    case CFGCLI_DTYPE_INT64:  return ((const int64_t *) elems)[i];
+    case CFGCLI_DTYPE_UINT8:  return ((const uint8_t *) elems)[i];
+    case CFGCLI_DTYPE_UINT16: return ((const uint16_t *) elems)[i];
+    case CFGCLI_DTYPE_UINT32: return ((const uint32_t *) elems)[i];
+    case CFGCLI_DTYPE_UINT64: return ((const uint64_t *) elems)[i];
+    case CFGCLI_DTYPE_SIZE:   return ((const size_t *) elems)[i];
+    default:                  return 0;
+  }
+}
 
-    if (arg[1] != CFGCLI_CMD_FLAG) {               /* short option */
-      for (j = 0; j < cfg->npar; j++) {
-        if (arg[1] == params[j].opt) {
-          status = is_param;
-          break;
-        }
-      }
-      if (status != is_param) {
-        for (j = 0; j < cfg->nfunc; j++) {
-          if (arg[1] == funcs[j].opt) {
-            status = is_func;
-            break;
-          }
-        }
-      }
+/* Minimum and maximum of integer elements, without branches. */
+#define CFGCLI_CHECK_REDUCE(type, elems, num, lo, hi) {                      \
+  const type *a = (const type *) (elems);                                   \
+  type l = a[0], h = a[0];                                                  \
+  for (size_t k = 1; k < (num); k++) {                                      \
+    l = (a[k] < l) ? a[k] : l;                                              \
+    h = (a[k] > h) ? a[k] : h;                                              \
+  }                                                                         \
+  *(lo) = l;                                                                \
+  *(hi) = h;                                                                \
+}
+
+/******************************************************************************
+Function `cfgcli_check_reduce`:
+  Compute the minimum and maximum of numeric elements, ignoring NaN.
+Arguments:
+  * `dtype`:    data type of the elements;
+  * `elems`:    the elements;
+  * `num`:      number of elements, must be positive;
+  * `lo`:       the minimum;
+  * `hi`:       the maximum.
+Return:
+  True if there is any NaN; false otherwise.
+******************************************************************************/
+static bool cfgcli_check_reduce(const cfgcli_dtype_t dtype, const void *elems,
+    const size_t num, long double *lo, long double *hi) {
+  size_t i = 0;
+  bool nan = false;
+  if (dtype == CFGCLI_DTYPE_DBL) {
+    const double *a = (const double *) elems;
+    double l = DBL_MAX, h = -DBL_MAX;
+#ifdef __SSE2__
+    /* MINPD and MAXPD return the second operand if either one is NaN. */
+    __m128d vl = _mm_set1_pd(l), vh = _mm_set1_pd(h);
+    __m128d vn = _mm_setzero_pd();
+    for (; i + 2 <= num; i += 2) {
+      const __m128d x = _mm_loadu_pd(a + i);
+      vl = _mm_min_pd(x, vl);
+      vh = _mm_max_pd(x, vh);
+      vn = _mm_or_pd(vn, _mm_cmpunord_pd(x, x));
     }
-    else if (arg[2] != '\0') {                  /* long option */
-      for (j = 0; j < cfg->npar; j++) {
-        if (params[j].lopt &&
-            !strncmp(params[j].lopt, arg + 2, params[j].llen)) {
-          status = is_param;
-          break;
-        }
-      }
-      if (status != is_param) {
-        for (j = 0; j < cfg->nfunc; j++) {
-          if (funcs[j].lopt &&
-              !strncmp(funcs[j].lopt, arg + 2, funcs[j].llen)) {
-            status = is_func;
-            break;
-          }
-        }
+    double tl[2], th[2];
+    _mm_storeu_pd(tl, vl);
+    _mm_storeu_pd(th, vh);
+    l = (tl[0] < tl[1]) ? tl[0] : tl[1];
+    h = (th[0] > th[1]) ? th[0] : th[1];
+    nan = _mm_movemask_pd(vn) != 0;
+#endif
+    for (; i < num; i++) {
+      if (a[i] != a[i]) nan = true;
+      else {
+        if (a[i] < l) l = a[i];
+        if (a[i] > h) h = a[i];
       }
     }
-    else {                                      /* parser termination */
-      *optidx = j;                      /* for arg = "--", j = i + 1 */
-      break;
+    *lo = l;
+    *hi = h;
+    return nan;
+  }
+  if (dtype == CFGCLI_DTYPE_FLT) {
+    const float *a = (const float *) elems;
+    float l = FLT_MAX, h = -FLT_MAX;
+#ifdef __SSE2__
+    __m128 vl = _mm_set1_ps(l), vh = _mm_set1_ps(h);
+    __m128 vn = _mm_setzero_ps();
+    for (; i + 4 <= num; i += 4) {
+      const __m128 x = _mm_loadu_ps(a + i);
+      vl = _mm_min_ps(x, vl);
+      vh = _mm_max_ps(x, vh);
+      vn = _mm_or_ps(vn, _mm_cmpunord_ps(x, x));
     }
-
-    if (status == is_func) {            /* call the command line function */
-      if (optarg) cfgcli_msg(cfg, "omitting command line argument", optarg);
-      if (funcs[j].called)
-        cfgcli_msg(cfg, "the function has already been called with option", arg);
-      else {
-        funcs[j].func(funcs[j].args);   /* call the function */
-        funcs[j].called = 1;
-      }
+    float tl[4], th[4];
+    _mm_storeu_ps(tl, vl);
+    _mm_storeu_ps(th, vh);
+    for (int k = 0; k < 4; k++) {
+      if (tl[k] < l) l = tl[k];
+      if (th[k] > h) h = th[k];
     }
-    else if (status == is_param) {      /* assign parameter value */
-      /* Priority check. */
-      if (CFGCLI_SRC_VAL(params[j].src) > prior) continue;
-      else if (CFGCLI_SRC_VAL(params[j].src) == prior) {
-        cfgcli_msg(cfg, "omitting duplicate entry of parameter", params[j].name);
-        continue;
-      }
-      /* Command line arguments can be omitted for bool type variables. */
-      if (!optarg || *optarg == '\0') {
-        if (params[j].dtype == CFGCLI_DTYPE_BOOL) {
-          params[j].value = "T";
-          params[j].vlen = 2;
-        }
-        else {
-          cfgcli_msg(cfg, "argument not found for option", arg);
-          return CFGCLI_ERRNO(cfg) = CFGCLI_ERR_CMD;
-        }
-      }
+    nan = _mm_movemask_ps(vn) != 0;
+#endif
+    for (; i < num; i++) {
+      if (a[i] != a[i]) nan = true;
       else {
-        params[j].value = optarg;       /* args are surely null terminated */
-        params[j].vlen = strlen(optarg) + 1;    /* safe strlen */
+        if (a[i] < l) l = a[i];
+        if (a[i] > h) h = a[i];
       }
-      /* Assign value to variable. */
-      int err = cfgcli_get(cfg, params + j, CFGCLI_SRC_OF_OPT(prior));
-      if (err) return err;
-      params[j].src = CFGCLI_SRC_OF_OPT(prior);
     }
-    else                                /* option not registered */
-      cfgcli_msg(cfg, "unrecognised command line option", arg);
+    *lo = l;
+    *hi = h;
+    return nan;
+  }
+
+  /* Integer reductions are left to the vectorizer of the compiler. */
+  switch (dtype) {
+    case CFGCLI_DTYPE_CHAR:   CFGCLI_CHECK_REDUCE(char, elems, num, lo, hi);
+                              break;
+    case CFGCLI_DTYPE_INT:    CFGCLI_CHECK_REDUCE(int, elems, num, lo, hi);
+                              break;
+    case CFGCLI_DTYPE_LONG:   CFGCLI_CHECK_REDUCE(long, elems, num, lo, hi);
+                              break;
+    case CFGCLI_DTYPE_INT8:   CFGCLI_CHECK_REDUCE(int8_t, elems, num, lo, hi);
+                              break;
+    case CFGCLI_DTYPE_INT16:  CFGCLI_CHECK_REDUCE(int16_t, elems, num, lo, hi);
+                              break;
+    case CFGCLI_DTYPE_INT32:  CFGCLI_CHECK_REDUCE(int32_t, elems, num, lo, hi);
+                              break;
+    case CFGCLI_DTYPE_INT64:  CFGCLI_CHECK_REDUCE(int64_t, elems, num, lo, hi);
+                              break;
+    case CFGCLI_DTYPE_UINT8:  CFGCLI_CHECK_REDUCE(uint8_t, elems, num, lo, hi);
+                              break;
+    case CFGCLI_DTYPE_UINT16: CFGCLI_CHECK_REDUCE(uint16_t, elems, num, lo, hi);
+                              break;
+    case CFGCLI_DTYPE_UINT32: CFGCLI_CHECK_REDUCE(uint32_t, elems, num, lo, hi);
+                              break;
+    case CFGCLI_DTYPE_UINT64: CFGCLI_CHECK_REDUCE(uint64_t, elems, num, lo, hi);
+                              break;
+    case CFGCLI_DTYPE_SIZE:   CFGCLI_CHECK_REDUCE(size_t, elems, num, lo, hi);
+                              break;
+    default:                  *lo = *hi = 0;
+  }
+  return false;
+}
+
+/******************************************************************************
+Function `cfgcli_check_elements`:
+  Check converted values against the constraints of the parameter.
+Arguments:
+  * `par`:      address of the verified configuration parameter;
+  * `elems`:    the values;
+  * `num`:      number of values;
+  * `first`:    index of the first value, non-zero for following batches.
+Return:
+  Zero on success; CFGCLI_ERR_CHECK on violations.
+******************************************************************************/
+static int cfgcli_check_elements(cfgcli_param_valid_t *par, const void *elems,
+    const size_t num, const size_t first) {
+  cfgcli_check_valid_t *chk = (cfgcli_check_valid_t *) par->check;
+  const cfgcli_dtype_t dtype = CFGCLI_DTYPE_IS_ARRAY(par->dtype) ?
+    cfgcli_elem_dtype(par->dtype) : par->dtype;
+  if (!num) return 0;
+
+  /* Range checks are done with reductions, and elements are visited only for
+     locating a violation, or for the other constraints. */
+  if (!(chk->flags & (CFGCLI_CHECK_INCREASING | CFGCLI_CHECK_DECREASING |
+      CFGCLI_CHECK_SET))) {
+    long double lo, hi;
+    const bool nan = cfgcli_check_reduce(dtype, elems, num, &lo, &hi);
+    if (!((chk->flags & CFGCLI_CHECK_NOT_NAN) && nan) &&
+        !((chk->flags & CFGCLI_CHECK_MIN) && lo < chk->min) &&
+        !((chk->flags & CFGCLI_CHECK_MAX) && hi > chk->max)) return 0;
   }
 
-  if (*optidx == 0) *optidx = i;
+  for (size_t i = 0; i < num; i++) {
+    const long double x = cfgcli_check_load(dtype, elems, i);
+    int fail = 0;
+    if (x != x) {
+      if (chk->flags & CFGCLI_CHECK_NOT_NAN) fail = CFGCLI_CHECK_NOT_NAN;
+    }
+    else if ((chk->flags & CFGCLI_CHECK_MIN) && x < chk->min)
+      fail = CFGCLI_CHECK_MIN;
+    else if ((chk->flags & CFGCLI_CHECK_MAX) && x > chk->max)
+      fail = CFGCLI_CHECK_MAX;
+    else if ((chk->flags & CFGCLI_CHECK_SET) && !bsearch(&(double) { x },
+        chk->set, chk->nset, sizeof(double), cfgcli_check_cmp))
+      fail = CFGCLI_CHECK_SET;
+    if (!fail && (first || i)) {
+      if ((chk->flags & CFGCLI_CHECK_INCREASING) && x < chk->prev)
+        fail = CFGCLI_CHECK_INCREASING;
+      else if ((chk->flags & CFGCLI_CHECK_DECREASING) && x > chk->prev)
+        fail = CFGCLI_CHECK_DECREASING;
+    }
+    if (fail) {
+      par->cfail = fail;
+      par->cidx = first + i;
+      return CFGCLI_ERR_CHECK;
+    }
+    chk->prev = x;
+  }
   return 0;
 }
 
 /******************************************************************************
-Function `cfgcli_read_file`:
-  Read configuration parameters from a file.
+Function `cfgcli_check_param`:
+  Check the converted scalar or array value of a parameter against its
+  constraints.
 Arguments:
-  * `cfg`:      entry for the configurations;
-  * `fname`:    name of the input file;
-  * `prior`:    priority of values read from this file.
+  * `par`:      address of the verified configuration parameter.
+Return:
+  Zero on success; CFGCLI_ERR_CHECK on violations.
+******************************************************************************/
+static int cfgcli_check_param(cfgcli_param_valid_t *par) {
+  if (!par->check || par->sink) return 0;
+  if (!CFGCLI_DTYPE_IS_ARRAY(par->dtype))
+    return cfgcli_check_elements(par, par->var, 1, 0);
+  return cfgcli_check_elements(par, *((void **) par->var), par->narr, 0);
+}
+
+/******************************************************************************
+Function `cfgcli_sink_elements`:
+  Convert the array elements separated by '\0', and pass them to the sink of
+  the parameter in batches.
+Arguments:
+  * `par`:      address of the verified configuration parameter;
+  * `value`:    the first element;
+  * `src`:      source of the value.
 Return:
   Zero on success; non-zero on error.
 ******************************************************************************/
-int cfgcli_read_file(cfgcli_t *cfg, const char *fname, const int prior) {
-  /* Validate function arguments. */
-  if (!cfg) return CFGCLI_ERR_INIT;
-  if (CFGCLI_IS_ERROR(cfg)) return CFGCLI_ERRNO(cfg);
-  if (cfg->npar <= 0) {
-    cfgcli_msg(cfg, "no parameter has been registered", NULL);
-    return CFGCLI_ERRNO(cfg) = CFGCLI_ERR_INIT;
+static int cfgcli_sink_elements(cfgcli_param_valid_t *par, char *value,
+    const int src) {
+  const cfgcli_dtype_t dtype = cfgcli_elem_dtype(par->dtype);
+  const size_t size = (dtype == CFGCLI_DTYPE_STR) ?
+      sizeof(char *) : cfgcli_dtype_size(dtype);
+  if (dtype == CFGCLI_DTYPE_NULL || !size) return CFGCLI_ERR_DTYPE;
+  cfgcli_sink_batch_t batch;
+  char *arr = batch.buf;
+  const size_t nbatch = CFGCLI_SINK_BATCH_SIZE / size;
+
+  for (size_t i = 0, n = 0; i < par->narr; i++) {
+    const size_t len = strlen(value) + 1;
+    int err;
+    if (dtype == CFGCLI_DTYPE_STR) {    /* terminate the string in place */
+      cfgcli_strview_t view;
+      if ((err = cfgcli_get_value(&view, value, len, CFGCLI_DTYPE_STRV, src)))
+        return err;
+      ((char **) arr)[n] = (char *) view.ptr;
+      ((char *) view.ptr)[view.len] = '\0';
+    }
+    else if ((err = cfgcli_get_value(arr + n * size, value, len, dtype, src)))
+      return err;
+    value += len;
+    if (++n == nbatch || i + 1 == par->narr) {
+      if (par->check && (err = cfgcli_check_elements(par, arr, n, i + 1 - n)))
+        return err;
+      if (par->sink(arr, n, par->sink_arg)) return CFGCLI_ERR_SINK;
+      n = 0;
+    }
   }
-  if (!fname || *fname == '\0') {
-    cfgcli_msg(cfg, "the input configuration file is not set", NULL);
-    return CFGCLI_ERRNO(cfg) = CFGCLI_ERR_INPUT;
+  return 0;
+}
+
+/******************************************************************************
+Function `cfgcli_get_bits`:
+  Retrieve the parameter values and pack them into a bit array.
+Arguments:
+  * `par`:      address of the verified configuration parameter;
+  * `src`:      source of the value.
+Return:
+  Zero on success; non-zero on error.
+******************************************************************************/
+static int cfgcli_get_bits(cfgcli_param_valid_t *par, int src) {
+  char *value = par->value;   /* array elements are separated by '\0' */
+  cfgcli_strview_t lit = { NULL, 0 };
+  int shift = 0;                /* number of bits per digit of literals */
+  uint64_t *bits;
+  int err;
+
+  /* Check if a single element is a binary or hexadecimal literal. */
+  if (par->narr == 1) {
+    cfgcli_strview_t view;
+    if ((err = cfgcli_get_value(&view, value, strlen(value) + 1,
+        CFGCLI_DTYPE_STRV, src))) return err;
+    if (view.len > 2 && view.ptr[0] == '0' && (view.ptr[1] == 'b' ||
+        view.ptr[1] == 'B' || view.ptr[1] == 'x' || view.ptr[1] == 'X')) {
+      lit = view;
+      shift = (lit.ptr[1] == 'b' || lit.ptr[1] == 'B') ? 1 : 4;
+      par->narr = (lit.len - 2) * shift;
+    }
   }
-  if (!(cfgcli_strnlen(fname, CFGCLI_MAX_FILENAME_LEN))) {
-    cfgcli_msg(cfg, "invalid filename of the configuration file", NULL);
-    return CFGCLI_ERRNO(cfg) = CFGCLI_ERR_INPUT;
+
+  if (!(bits = calloc(CFGCLI_BITS_NWORD(par->narr), sizeof(uint64_t))))
+    return CFGCLI_ERR_MEMORY;
+  *((uint64_t **) par->var) = bits;
+
+  if (shift) {        /* the least significant digit is the first element */
+    size_t i = 0;
+    for (const char *c = lit.ptr + lit.len - 1; c > lit.ptr + 1; c--) {
+      unsigned d;
+      if (shift == 1 && (*c == '0' || *c == '1')) d = *c - '0';
+      else if (shift == 4 && isxdigit(*c))
+        d = isdigit(*c) ? *c - '0' : (tolower(*c) - 'a' + 10);
+      else return CFGCLI_ERR_PARSE;
+      bits[i >> 6] |= (uint64_t) d << (i & 63);
+      i += shift;
+    }
+    return 0;
   }
-  if (prior <= CFGCLI_SRC_NULL) {
-    cfgcli_msg(cfg, "invalid priority for configuration file", fname);
+
+  for (size_t i = 0; i < par->narr; i++) {
+    const size_t len = strlen(value) + 1;
+    bool flag;
+    if ((err = cfgcli_get_value(&flag, value, len, CFGCLI_DTYPE_BOOL, src)))
+      return err;
+    if (flag) bits[i >> 6] |= (uint64_t) 1 << (i & 63);
+    value += len;
+  }
+  return 0;
+}
+
+/* Values of base64 characters, including the URL-safe ones; -1 if invalid. */
+static const signed char cfgcli_base64_table[256] = {
+  -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+  -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+  -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 62, -1, 62, -1, 63,
+  52, 53, 54, 55, 56, 57, 58, 59, 60, 61, -1, -1, -1, -1, -1, -1,
+  -1,  0,  1,  2,  3,  4,  5,  6,  7,  8,  9, 10, 11, 12, 13, 14,
+  15, 16, 17, 18, 19, 20, 21, 22, 23, 24, 25, -1, -1, -1, -1, 63,
+  -1, 26, 27, 28, 29, 30, 31, 32, 33, 34, 35, 36, 37, 38, 39, 40,
+  41, 42, 43, 44, 45, 46, 47, 48, 49, 50, 51, -1, -1, -1, -1, -1,
+  -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+  -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+  -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+  -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+  -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+  -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+  -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+  -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1
+};
+
+/******************************************************************************
+Function `cfgcli_decode_hex`:
+  Decode hexadecimal digits into bytes, 16 digits at a time with SSE2.
+Arguments:
+  * `out`:      the destination;
+  * `str`:      the digits;
+  * `len`:      number of digits, which must be even.
+Return:
+  Zero on success; non-zero on error.
+******************************************************************************/
+static int cfgcli_decode_hex(unsigned char *out, const char *str,
+    const size_t len) {
+  size_t i = 0;
+#ifdef __SSE2__
+  const __m128i lower = _mm_set1_epi8(0x20);
+  const __m128i zero = _mm_setzero_si128();
+  for (; i + 16 <= len; i += 16, out += 8) {
+    /* Map digits to 0-9, letters to 10-15, and check if all are valid.
+     * Only letters are case folded, as the folding maps 0x10-0x19 to digits. */
+    const __m128i c = _mm_loadu_si128((const __m128i *) (str + i));
+    const __m128i dig = _mm_sub_epi8(c, _mm_set1_epi8('0'));
+    const __m128i alp = _mm_sub_epi8(_mm_or_si128(c, lower),
+        _mm_set1_epi8('a'));
+    const __m128i is_dig = _mm_cmpeq_epi8(_mm_subs_epu8(dig, _mm_set1_epi8(9)),
+        zero);
+    const __m128i is_alp = _mm_cmpeq_epi8(_mm_subs_epu8(alp, _mm_set1_epi8(5)),
+        zero);
+    if (_mm_movemask_epi8(_mm_or_si128(is_dig, is_alp)) != 0xFFFF)
+      return CFGCLI_ERR_PARSE;
+    const __m128i v = _mm_or_si128(_mm_and_si128(is_dig, dig),
+        _mm_and_si128(is_alp, _mm_add_epi8(alp, _mm_set1_epi8(10))));
+    /* Merge pairs of digits, the first one being the high nibble. */
+    const __m128i w = _mm_or_si128(
+        _mm_slli_epi16(_mm_and_si128(v, _mm_set1_epi16(0xFF)), 4),
+        _mm_srli_epi16(v, 8));
+    _mm_storel_epi64((__m128i *) out, _mm_packus_epi16(w, w));
+  }
+#endif
+  const unsigned char *s = (const unsigned char *) str;
+  for (; i < len; i += 2) {
+    if (!isxdigit(s[i]) || !isxdigit(s[i + 1])) return CFGCLI_ERR_PARSE;
+    const int hi = isdigit(s[i]) ? s[i] - '0' : tolower(s[i]) - 'a' + 10;
+    const int lo = isdigit(s[i + 1]) ? s[i + 1] - '0' :
+      tolower(s[i + 1]) - 'a' + 10;
+    *out++ = (unsigned char) (hi << 4 | lo);
+  }
+  return 0;
+}
+
+/******************************************************************************
+Function `cfgcli_decode_base64`:
+  Decode base64 characters into bytes, 16 characters at a time with SSE2,
+  and 4 characters at a time otherwise.
+Arguments:
+  * `out`:      the destination;
+  * `str`:      the characters, without padding;
+  * `len`:      number of characters.
+Return:
+  Zero on success; non-zero on error.
+******************************************************************************/
+static int cfgcli_decode_base64(unsigned char *out, const char *str,
+    const size_t len) {
+  const unsigned char *s = (const unsigned char *) str;
+  const signed char *t = cfgcli_base64_table;
+  size_t i = 0;
+#ifdef __SSE2__
+  for (; i + 16 <= len; i += 16, out += 12) {
+    /* Map characters to 6-bit values by ranges, and check if all are valid.
+     * Bytes above 0x7F are negative, and out of all the ranges. */
+    const __m128i c = _mm_loadu_si128((const __m128i *) (s + i));
+#define CFGCLI_B64_RANGE(lo, hi)                                        \
+    _mm_and_si128(_mm_cmpgt_epi8(c, _mm_set1_epi8((lo) - 1)),           \
+        _mm_cmpgt_epi8(_mm_set1_epi8((hi) + 1), c))
+#define CFGCLI_B64_EQ(x)  _mm_cmpeq_epi8(c, _mm_set1_epi8(x))
+    const __m128i upp = CFGCLI_B64_RANGE('A', 'Z');
+    const __m128i low = CFGCLI_B64_RANGE('a', 'z');
+    const __m128i dig = CFGCLI_B64_RANGE('0', '9');
+    const __m128i c62 = _mm_or_si128(CFGCLI_B64_EQ('+'), CFGCLI_B64_EQ('-'));
+    const __m128i c63 = _mm_or_si128(CFGCLI_B64_EQ('/'), CFGCLI_B64_EQ('_'));
+#undef CFGCLI_B64_RANGE
+#undef CFGCLI_B64_EQ
+    const __m128i ok = _mm_or_si128(_mm_or_si128(upp, low),
+        _mm_or_si128(dig, _mm_or_si128(c62, c63)));
+    if (_mm_movemask_epi8(ok) != 0xFFFF) return CFGCLI_ERR_PARSE;
+    const __m128i v = _mm_or_si128(
+        _mm_or_si128(_mm_and_si128(upp, _mm_sub_epi8(c, _mm_set1_epi8(65))),
+          _mm_and_si128(low, _mm_sub_epi8(c, _mm_set1_epi8(71)))),
+        _mm_or_si128(_mm_and_si128(dig, _mm_add_epi8(c, _mm_set1_epi8(4))),
+          _mm_or_si128(_mm_and_si128(c62, _mm_set1_epi8(62)),
+            _mm_and_si128(c63, _mm_set1_epi8(63)))));
+    /* Merge pairs of values into 12 bits, and then pairs of those into the
+     * 24 bits of every group of 4 characters, the first one being the
+     * most significant. */
+    const __m128i w = _mm_or_si128(
+        _mm_slli_epi16(_mm_and_si128(v, _mm_set1_epi16(0xFF)), 6),
+        _mm_srli_epi16(v, 8));
+    const __m128i x = _mm_or_si128(
+        _mm_slli_epi32(_mm_and_si128(w, _mm_set1_epi32(0xFFFF)), 12),
+        _mm_srli_epi32(w, 16));
+    uint32_t g[4];
+    _mm_storeu_si128((__m128i *) g, x);
+    for (int k = 0; k < 4; k++) {
+      out[3 * k] = g[k] >> 16;
+      out[3 * k + 1] = g[k] >> 8;
+      out[3 * k + 2] = g[k];
+    }
+  }
+#endif
+  for (; i + 4 <= len; i += 4, out += 3) {
+    const int a = t[s[i]], b = t[s[i + 1]], c = t[s[i + 2]], d = t[s[i + 3]];
+    if ((a | b | c | d) < 0) return CFGCLI_ERR_PARSE;
+    const uint32_t v = (uint32_t) a << 18 | b << 12 | c << 6 | d;
+    out[0] = v >> 16;
+    out[1] = v >> 8;
+    out[2] = v;
+  }
+  if (len - i >= 2) {           /* 2 or 3 characters remaining */
+    const int a = t[s[i]], b = t[s[i + 1]], c = (len - i == 3) ? t[s[i + 2]] : 0;
+    if ((a | b | c) < 0) return CFGCLI_ERR_PARSE;
+    const uint32_t v = (uint32_t) a << 18 | b << 12 | c << 6;
+    out[0] = v >> 16;
+    if (len - i == 3) out[1] = v >> 8;
+  }
+  return 0;
+}
+
+/******************************************************************************
+Function `cfgcli_get_blob`:
+  Decode a hexadecimal string with the prefix "0x", or a base64 string with
+  the optional prefix "b64:", and assign the bytes to a buffer. Strings
+  starting with "0x" or "0X" are always hexadecimal, so base64 strings
+  starting with them need the prefix.
+Arguments:
+  * `par`:      address of the verified configuration parameter;
+  * `src`:      source of the value.
+Return:
+  Zero on success; non-zero on error.
+******************************************************************************/
+static int cfgcli_get_blob(cfgcli_param_valid_t *par, int src) {
+  cfgcli_strview_t view;
+  int err = cfgcli_get_value(&view, par->value, par->vlen, CFGCLI_DTYPE_STRV,
+      src);
+  if (err) return err;
+  const char *str = view.ptr;
+  size_t len = view.len, n;
+  const bool hex = (len >= 2 && str[0] == '0' && (str[1] == 'x' || str[1] == 'X'));
+
+  /* Compute the number of bytes. */
+  if (hex) {
+    str += 2;
+    len -= 2;
+    if (len % 2) return CFGCLI_ERR_VALUE;
+    n = len / 2;
+  }
+  else {
+    if (len >= 4 && !memcmp(str, "b64:", 4)) {
+      str += 4;
+      len -= 4;
+    }
+    if (len && str[len - 1] == '=') len--;      /* remove the padding */
+    if (len && str[len - 1] == '=') len--;
+    if (len % 4 == 1) return CFGCLI_ERR_VALUE;
+    n = len / 4 * 3 + (len % 4 ? len % 4 - 1 : 0);
+  }
+
+  unsigned char *blob = malloc(n ? n : 1);
+  if (!blob) return CFGCLI_ERR_MEMORY;
+  *((unsigned char **) par->var) = blob;
+  par->narr = n;
+  return hex ? cfgcli_decode_hex(blob, str, len) :
+    cfgcli_decode_base64(blob, str, len);
+}
+
+/******************************************************************************
+Function `cfgcli_get_ndarray`:
+  Retrieve the parameter values defined by nested arrays, and assign them
+  to a contiguous row-major array, aligned to `CFGCLI_NDARRAY_ALIGN` bytes
+  if `posix_memalign` is available.
+Arguments:
+  * `par`:      address of the verified configuration parameter;
+  * `src`:      source of the value.
+Return:
+  Zero on success; non-zero on error.
+******************************************************************************/
+static int cfgcli_get_ndarray(cfgcli_param_valid_t *par, int src) {
+  size_t count[CFGCLI_MAX_NDIM];        /* number of items at each depth */
+  char *value = par->value;
+  size_t i, n = 0;
+  int depth = 0;
+  char quote = '\0';
+  cfgcli_parse_state_t state = CFGCLI_PARSE_START;
+  par->ndim = 0;
+  par->narr = 0;
+  memset(par->shape, 0, sizeof par->shape);
+  if (!value || !par->vlen) return 0;
+
+  /* Validate the shape, and separate elements by '\0' in place. */
+  for (i = 0; i < par->vlen - 1 && state != CFGCLI_PARSE_ARRAY_DONE; i++) {
+    const char c = value[i];
+    switch (state) {
+      case CFGCLI_PARSE_START:
+        if (c != CFGCLI_SYM_ARRAY_START) {
+          if (!isspace(c)) return CFGCLI_ERR_VALUE;
+          break;
+        }
+#if __STDC_VERSION__ > 201710L
+        [[fallthrough]];
+#endif
+      case CFGCLI_PARSE_ARRAY_START:            /* expecting an item */
+        if (c == CFGCLI_SYM_ARRAY_START) {
+          if (depth == CFGCLI_MAX_NDIM || (par->ndim && depth == par->ndim))
+            return CFGCLI_ERR_VALUE;
+          count[depth++] = 0;
+          value[i] = '\0';
+          state = CFGCLI_PARSE_ARRAY_START;
+        }
+        else if (c == CFGCLI_SYM_ARRAY_SEP || c == CFGCLI_SYM_ARRAY_END)
+          return CFGCLI_ERR_VALUE;
+        else if (!isspace(c)) {                 /* beginning of an element */
+          if (!par->ndim) par->ndim = depth;
+          else if (depth != par->ndim) return CFGCLI_ERR_VALUE;
+          if (c == '"' || c == '\'') quote = c;
+          n++;
+          state = CFGCLI_PARSE_ARRAY_VALUE;
+        }
+        break;
+      case CFGCLI_PARSE_ARRAY_VALUE:
+        if (quote) {
+          if (c == quote) quote = '\0';
+          break;
+        }
+        if (c != CFGCLI_SYM_ARRAY_SEP && c != CFGCLI_SYM_ARRAY_END) break;
+        count[depth - 1] += 1;
+#if __STDC_VERSION__ > 201710L
+        [[fallthrough]];
+#endif
+      case CFGCLI_PARSE_ARRAY_END:              /* expecting ',' or ']' */
+        value[i] = '\0';
+        if (c == CFGCLI_SYM_ARRAY_SEP) state = CFGCLI_PARSE_ARRAY_START;
+        else if (c == CFGCLI_SYM_ARRAY_END) {   /* all sub-arrays agree */
+          if (!par->shape[--depth]) par->shape[depth] = count[depth];
+          else if (par->shape[depth] != count[depth]) return CFGCLI_ERR_VALUE;
+          if (depth) count[depth - 1] += 1;
+          state = depth ? CFGCLI_PARSE_ARRAY_END : CFGCLI_PARSE_ARRAY_DONE;
+        }
+        else if (!isspace(c)) return CFGCLI_ERR_VALUE;
+        break;
+      default:
+        return CFGCLI_ERR_VALUE;
+    }
+  }
+  /* Only whitespaces and comments are allowed after the array. */
+  for (; i < par->vlen - 1 && value[i] != CFGCLI_SYM_COMMENT; i++)
+    if (!isspace(value[i])) return CFGCLI_ERR_VALUE;
+  if (state != CFGCLI_PARSE_ARRAY_DONE || !n) return CFGCLI_ERR_VALUE;
+
+  /* Allocate the aligned buffer, with the size rounded up as required. */
+  const cfgcli_dtype_t dtype = cfgcli_elem_dtype(par->dtype);
+  const size_t size = cfgcli_dtype_size(dtype);
+  if (n > (SIZE_MAX - CFGCLI_NDARRAY_ALIGN) / size) return CFGCLI_ERR_MEMORY;
+  const size_t bytes = (n * size + CFGCLI_NDARRAY_ALIGN - 1) /
+    CFGCLI_NDARRAY_ALIGN * CFGCLI_NDARRAY_ALIGN;
+  void *buf;
+#ifdef HAVE_POSIX_MEMALIGN
+  if (posix_memalign(&buf, CFGCLI_NDARRAY_ALIGN, bytes))
+    return CFGCLI_ERR_MEMORY;
+#else
+  /* Only aligned as required by the C standard, for any type. */
+  if (!(buf = malloc(bytes))) return CFGCLI_ERR_MEMORY;
+#endif
+  char *arr = buf;
+  *((void **) par->var) = arr;
+  par->narr = n;
+
+  /* Convert elements, skipping whitespaces between nested arrays. */
+  const char *end = value + i;
+  for (n = 0; value < end; value++) {
+    if (*value == '\0' || isspace(*value)) continue;
+    const size_t len = strlen(value) + 1;
+    int err = cfgcli_get_value(arr + n++ * size, value, len, dtype, src);
+    if (err) return err;
+    value += len - 1;
+  }
+  return 0;
+}
+
+/******************************************************************************
+Function `cfgcli_get_array`:
+  Retrieve the parameter values and assign them to an array.
+Arguments:
+  * `cfg`:      entry for all configurations;
+  * `par`:      address of the verified configuration parameter;
+  * `src`:      source of the value.
+Return:
+  Zero on success; non-zero on error.
+******************************************************************************/
+static int cfgcli_get_array(cfgcli_t *cfg, cfgcli_param_valid_t *par,
+    int src) {
+  size_t i, len;
+  int err;
+  char *end = par->value + par->vlen - 1;       /* end of all elements */
+
+  /* Split the value string for array elements. */
+  if (CFGCLI_DTYPE_IS_NDARRAY(par->dtype))
+    return cfgcli_get_ndarray(par, src);
+  if ((err = cfgcli_parse_array(par))) return err;
+  char *value = par->value;   /* array elements are separated by '\0' */
+  if (par->sink) return cfgcli_sink_elements(par, value, src);
+
+  /* Allocate memory and assign values for arrays. */
+  switch (par->dtype) {
+    case CFGCLI_ARRAY_BITS:
+      return cfgcli_get_bits(par, src);
+    case CFGCLI_ARRAY_STR:
+      *((char ***) par->var) = calloc(par->narr, sizeof(char *));
+      if (!(*((char ***) par->var))) return CFGCLI_ERR_MEMORY;
+      if (cfgcli_interning(cfg)) {      /* elements are owned by `cfg` */
+        for (i = 0; i < par->narr; i++) {
+          len = strlen(value) + 1;
+          if ((err = cfgcli_get_intern(cfg, *((char ***) par->var) + i, value,
+              len, src))) return err;
+          value += len;
+        }
+        break;
+      }
+      /* Allocate enough memory for the first element of the string array. */
+      *(*((char ***) par->var)) = calloc(par->vlen, sizeof(char));
+      char *tmp = *(*((char ***) par->var));
+      if (!tmp) return CFGCLI_ERR_MEMORY;
+      /* The rest elements point to different positions of the space. */
+      for (i = 0; i < par->narr; i++) {
+        (*((char ***) par->var))[i] = tmp;
+        len = strlen(value) + 1;
+        if ((err = cfgcli_get_value(&tmp, value, len, CFGCLI_DTYPE_STR, src)))
+          return err;
+        tmp += strlen(tmp) + 1;       /* null termination ensured by calloc */
+        value += len;
+      }
+      break;
+    default: {
+      /* Elements are converted in place, and string views are not copied. */
+      const cfgcli_dtype_t dtype = cfgcli_elem_dtype(par->dtype);
+      const size_t size = cfgcli_dtype_size(dtype);
+      if (dtype == CFGCLI_DTYPE_NULL || !size)
+        return CFGCLI_ERR_DTYPE;        /* is CFGCLI_DTYPE_IS_ARRAY correct? */
+      char *arr = calloc(par->narr, size);
+      if (!arr) return CFGCLI_ERR_MEMORY;
+      *((void **) par->var) = arr;
+      return cfgcli_convert_elements(cfg, arr, par->narr, dtype, value, end,
+          src);
+    }
+  }
+  return 0;
+}
+
+/******************************************************************************
+Function `cfgcli_get_error`:
+  Record the error occurred while retrieving the value of a parameter.
+Arguments:
+  * `cfg`:      entry for all configurations;
+  * `par`:      address of the verified configuration parameter;
+  * `err`:      the error code.
+Return:
+  The error code.
+******************************************************************************/
+static int cfgcli_get_error(cfgcli_t *cfg, const cfgcli_param_valid_t *par,
+    const int err) {
+  switch (err) {
+    case 0:
+      return 0;
+    case CFGCLI_ERR_MEMORY:
+      cfgcli_msg(cfg, "failed to allocate memory for parameter", par->name);
+      return CFGCLI_ERRNO(cfg) = err;
+    case CFGCLI_ERR_VALUE:
+      cfgcli_msg(cfg, "invalid value for parameter", par->name);
+      return CFGCLI_ERRNO(cfg) = err;
+    case CFGCLI_ERR_PARSE:
+      cfgcli_msg(cfg, "failed to parse the value for parameter", par->name);
+      return CFGCLI_ERRNO(cfg) = err;
+    case CFGCLI_ERR_DTYPE:
+      cfgcli_msg(cfg, "invalid data type for parameter", par->name);
+      return CFGCLI_ERRNO(cfg) = err;
+    case CFGCLI_ERR_SINK:
+      cfgcli_msg(cfg, "elements rejected by the sink of parameter", par->name);
+      return CFGCLI_ERRNO(cfg) = err;
+    case CFGCLI_ERR_CHECK: {
+      /* Report the name with the index of the invalid array element. */
+      char key[CFGCLI_MAX_NAME_LEN + CFGCLI_NUM_MAX_SIZE(size_t) + 2];
+      if (CFGCLI_DTYPE_IS_ARRAY(par->dtype))
+        snprintf(key, sizeof key, "%s[%zu]", par->name, par->cidx);
+      else snprintf(key, sizeof key, "%s", par->name);
+      switch (par->cfail) {
+        case CFGCLI_CHECK_MIN:
+          cfgcli_msg(cfg, "value smaller than the minimum for parameter", key);
+          break;
+        case CFGCLI_CHECK_MAX:
+          cfgcli_msg(cfg, "value larger than the maximum for parameter", key);
+          break;
+        case CFGCLI_CHECK_NOT_NAN:
+          cfgcli_msg(cfg, "NaN value for parameter", key);
+          break;
+        case CFGCLI_CHECK_INCREASING:
+          cfgcli_msg(cfg, "elements not in ascending order for parameter", key);
+          break;
+        case CFGCLI_CHECK_DECREASING:
+          cfgcli_msg(cfg, "elements not in descending order for parameter", key);
+          break;
+        default:
+          cfgcli_msg(cfg, "value not allowed for parameter", key);
+      }
+      return CFGCLI_ERRNO(cfg) = err;
+    }
+    default:
+      cfgcli_msg(cfg, "unknown error occurred for parameter", par->name);
+      return CFGCLI_ERRNO(cfg) = err;
+  }
+}
+
+/******************************************************************************
+Function `cfgcli_deferring`:
+  Check if value conversions are deferred.
+Arguments:
+  * `cfg`:      entry for the configurations.
+Return:
+  True if values are only recorded until resolution; false otherwise.
+******************************************************************************/
+static inline bool cfgcli_deferring(const cfgcli_t *cfg) {
+  return cfg->defer && ((cfgcli_defer_t *) cfg->defer)->on;
+}
+
+/******************************************************************************
+Function `cfgcli_defer`:
+  Record the raw value of a parameter for deferred conversion, and release
+  the value that it overrides.
+Arguments:
+  * `cfg`:      entry for all configurations;
+  * `par`:      address of the verified configuration parameter;
+  * `src`:      source of the value;
+  * `resident`: true if the value is valid until the entry is destroyed.
+Return:
+  Zero on success; non-zero on error.
+******************************************************************************/
+static int cfgcli_defer(cfgcli_t *cfg, cfgcli_param_valid_t *par,
+    const int src, const bool resident) {
+  cfgcli_defer_t *def = (cfgcli_defer_t *) cfg->defer;
+  const int i = par - (cfgcli_param_valid_t *) cfg->params;
+  if (i >= def->max) {                  /* parameters registered later */
+    cfgcli_pending_t *rec = realloc(def->rec, cfg->npar * sizeof *rec);
+    if (!rec) return cfgcli_get_error(cfg, par, CFGCLI_ERR_MEMORY);
+    memset(rec + def->max, 0, (cfg->npar - def->max) * sizeof *rec);
+    def->rec = rec;
+    def->max = cfg->npar;
+  }
+
+  cfgcli_pending_t *rec = def->rec + i;
+  if (rec->owned) free(rec->value);
+  rec->value = NULL;
+  rec->owned = false;
+  if (!par->value || *par->value == '\0') return 0;    /* value not set */
+  if (resident) rec->value = par->value;
+  else {
+    if (!(rec->value = malloc(par->vlen)))
+      return cfgcli_get_error(cfg, par, CFGCLI_ERR_MEMORY);
+    memcpy(rec->value, par->value, par->vlen);
+    rec->owned = true;
+  }
+  rec->vlen = par->vlen;
+  rec->src = src;
+  return 0;
+}
+
+/******************************************************************************
+Function `cfgcli_sha256_block`:
+  Process a 64-byte block with the SHA-256 compression function.
+Arguments:
+  * `st`:       the hashing state;
+  * `blk`:      the block.
+******************************************************************************/
+static void cfgcli_sha256_block(cfgcli_sha256_t *st, const unsigned char *blk) {
+  static const uint32_t k[64] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1,
+    0x923f82a4, 0xab1c5ed5, 0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3,
+    0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174, 0xe49b69c1, 0xefbe4786,
+    0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147,
+    0x06ca6351, 0x14292967, 0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13,
+    0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85, 0xa2bfe8a1, 0xa81a664b,
+    0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a,
+    0x5b9cca4f, 0x682e6ff3, 0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208,
+    0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+  };
+#define CFGCLI_ROTR(x,n)  (((x) >> (n)) | ((x) << (32 - (n))))
+  uint32_t w[64], v[8];
+  int i;
+  for (i = 0; i < 16; i++)
+    w[i] = (uint32_t) blk[4 * i] << 24 | (uint32_t) blk[4 * i + 1] << 16 |
+      (uint32_t) blk[4 * i + 2] << 8 | blk[4 * i + 3];
+  for (; i < 64; i++) {
+    const uint32_t s0 = CFGCLI_ROTR(w[i - 15], 7) ^ CFGCLI_ROTR(w[i - 15], 18) ^
+      (w[i - 15] >> 3);
+    const uint32_t s1 = CFGCLI_ROTR(w[i - 2], 17) ^ CFGCLI_ROTR(w[i - 2], 19) ^
+      (w[i - 2] >> 10);
+    w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+  }
+  memcpy(v, st->h, sizeof v);
+  for (i = 0; i < 64; i++) {
+    const uint32_t s1 = CFGCLI_ROTR(v[4], 6) ^ CFGCLI_ROTR(v[4], 11) ^
+      CFGCLI_ROTR(v[4], 25);
+    const uint32_t t1 = v[7] + s1 + ((v[4] & v[5]) ^ (~v[4] & v[6])) + k[i] +
+      w[i];
+    const uint32_t s0 = CFGCLI_ROTR(v[0], 2) ^ CFGCLI_ROTR(v[0], 13) ^
+      CFGCLI_ROTR(v[0], 22);
+    const uint32_t t2 = s0 + ((v[0] & v[1]) ^ (v[0] & v[2]) ^ (v[1] & v[2]));
+    memmove(v + 1, v, 7 * sizeof(uint32_t));
+    v[4] += t1;
+    v[0] = t1 + t2;
+  }
+#undef CFGCLI_ROTR
+  for (i = 0; i < 8; i++) st->h[i] += v[i];
+}
+
+/******************************************************************************
+Function `cfgcli_sha256_update`:
+  Feed bytes to the SHA-256 hashing state.
+Arguments:
+  * `st`:       the hashing state;
+  * `data`:     the bytes;
+  * `len`:      number of bytes.
+******************************************************************************/
+static void cfgcli_sha256_update(cfgcli_sha256_t *st, const void *data,
+    size_t len) {
+  const unsigned char *p = (const unsigned char *) data;
+  st->total += len;
+  if (st->num) {                        /* fill the pending block first */
+    const size_t n = (len < 64 - st->num) ? len : 64 - st->num;
+    memcpy(st->blk + st->num, p, n);
+    st->num += n;
+    p += n;
+    len -= n;
+    if (st->num < 64) return;
+    cfgcli_sha256_block(st, st->blk);
+    st->num = 0;
+  }
+  for (; len >= 64; p += 64, len -= 64) cfgcli_sha256_block(st, p);
+  memcpy(st->blk, p, len);
+  st->num = len;
+}
+
+/******************************************************************************
+Function `cfgcli_sha256_final`:
+  Finish SHA-256 hashing, and save the digest.
+Arguments:
+  * `st`:       the hashing state;
+  * `out`:      the 32-byte digest.
+******************************************************************************/
+static void cfgcli_sha256_final(cfgcli_sha256_t *st, unsigned char *out) {
+  const uint64_t bits = st->total * 8;
+  unsigned char pad[72] = {0x80};
+  const size_t npad = (st->num < 56) ? 56 - st->num : 120 - st->num;
+  for (int i = 0; i < 8; i++) pad[npad + i] = bits >> (56 - 8 * i);
+  cfgcli_sha256_update(st, pad, npad + 8);
+  for (int i = 0; i < 8; i++) {
+    out[4 * i] = st->h[i] >> 24;
+    out[4 * i + 1] = st->h[i] >> 16;
+    out[4 * i + 2] = st->h[i] >> 8;
+    out[4 * i + 3] = st->h[i];
+  }
+}
+
+/******************************************************************************
+Function `cfgcli_value_spans`:
+  Count the contiguous ranges of memory holding the converted value.
+Arguments:
+  * `par`:      address of the verified configuration parameter.
+Return:
+  The number of ranges.
+******************************************************************************/
+static size_t cfgcli_value_spans(const cfgcli_param_valid_t *par) {
+  if (par->sink) return 0;              /* elements are not kept */
+  if (par->dtype == CFGCLI_ARRAY_STR || par->dtype == CFGCLI_ARRAY_STRV)
+    return par->narr;
+  if (CFGCLI_DTYPE_IS_NDARRAY(par->dtype)) return 2;    /* shape and data */
+  return 1;
+}
+
+/******************************************************************************
+Function `cfgcli_value_span`:
+  Locate a contiguous range of memory holding the converted value.
+Arguments:
+  * `par`:      address of the verified configuration parameter;
+  * `i`:        index of the range;
+  * `len`:      number of bytes of the range.
+Return:
+  Address of the range.
+******************************************************************************/
+static const void *cfgcli_value_span(const cfgcli_param_valid_t *par,
+    const size_t i, size_t *len) {
+  const char *str;
+  const cfgcli_strview_t *view;
+  switch (par->dtype) {
+    case CFGCLI_DTYPE_STR:
+      str = *((char **) par->var);
+      *len = str ? strlen(str) : 0;
+      return str;
+    case CFGCLI_DTYPE_STRV:
+      view = (cfgcli_strview_t *) par->var;
+      *len = view->len;
+      return view->ptr;
+    case CFGCLI_ARRAY_STR:
+      str = (*((char ***) par->var))[i];
+      *len = strlen(str);
+      return str;
+    case CFGCLI_ARRAY_STRV:
+      view = *((cfgcli_strview_t **) par->var) + i;
+      *len = view->len;
+      return view->ptr;
+    case CFGCLI_ARRAY_BITS:
+      *len = CFGCLI_BITS_NWORD(par->narr) * sizeof(uint64_t);
+      return *((void **) par->var);
+    case CFGCLI_DTYPE_BLOB:
+      *len = par->narr;
+      return *((void **) par->var);
+    default:
+      if (CFGCLI_DTYPE_IS_NDARRAY(par->dtype) && i == 0) {
+        *len = par->ndim * sizeof(size_t);
+        return par->shape;
+      }
+      if (CFGCLI_DTYPE_IS_ARRAY(par->dtype)) {
+        *len = par->narr * cfgcli_dtype_size(cfgcli_elem_dtype(par->dtype));
+        return *((void **) par->var);
+      }
+      *len = cfgcli_dtype_size(par->dtype);
+      return par->var;
+  }
+}
+
+/******************************************************************************
+Function `cfgcli_digest_uint`:
+  Hash an unsigned integer with a fixed number of big-endian bytes.
+Arguments:
+  * `st`:       the SHA-256 state;
+  * `x`:        the integer;
+  * `width`:    number of bytes, at most 8.
+******************************************************************************/
+static void cfgcli_digest_uint(cfgcli_sha256_t *st, const uint64_t x,
+    const size_t width) {
+  unsigned char buf[8];
+  for (size_t k = 0; k < width; k++) buf[k] = x >> (8 * (width - 1 - k));
+  cfgcli_sha256_update(st, buf, width);
+}
+
+/******************************************************************************
+Function `cfgcli_digest_span`:
+  Hash a contiguous range of a converted value, preceded by its length, in
+  an encoding that does not depend on the platform: characters and bytes as
+  they are, booleans as single bytes, integers as 64-bit two's complement,
+  and real numbers as IEEE 754 binary32 or binary64, all big-endian.
+Arguments:
+  * `st`:       the SHA-256 state;
+  * `ptr`:      address of the range;
+  * `len`:      number of bytes of the range;
+  * `dtype`:    data type of the elements.
+******************************************************************************/
+static void cfgcli_digest_span(cfgcli_sha256_t *st, const void *ptr,
+    const size_t len, const cfgcli_dtype_t dtype) {
+  if (dtype == CFGCLI_DTYPE_CHAR) {
+    cfgcli_digest_uint(st, len, 8);
+    cfgcli_sha256_update(st, ptr, len);
+    return;
+  }
+  const size_t size = cfgcli_dtype_size(dtype);
+  const size_t width = (dtype == CFGCLI_DTYPE_BOOL) ? 1 :
+    (dtype == CFGCLI_DTYPE_FLT) ? 4 : 8;
+  const size_t n = len / size;
+  unsigned char buf[512];
+  size_t k = 0;
+  cfgcli_digest_uint(st, n * width, 8);
+
+  for (size_t i = 0; i < n; i++) {
+    const char *p = (const char *) ptr + i * size;
+    uint64_t x;
+    uint32_t f;
+    switch (dtype) {
+      case CFGCLI_DTYPE_BOOL:   x = *((const bool *) p);                break;
+      case CFGCLI_DTYPE_INT:    x = (int64_t) *((const int *) p);       break;
+      case CFGCLI_DTYPE_LONG:   x = (int64_t) *((const long *) p);      break;
+      case CFGCLI_DTYPE_INT8:   x = (int64_t) *((const int8_t *) p);    break;
+      case CFGCLI_DTYPE_INT16:  x = (int64_t) *((const int16_t *) p);   break;
+      case CFGCLI_DTYPE_INT32:  x = (int64_t) *((const int32_t *) p);   break;
+      case CFGCLI_DTYPE_INT64:  x = *((const int64_t *) p);             break;
+      case CFGCLI_DTYPE_UINT8:  x = *((const uint8_t *) p);             break;
+      case CFGCLI_DTYPE_UINT16: x = *((const uint16_t *) p);            break;
+      case CFGCLI_DTYPE_UINT32: x = *((const uint32_t *) p);            break;
+      case CFGCLI_DTYPE_UINT64: x = *((const uint64_t *) p);            break;
+      case CFGCLI_DTYPE_SIZE:   x = *((const size_t *) p);              break;
+      case CFGCLI_DTYPE_FLT:    memcpy(&f, p, sizeof f); x = f;         break;
+      case CFGCLI_DTYPE_DBL:    memcpy(&x, p, sizeof x);                break;
+      default:                  x = 0;
+    }
+    for (size_t b = 0; b < width; b++)
+      buf[k++] = x >> (8 * (width - 1 - b));
+    if (k > sizeof(buf) - 8) {
+      cfgcli_sha256_update(st, buf, k);
+      k = 0;
+    }
+  }
+  if (k) cfgcli_sha256_update(st, buf, k);
+}
+
+/******************************************************************************
+Function `cfgcli_fprint_update`:
+  Add a digest to, or subtract it from, the fingerprint of all parameters,
+  with both as 4 big-endian 64-bit words, modulo 2^256.
+Arguments:
+  * `cfg`:      entry for all configurations;
+  * `digest`:   the digest;
+  * `add`:      true for adding the digest; false for subtracting it.
+******************************************************************************/
+static void cfgcli_fprint_update(cfgcli_t *cfg, const uint64_t *digest,
+    const bool add) {
+  uint64_t *fp = cfg->fprint;
+  uint64_t carry = 0;
+  for (int i = 3; i >= 0; i--) {
+    const uint64_t x = digest[i] + carry;
+    if (add) {
+      carry = (x < carry);
+      fp[i] += x;
+      carry |= (fp[i] < x);
+    }
+    else {
+      carry = (x < carry) || (fp[i] < x);
+      fp[i] -= x;
+    }
+  }
+}
+
+/******************************************************************************
+Function `cfgcli_value_digest`:
+  Compute the SHA-256 digest of the name, data type and converted value of a
+  parameter, and replace the previous digest in the fingerprint of all
+  parameters, which is the sum of the digests modulo 2^256.
+Arguments:
+  * `cfg`:      entry for all configurations;
+  * `par`:      address of the verified configuration parameter;
+  * `set`:      true if the value is set; false for removing the digest.
+******************************************************************************/
+static void cfgcli_value_digest(cfgcli_t *cfg, cfgcli_param_valid_t *par,
+    const bool set) {
+  unsigned char digest[CFGCLI_FINGERPRINT_SIZE];
+
+  /* Subtract the previous digest. */
+  cfgcli_fprint_update(cfg, par->digest, false);
+  memset(par->digest, 0, sizeof(par->digest));
+  par->hash = 0;
+  if (!set) return;
+
+  /* Hash the value in a fixed-width big-endian encoding, with lengths. */
+  cfgcli_sha256_t st = {{0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+    0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19}, {0}, 0, 0};
+  cfgcli_sha256_update(&st, par->name, par->nlen);      /* with the '\0' */
+  cfgcli_digest_uint(&st, par->dtype, 4);
+  cfgcli_digest_uint(&st, par->narr, 8);
+  const size_t n = cfgcli_value_spans(par);
+  for (size_t j = 0; j < n; j++) {
+    size_t len;
+    const void *ptr = cfgcli_value_span(par, j, &len);
+    cfgcli_dtype_t dtype;
+    switch (par->dtype) {
+      case CFGCLI_DTYPE_STR: case CFGCLI_DTYPE_STRV: case CFGCLI_ARRAY_STR:
+      case CFGCLI_ARRAY_STRV: case CFGCLI_DTYPE_BLOB:
+        dtype = CFGCLI_DTYPE_CHAR;
+        break;
+      case CFGCLI_ARRAY_BITS:
+        dtype = CFGCLI_DTYPE_UINT64;
+        break;
+      default:
+        if (CFGCLI_DTYPE_IS_NDARRAY(par->dtype) && j == 0)
+          dtype = CFGCLI_DTYPE_SIZE;            /* the shape */
+        else if (CFGCLI_DTYPE_IS_ARRAY(par->dtype))
+          dtype = cfgcli_elem_dtype(par->dtype);
+        else dtype = par->dtype;
+    }
+    cfgcli_digest_span(&st, ptr, len, dtype);
+  }
+  cfgcli_sha256_final(&st, digest);
+
+  /* Add the new digest. */
+  for (int i = 0; i < 4; i++) {
+    uint64_t x = 0;
+    for (int k = 0; k < 8; k++) x = x << 8 | digest[8 * i + k];
+    par->digest[i] = x;
+  }
+  cfgcli_fprint_update(cfg, par->digest, true);
+  memcpy(&par->hash, digest, sizeof(par->hash));
+}
+
+/******************************************************************************
+Function `cfgcli_value_equal`:
+  Compare the converted values of two parameters.
+Arguments:
+  * `a`:        address of the first verified configuration parameter;
+  * `b`:        address of the second verified configuration parameter.
+Return:
+  True if the values are identical; false otherwise.
+******************************************************************************/
+static bool cfgcli_value_equal(const cfgcli_param_valid_t *a,
+    const cfgcli_param_valid_t *b) {
+  if (a->dtype != b->dtype || a->narr != b->narr) return false;
+  const size_t n = cfgcli_value_spans(a);
+  if (n != cfgcli_value_spans(b)) return false;
+  for (size_t i = 0; i < n; i++) {
+    size_t la, lb;
+    const void *pa = cfgcli_value_span(a, i, &la);
+    const void *pb = cfgcli_value_span(b, i, &lb);
+    if (la != lb || (la && memcmp(pa, pb, la))) return false;
+  }
+  return true;
+}
+
+/******************************************************************************
+Function `cfgcli_get`:
+  Retrieve the parameter value and assign it to a variable.
+Arguments:
+  * `cfg`:      entry for all configurations;
+  * `par`:      address of the verified configuration parameter;
+  * `src`:      source of the value;
+Return:
+  Zero on success; non-zero on error.
+******************************************************************************/
+static int cfgcli_get(cfgcli_t *cfg, cfgcli_param_valid_t *par, int src) {
+  int err = 0;
+  /* Validate function arguments. */
+  if (CFGCLI_IS_ERROR(cfg)) return CFGCLI_ERRNO(cfg);
+  if (!par->value || *par->value == '\0') return 0;     /* value not set */
+
+  /* Deal with arrays and scalars separately. */
+  if (CFGCLI_DTYPE_IS_ARRAY(par->dtype) && src < CFGCLI_SRC_NULL) {
+    /* Arrays are split in place, so values of command line options are
+       copied to leave `argv` untouched; string views need a resident copy. */
+    char *value = par->value;
+    char *copy = (par->dtype == CFGCLI_ARRAY_STRV) ?
+      cfgcli_keep(cfg, par->vlen) : malloc(par->vlen);
+    if (!copy) return cfgcli_get_error(cfg, par, CFGCLI_ERR_MEMORY);
+    memcpy(copy, value, par->vlen);
+    par->value = copy;
+    err = cfgcli_get_array(cfg, par, src);
+    par->value = value;
+    if (par->dtype != CFGCLI_ARRAY_STRV) free(copy);
+  }
+  else if (CFGCLI_DTYPE_IS_ARRAY(par->dtype))   /* force preprocessing */
+    err = cfgcli_get_array(cfg, par, src);
+  else if (par->dtype == CFGCLI_DTYPE_STR && cfgcli_interning(cfg))
+    err = cfgcli_get_intern(cfg, par->var, par->value, par->vlen, src);
+  else if (par->dtype == CFGCLI_DTYPE_BLOB)
+    err = cfgcli_get_blob(par, src);
+  else {
+    /* Allocate memory only for string. */
+    if (par->dtype == CFGCLI_DTYPE_STR) {
+      *((char **) par->var) = calloc(par->vlen, sizeof(char));
+      if (!(*((char **) par->var))) err = CFGCLI_ERR_MEMORY;
+    }
+
+    /* Assign values to the variable.  */
+    if (!err)
+      err = cfgcli_get_value(par->var, par->value, par->vlen, par->dtype, src);
+  }
+
+  if (!err) err = cfgcli_check_param(par);
+  if (!err) cfgcli_value_digest(cfg, par, true);
+  return cfgcli_get_error(cfg, par, err);
+}
+
+
+/******************************************************************************
+Function `cfgcli_assign_entry`:
+  Assign a value to a parameter, following the priority rules.
+Arguments:
+  * `cfg`:      entry for all configurations;
+  * `par`:      address of the verified configuration parameter;
+  * `value`:    the null terminated value;
+  * `prior`:    priority of the value;
+  * `resident`: true if the value is valid until the entry is destroyed.
+Return:
+  Zero on success; non-zero on error.
+******************************************************************************/
+static int cfgcli_assign_entry(cfgcli_t *cfg, cfgcli_param_valid_t *par,
+    char *value, const int prior, const bool resident) {
+  /* priority check */
+  if (CFGCLI_SRC_VAL(par->src) == prior) {
+    cfgcli_msg(cfg, "omitting duplicate entry of parameter", par->name);
+    return 0;
+  }
+  if (CFGCLI_SRC_VAL(par->src) > prior) return 0;
+  if (!resident && CFGCLI_DTYPE_IS_VIEW(par->dtype)) {
+    cfgcli_msg(cfg, "no resident source for string view parameter", par->name);
+    return CFGCLI_ERRNO(cfg) = CFGCLI_ERR_INPUT;
+  }
+
+  par->value = value;
+  par->vlen = strlen(value) + 1;
+  int err = cfgcli_deferring(cfg) ? cfgcli_defer(cfg, par, prior, resident) :
+    cfgcli_get(cfg, par, prior);
+  if (err) return err;
+  par->src = prior;
+  return 0;
+}
+
+/******************************************************************************
+Function `cfgcli_set_deferred`:
+  Enable or disable deferred value conversion.
+Arguments:
+  * `cfg`:      entry for the configurations;
+  * `defer`:    true for recording values until `cfgcli_resolve` is called.
+Return:
+  Zero on success; non-zero on error.
+******************************************************************************/
+int cfgcli_set_deferred(cfgcli_t *cfg, const bool defer) {
+  if (!cfg) return CFGCLI_ERR_INIT;
+  if (CFGCLI_IS_ERROR(cfg)) return CFGCLI_ERRNO(cfg);
+
+  cfgcli_defer_t *def = (cfgcli_defer_t *) cfg->defer;
+  if (!def) {
+    if (!defer) return 0;
+    if (!(def = calloc(1, sizeof(cfgcli_defer_t)))) {
+      cfgcli_msg(cfg, "failed to allocate memory for deferred values", NULL);
+      return CFGCLI_ERRNO(cfg) = CFGCLI_ERR_MEMORY;
+    }
+    cfg->defer = def;
+  }
+  /* Recorded values are kept until they are resolved. */
+  def->on = defer;
+  return 0;
+}
+
+/******************************************************************************
+Function `cfgcli_resolve_param`:
+  Convert the recorded value of a parameter, if there is any.
+Arguments:
+  * `cfg`:      entry for the configurations;
+  * `par`:      address of the verified configuration parameter.
+Return:
+  Zero on success; non-zero on error.
+******************************************************************************/
+static int cfgcli_resolve_param(cfgcli_t *cfg, cfgcli_param_valid_t *par) {
+  cfgcli_defer_t *def = (cfgcli_defer_t *) cfg->defer;
+  const int i = par - (cfgcli_param_valid_t *) cfg->params;
+  if (!def || i >= def->max || !def->rec[i].value) return 0;
+
+  cfgcli_pending_t *rec = def->rec + i;
+  par->value = rec->value;
+  par->vlen = rec->vlen;
+  int err = cfgcli_get(cfg, par, rec->src);
+  if (rec->owned) free(rec->value);
+  rec->value = NULL;
+  rec->owned = false;
+  return err;
+}
+
+/******************************************************************************
+Function `cfgcli_resolve_set`:
+  Convert the recorded value of a set parameter, unless it is passed to
+  element sinks.
+Arguments:
+  * `cfg`:      entry for the configurations;
+  * `par`:      address of the verified configuration parameter.
+Return:
+  Zero on success; non-zero on error.
+******************************************************************************/
+static int cfgcli_resolve_set(cfgcli_t *cfg, cfgcli_param_valid_t *par) {
+  if (par->src == CFGCLI_SRC_NULL || par->sink) return 0;
+  return cfgcli_resolve_param(cfg, par);
+}
+
+/******************************************************************************
+Function `cfgcli_resolve`:
+  Convert the recorded values of all parameters.
+Arguments:
+  * `cfg`:      entry for the configurations.
+Return:
+  Zero on success; non-zero on error.
+******************************************************************************/
+int cfgcli_resolve(cfgcli_t *cfg) {
+  if (!cfg) return CFGCLI_ERR_INIT;
+  if (CFGCLI_IS_ERROR(cfg)) return CFGCLI_ERRNO(cfg);
+
+  cfgcli_param_valid_t *params = (cfgcli_param_valid_t *) cfg->params;
+  for (int i = 0; i < cfg->npar; i++) {
+    int err = cfgcli_resolve_param(cfg, params + i);
+    if (err) return err;
+  }
+  return 0;
+}
+
+/******************************************************************************
+Function `cfgcli_read_entry`:
+  Assign the value of an entry read from a configuration file or buffer.
+Arguments:
+  * `cfg`:      entry for all configurations;
+  * `key`:      the null terminated full name, NULL for skipped entries;
+  * `value`:    the null terminated value;
+  * `prior`:    priority of the value;
+  * `resident`: true if the value is valid until the entry is destroyed.
+Return:
+  Zero on success; non-zero on error.
+******************************************************************************/
+static int cfgcli_read_entry(cfgcli_t *cfg, const char *key, char *value,
+    const int prior, const bool resident) {
+  if (!key || !cfgcli_in_scope(cfg, key)) return 0;     /* skipped entry */
+  /* search for the parameter given the name */
+  cfgcli_param_valid_t *par = cfgcli_find_param(cfg, key);
+  if (!par) {                                   /* parameter not found */
+    cfgcli_msg(cfg, "unregistered parameter name", key);
+    return 0;
+  }
+  return cfgcli_assign_entry(cfg, par, value, prior, resident);
+}
+
+
+/*============================================================================*\
+             Functions for streaming arrays defined in multiple lines
+\*============================================================================*/
+
+/******************************************************************************
+Function `cfgcli_grow_size`:
+  Compute the capacity of a growing buffer: the size is doubled until
+  `CFGCLI_STR_MAX_DOUBLE_SIZE`, and increased linearly afterwards.
+Arguments:
+  * `size`:     current capacity of the buffer;
+  * `need`:     the minimum required capacity.
+Return:
+  The new capacity; 0 on overflow.
+******************************************************************************/
+static size_t cfgcli_grow_size(size_t size, const size_t need) {
+  if (!size) size = CFGCLI_STR_INIT_SIZE;
+  while (size < need) {
+    if (size >= CFGCLI_STR_MAX_DOUBLE_SIZE) {
+      if (SIZE_MAX - CFGCLI_STR_MAX_DOUBLE_SIZE < size) return 0;
+      size += CFGCLI_STR_MAX_DOUBLE_SIZE;
+    }
+    else size <<= 1;
+  }
+  return size;
+}
+
+/******************************************************************************
+Function `cfgcli_stream_begin`:
+  Decide how to handle an array definition that spans multiple lines.
+Arguments:
+  * `cfg`:      entry for all configurations;
+  * `st`:       the streaming state;
+  * `key`:      the null terminated full name, NULL for skipped entries;
+  * `prior`:    priority of the value.
+Return:
+  The mode for handling the rest of the definition.
+******************************************************************************/
+static cfgcli_stream_mode_t cfgcli_stream_begin(cfgcli_t *cfg,
+    cfgcli_stream_t *st, const char *key, const int prior) {
+  if (!key || !cfgcli_in_scope(cfg, key)) return CFGCLI_STREAM_SKIP;
+  cfgcli_param_valid_t *par = cfgcli_find_param(cfg, key);
+  if (!par) {
+    cfgcli_msg(cfg, "unregistered parameter name", key);
+    return CFGCLI_STREAM_SKIP;
+  }
+  if (CFGCLI_SRC_VAL(par->src) > prior) return CFGCLI_STREAM_SKIP;
+  if (CFGCLI_SRC_VAL(par->src) == prior) {
+    cfgcli_msg(cfg, "omitting duplicate entry of parameter", key);
+    return CFGCLI_STREAM_SKIP;
+  }
+  /* Errors of non-array types are reported with the full definition, and
+     bit arrays, nested arrays and deferred values are processed as a whole. */
+  if (!CFGCLI_DTYPE_IS_ARRAY(par->dtype) || CFGCLI_DTYPE_IS_VIEW(par->dtype) ||
+      par->dtype == CFGCLI_ARRAY_BITS ||
+      CFGCLI_DTYPE_IS_NDARRAY(par->dtype) || cfgcli_deferring(cfg))
+    return CFGCLI_STREAM_KEEP;
+
+  memset(st, 0, sizeof(cfgcli_stream_t));
+  st->cfg = cfg;
+  st->par = par;
+  return CFGCLI_STREAM_DATA;
+}
+
+/******************************************************************************
+Function `cfgcli_stream_flush`:
+  Pass the converted elements to the sink of the parameter, and drop them.
+Arguments:
+  * `st`:       the streaming state.
+Return:
+  Zero on success; non-zero on error.
+******************************************************************************/
+static int cfgcli_stream_flush(cfgcli_stream_t *st) {
+  if (!st->num) return 0;
+  if (cfgcli_elem_dtype(st->par->dtype) == CFGCLI_DTYPE_STR) {
+    for (size_t i = 0; i < st->num; i++) {
+      cfgcli_stream_str_t *s = (cfgcli_stream_str_t *) st->data + i;
+      if (st->str) s->ptr = st->str + s->off;   /* not interned */
+    }
+  }
+  if (st->par->check) {
+    const int err = cfgcli_check_elements(st->par, st->data, st->num,
+        st->total);
+    if (err) return err;
+  }
+  if (st->par->sink(st->data, st->num, st->par->sink_arg))
+    return CFGCLI_ERR_SINK;
+  st->total += st->num;
+  st->num = st->slen = 0;
+  return 0;
+}
+
+/******************************************************************************
+Function `cfgcli_stream_push`:
+  Convert the array elements in a segment of a multiple-line definition, and
+  append them to the streamed array.
+Arguments:
+  * `st`:       the streaming state;
+  * `seg`:      the null terminated segment;
+  * `len`:      length of the segment, NOT including the ending '\0';
+  * `last`:     true if the segment ends with the last element of the array;
+  * `src`:      source of the value.
+Return:
+  Zero on success; non-zero on error.
+******************************************************************************/
+static int cfgcli_stream_push(cfgcli_stream_t *st, char *seg, const size_t len,
+    const bool last, const int src) {
+  const cfgcli_dtype_t dtype = cfgcli_elem_dtype(st->par->dtype);
+  const size_t size = (dtype == CFGCLI_DTYPE_STR) ?
+      sizeof(cfgcli_stream_str_t) : cfgcli_dtype_size(dtype);
+  char *start = seg;
+  char quote = '\0';
+  bool begin = true;            /* no visible character of the element yet */
+
+  for (size_t i = 0; i <= len; i++) {
+    const char c = seg[i];      /* seg[len] is surely '\0' */
+    if (quote) {
+      if (c == quote) quote = '\0';
+      continue;
+    }
+    if (i < len && c != CFGCLI_SYM_ARRAY_SEP) {
+      if (begin && (c == '"' || c == '\'')) quote = c;   /* enter quotes */
+      if (!isspace(c)) begin = false;
+      continue;
+    }
+
+    /* The segment may end with whitespaces before the line continuation. */
+    if (i == len && !last) {
+      if (!begin) return CFGCLI_ERR_VALUE;
+      break;
+    }
+
+    /* Reserve space for the element. */
+    if ((st->num + 1) * size > st->max) {
+      size_t max = cfgcli_grow_size(st->max, (st->num + 1) * size);
+      if (!max) return CFGCLI_ERR_MEMORY;
+      char *tmp = realloc(st->data, max);
+      if (!tmp) return CFGCLI_ERR_MEMORY;
+      st->data = tmp;
+      st->max = max;
+    }
+
+    /* Convert the element. */
+    seg[i] = '\0';
+    const size_t elen = seg + i - start + 1;    /* including the '\0' */
+    int err;
+    if (dtype == CFGCLI_DTYPE_STR && cfgcli_interning(st->cfg)) {
+      if ((err = cfgcli_get_intern(st->cfg,
+          &((cfgcli_stream_str_t *) st->data)[st->num].ptr, start, elen, src)))
+        return err;
+    }
+    else if (dtype == CFGCLI_DTYPE_STR) {
+      if (st->slen + elen > st->smax) {
+        size_t max = cfgcli_grow_size(st->smax, st->slen + elen);
+        if (!max) return CFGCLI_ERR_MEMORY;
+        char *tmp = realloc(st->str, max);
+        if (!tmp) return CFGCLI_ERR_MEMORY;
+        st->str = tmp;
+        st->smax = max;
+      }
+      char *tmp = st->str + st->slen;
+      if ((err = cfgcli_get_value(&tmp, start, elen, dtype, src))) return err;
+      ((cfgcli_stream_str_t *) st->data)[st->num].off = st->slen;
+      st->slen += strlen(tmp) + 1;
+    }
+    else if ((err = cfgcli_get_value(st->data + st->num * size, start, elen,
+        dtype, src))) return err;
+
+    st->num += 1;
+    start = seg + i + 1;
+    begin = true;
+    if (st->par->sink && st->num * size >= CFGCLI_SINK_BATCH_SIZE &&
+        (err = cfgcli_stream_flush(st))) return err;
+  }
+
+  return quote ? CFGCLI_ERR_VALUE : 0;
+}
+
+/******************************************************************************
+Function `cfgcli_stream_free`:
+  Release memory allocated for an unfinished streamed array.
+Arguments:
+  * `st`:       the streaming state.
+******************************************************************************/
+static void cfgcli_stream_free(cfgcli_stream_t *st) {
+  if (st->data) free(st->data);
+  if (st->str) free(st->str);
+  memset(st, 0, sizeof(cfgcli_stream_t));
+}
+
+/******************************************************************************
+Function `cfgcli_stream_finish`:
+  Shrink the streamed array to its final size, and pass it to the variable,
+  or pass the remaining elements to the sink of the parameter.
+Arguments:
+  * `st`:       the streaming state.
+Return:
+  Zero on success; non-zero on error.
+******************************************************************************/
+static int cfgcli_stream_finish(cfgcli_stream_t *st) {
+  cfgcli_param_valid_t *par = st->par;
+  size_t size = cfgcli_dtype_size(par->dtype);
+  char *tmp;
+  if (!st->num && !st->total) return CFGCLI_ERR_VALUE;
+  if (par->sink) {              /* nothing is kept */
+    const int err = cfgcli_stream_flush(st);
+    par->narr = st->total;
+    return err;
+  }
+
+  if (par->dtype == CFGCLI_ARRAY_STR && st->str) {   /* not interned */
+    if ((tmp = realloc(st->str, st->slen))) st->str = tmp;
+    /* Replace offsets by addresses; the elements are never larger. */
+    for (size_t i = 0; i < st->num; i++) {
+      const size_t off = ((cfgcli_stream_str_t *) st->data)[i].off;
+      ((char **) st->data)[i] = st->str + off;
+    }
+    st->str = NULL;
+  }
+  else if (par->dtype == CFGCLI_ARRAY_STR) {
+    for (size_t i = 0; i < st->num; i++)
+      ((char **) st->data)[i] = ((cfgcli_stream_str_t *) st->data)[i].ptr;
+  }
+  if ((tmp = realloc(st->data, st->num * size))) st->data = tmp;
+
+  *((void **) par->var) = st->data;
+  par->narr = st->num;
+  st->data = NULL;
+  return cfgcli_check_param(par);
+}
+
+
+/*============================================================================*\
+                Functions for reading compressed configurations
+\*============================================================================*/
+
+/******************************************************************************
+Function `cfgcli_source_codec`:
+  Detect the compression format with the magic bytes.
+Arguments:
+  * `magic`:    the first bytes of the text;
+  * `len`:      number of the bytes.
+Return:
+  The compression format.
+******************************************************************************/
+static cfgcli_codec_t cfgcli_source_codec(const unsigned char *magic,
+    const size_t len) {
+  if (len >= 2 && magic[0] == 0x1f && magic[1] == 0x8b)
+    return CFGCLI_CODEC_GZIP;
+  if (len >= 4 && magic[0] == 0x28 && magic[1] == 0xb5 && magic[2] == 0x2f &&
+      magic[3] == 0xfd) return CFGCLI_CODEC_ZSTD;
+  return CFGCLI_CODEC_NONE;
+}
+
+/******************************************************************************
+Function `cfgcli_source_close`:
+  Release memory allocated for a source, without closing the file.
+Arguments:
+  * `src`:      the source.
+******************************************************************************/
+static void cfgcli_source_close(cfgcli_source_t *src) {
+#ifdef HAVE_ZLIB
+  if (src->codec == CFGCLI_CODEC_GZIP) inflateEnd(&src->zs);
+#endif
+#ifdef HAVE_ZSTD
+  ZSTD_freeDStream(src->ds);
+  src->ds = NULL;
+#endif
+  free(src->in);
+  src->in = NULL;
+}
+
+/******************************************************************************
+Function `cfgcli_source_init`:
+  Detect the compression format of a file or buffer, and prepare for reading.
+Arguments:
+  * `cfg`:      entry for the configurations;
+  * `src`:      the source to be initialised;
+  * `fp`:       the file, or NULL for reading the buffer;
+  * `buf`:      the buffer, unused if `fp` is set;
+  * `len`:      length of the buffer;
+  * `fname`:    name of the file, for error messages.
+Return:
+  Zero on success; non-zero on error.
+******************************************************************************/
+static int cfgcli_source_init(cfgcli_t *cfg, cfgcli_source_t *src, FILE *fp,
+    char *buf, const size_t len, const char *fname) {
+  memset(src, 0, sizeof(cfgcli_source_t));
+  src->fp = fp;
+  if (fp) {
+    src->nhead = fread(src->head, sizeof(char), CFGCLI_SOURCE_MAGIC_LEN, fp);
+    src->codec = cfgcli_source_codec(src->head, src->nhead);
+  }
+  else {
+    src->next = (unsigned char *) buf;
+    src->avail = len;
+    src->codec = cfgcli_source_codec(src->next, src->avail);
+  }
+  if (src->codec == CFGCLI_CODEC_NONE) return 0;
+
+  /* Compressed input is read by blocks, after the detected bytes. */
+  if (fp) {
+    if (!(src->in = malloc(CFGCLI_SOURCE_IN_SIZE))) {
+      cfgcli_msg(cfg, "failed to allocate memory for decompressing the file",
+          fname);
+      return CFGCLI_ERRNO(cfg) = CFGCLI_ERR_MEMORY;
+    }
+    memcpy(src->in, src->head, src->nhead);
+    src->next = src->in;
+    src->avail = src->nhead;
+    src->nhead = 0;
+  }
+
+  switch (src->codec) {
+#ifdef HAVE_ZLIB
+    case CFGCLI_CODEC_GZIP:
+      if (inflateInit2(&src->zs, 16 + MAX_WBITS) != Z_OK) break;
+      return 0;
+#endif
+#ifdef HAVE_ZSTD
+    case CFGCLI_CODEC_ZSTD:
+      if (!(src->ds = ZSTD_createDStream())) break;
+      return 0;
+#endif
+    default:
+      cfgcli_source_close(src);
+      cfgcli_msg(cfg, (src->codec == CFGCLI_CODEC_GZIP) ?
+          "reading gzip compressed files requires zlib" :
+          "reading Zstandard compressed files requires libzstd", fname);
+      return CFGCLI_ERRNO(cfg) = CFGCLI_ERR_FILE;
+  }
+  cfgcli_source_close(src);
+  cfgcli_msg(cfg, "failed to initialise the decompression of the file", fname);
+  return CFGCLI_ERRNO(cfg) = CFGCLI_ERR_MEMORY;
+}
+
+/******************************************************************************
+Function `cfgcli_source_fill`:
+  Make compressed input available, by reading the next block of the file.
+Arguments:
+  * `src`:      the source.
+Return:
+  True if there is input to be decompressed; false otherwise.
+******************************************************************************/
+static bool cfgcli_source_fill(cfgcli_source_t *src) {
+  if (src->avail) return true;
+  if (!src->fp) return false;
+  src->next = src->in;
+  src->avail = fread(src->in, sizeof(char), CFGCLI_SOURCE_IN_SIZE, src->fp);
+  if (!src->avail && ferror(src->fp)) src->fail = true;
+  return src->avail != 0;
+}
+
+/******************************************************************************
+Function `cfgcli_source_read`:
+  Read text from a source, decompressed directly into the destination.
+Arguments:
+  * `src`:      the source;
+  * `buf`:      the destination;
+  * `size`:     capacity of the destination.
+Return:
+  Number of characters read, which is smaller than `size` only if the end
+  of the text is reached, or on error.
+******************************************************************************/
+static size_t cfgcli_source_read(cfgcli_source_t *src, char *buf,
+    const size_t size) {
+  size_t cnt = 0;
+  if (src->eof || src->fail) return 0;
+
+  if (src->codec == CFGCLI_CODEC_NONE) {
+    /* Bytes read for the detection of the format come first. */
+    if (src->nhead) {
+      cnt = (src->nhead < size) ? src->nhead : size;
+      memcpy(buf, src->head, cnt);
+      memmove(src->head, src->head + cnt, src->nhead - cnt);
+      src->nhead -= cnt;
+    }
+    if (src->fp) {
+      cnt += fread(buf + cnt, sizeof(char), size - cnt, src->fp);
+      if (cnt < size) {
+        if (ferror(src->fp)) src->fail = true;
+        else src->eof = true;
+      }
+    }
+    else {
+      size_t n = (src->avail < size) ? src->avail : size;
+      memcpy(buf, src->next, n);
+      src->next += n;
+      src->avail -= n;
+      if ((cnt = n) < size) src->eof = true;
+    }
+    return cnt;
+  }
+
+  while (cnt < size) {
+    /* Output may be pending in the decoder if the last call filled `buf`. */
+    if (!src->flush && !cfgcli_source_fill(src)) {
+      if (src->end && !src->fail) src->eof = true;
+      else src->fail = true;            /* truncated compressed data */
+      break;
+    }
+    size_t room = size - cnt, used = 0, made = 0;
+    switch (src->codec) {
+#ifdef HAVE_ZLIB
+      case CFGCLI_CODEC_GZIP: {
+        /* Concatenated gzip members are decompressed in turn. */
+        if (src->end && inflateReset(&src->zs) != Z_OK) {
+          src->fail = true;
+          break;
+        }
+        if (room > UINT_MAX) room = UINT_MAX;
+        src->zs.next_in = src->next;
+        src->zs.avail_in = (src->avail > UINT_MAX) ? UINT_MAX : src->avail;
+        src->zs.next_out = (unsigned char *) buf + cnt;
+        src->zs.avail_out = room;
+        int ret = inflate(&src->zs, Z_NO_FLUSH);
+        used = src->zs.next_in - src->next;
+        made = room - src->zs.avail_out;
+        src->end = (ret == Z_STREAM_END);
+        if (ret != Z_OK && ret != Z_STREAM_END && ret != Z_BUF_ERROR)
+          src->fail = true;
+        break;
+      }
+#endif
+#ifdef HAVE_ZSTD
+      case CFGCLI_CODEC_ZSTD: {
+        /* Consecutive frames are decompressed by the same stream. */
+        ZSTD_inBuffer zin = { src->next, src->avail, 0 };
+        ZSTD_outBuffer zout = { buf + cnt, room, 0 };
+        size_t ret = ZSTD_decompressStream(src->ds, &zout, &zin);
+        used = zin.pos;
+        made = zout.pos;
+        if (ZSTD_isError(ret)) src->fail = true;
+        else src->end = (ret == 0);
+        break;
+      }
+#endif
+      default:
+        src->fail = true;
+        break;
+    }
+    if (src->fail) break;
+    src->next += used;
+    src->avail -= used;
+    cnt += made;
+    src->flush = !src->end && made == room;
+  }
+  return cnt;
+}
+
+
+/*============================================================================*\
+                    Functions for reading included files
+\*============================================================================*/
+
+/******************************************************************************
+Function `cfgcli_include_free`:
+  Release memory allocated for the cached tokens of an included file.
+Arguments:
+  * `inc`:      the cached file.
+******************************************************************************/
+static void cfgcli_include_free(cfgcli_include_t *inc) {
+  if (!inc) return;
+  free(inc->fname);
+  free(inc->text);
+  free(inc->tok);
+  free(inc);
+}
+
+/******************************************************************************
+Function `cfgcli_include_load`:
+  Read an included file and split it into tokens.
+Arguments:
+  * `cfg`:      entry for the configurations;
+  * `fname`:    name of the included file.
+Return:
+  Address of the cached tokens on success; NULL on error.
+******************************************************************************/
+static cfgcli_include_t *cfgcli_include_load(cfgcli_t *cfg,
+    const char *fname) {
+  FILE *fp = fopen(fname, "r");
+  if (!fp) {
+    cfgcli_msg(cfg, "cannot open the included file", fname);
+    CFGCLI_ERRNO(cfg) = CFGCLI_ERR_FILE;
+    return NULL;
+  }
+  struct stat st;
+  cfgcli_source_t src;
+  if (cfgcli_source_init(cfg, &src, fp, NULL, 0, fname)) {
+    fclose(fp);
+    return NULL;
+  }
+  size_t len = 0, size = 0;
+  cfgcli_include_t *inc = calloc(1, sizeof(cfgcli_include_t));
+  if (!inc || fstat(fileno(fp), &st) || st.st_size < 0 ||
+      (uintmax_t) st.st_size >= SIZE_MAX ||
+      !(inc->fname = malloc(strlen(fname) + 1)) ||
+      !(inc->text = malloc((size = (size_t) st.st_size + 1) + 1))) {
+    cfgcli_source_close(&src);
+    fclose(fp);
+    cfgcli_include_free(inc);
+    cfgcli_msg(cfg, "failed to allocate memory for reading the included file",
+        fname);
+    CFGCLI_ERRNO(cfg) = CFGCLI_ERR_MEMORY;
+    return NULL;
+  }
+  strcpy(inc->fname, fname);
+  inc->dev = st.st_dev;
+  inc->ino = st.st_ino;
+  inc->mtime = st.st_mtime;
+  inc->mtime_ns = CFGCLI_MTIME_NS(st);
+  inc->size = st.st_size;
+
+  /* Read the full file, which grows only if it is compressed. */
+  while ((len += cfgcli_source_read(&src, inc->text + len, size - len)) == size &&
+      src.codec != CFGCLI_CODEC_NONE) {
+    size_t new_size = cfgcli_grow_size(size, size + 1);
+    char *tmp = (new_size > size && new_size < SIZE_MAX) ?
+      realloc(inc->text, new_size + 1) : NULL;
+    if (!tmp) {
+      cfgcli_source_close(&src);
+      fclose(fp);
+      cfgcli_include_free(inc);
+      cfgcli_msg(cfg, "failed to allocate memory for reading the included file",
+          fname);
+      CFGCLI_ERRNO(cfg) = CFGCLI_ERR_MEMORY;
+      return NULL;
+    }
+    inc->text = tmp;
+    size = new_size;
+  }
+  const bool fail = !src.eof ||         /* the file has been modified */
+    (src.codec == CFGCLI_CODEC_NONE && len != (size_t) st.st_size);
+  cfgcli_source_close(&src);
+  fclose(fp);
+  if (fail) {
+    cfgcli_include_free(inc);
+    cfgcli_msg(cfg, "unexpected end of the included file", fname);
+    CFGCLI_ERRNO(cfg) = CFGCLI_ERR_FILE;
+    return NULL;
+  }
+  inc->text[len] = '\0';
+
+  /* Split lines into tokens. */
+  size_t max = 0, nline = 0;
+  char *p, *key, *value, *end = inc->text + len;
+  cfgcli_parse_state_t state = CFGCLI_PARSE_START;
+  key = value = NULL;
+  for (p = inc->text; p < end; ) {
+    char *endl = memchr(p, '\n', end - p);
+    if (endl) *endl = '\0';
+    else endl = end;
+    nline += 1;
+
+    cfgcli_parse_return_t status =
+      cfgcli_parse_line(p, endl - p, &key, &value, state);
+    if (status == CFGCLI_PARSE_CONTINUE) {     /* line continuation */
+      if (endl < end) *endl = ' ';
+      state = CFGCLI_PARSE_ARRAY_START;
+      p = endl + 1;
+      continue;
+    }
+    state = CFGCLI_PARSE_START;
+    if (status == CFGCLI_PARSE_PASS) {
+      p = endl + 1;
+      continue;
+    }
+
+    /* Record the token. */
+    if (inc->ntok == max) {
+      max = max ? max << 1 : 64;
+      cfgcli_token_t *tmp = realloc(inc->tok, max * sizeof(cfgcli_token_t));
+      if (!tmp) {
+        cfgcli_include_free(inc);
+        cfgcli_msg(cfg, "failed to allocate memory for reading the included file",
+            fname);
+        CFGCLI_ERRNO(cfg) = CFGCLI_ERR_MEMORY;
+        return NULL;
+      }
+      inc->tok = tmp;
+    }
+    cfgcli_token_t *tok = inc->tok + inc->ntok++;
+    tok->line = nline;
+    tok->key = key;
+    tok->value = value;
+    tok->vlen = 0;
+    switch (status) {
+      case CFGCLI_PARSE_DONE:
+        tok->type = CFGCLI_TOKEN_ENTRY;
+        tok->vlen = strlen(value) + 1;
+        break;
+      case CFGCLI_PARSE_INCLUDE:
+        tok->type = CFGCLI_TOKEN_INCLUDE;
+        break;
+      case CFGCLI_PARSE_SECTION:
+        tok->type = CFGCLI_TOKEN_SECTION;
+        break;
+      default:
+        tok->type = CFGCLI_TOKEN_ERROR;
+        break;
+    }
+    key = value = NULL;
+    p = endl + 1;
+  }
+  if (state != CFGCLI_PARSE_START) {    /* the last line is continued */
+    cfgcli_include_free(inc);
+    cfgcli_msg(cfg, "unterminated line continuation in the included file",
+        fname);
+    CFGCLI_ERRNO(cfg) = CFGCLI_ERR_FILE;
+    return NULL;
+  }
+  return inc;
+}
+
+static int cfgcli_read_include(cfgcli_t *cfg, const char *from,
+    const char *path, const int prior, cfgcli_chain_t *chain);
+
+/******************************************************************************
+Function `cfgcli_read_tokens`:
+  Assign the values of the cached tokens of an included file.
+Arguments:
+  * `cfg`:      entry for the configurations;
+  * `inc`:      the cached file;
+  * `prior`:    priority of the values;
+  * `chain`:    the chain of files being read.
+Return:
+  Zero on success; non-zero on error.
+******************************************************************************/
+static int cfgcli_read_tokens(cfgcli_t *cfg, const cfgcli_include_t *inc,
+    const int prior, cfgcli_chain_t *chain) {
+  char msg[CFGCLI_MAX_FILENAME_LEN + CFGCLI_NUM_MAX_SIZE(size_t) + 1];
+  char *buf = NULL;             /* values are modified by the conversion */
+  size_t max = 0;
+  int err = 0;
+  cfgcli_section_t sec;
+  cfgcli_section_set(cfg, &sec, "");    /* files start at the top level */
+
+  for (size_t i = 0; i < inc->ntok && !err; i++) {
+    const cfgcli_token_t *tok = inc->tok + i;
+    switch (tok->type) {
+      case CFGCLI_TOKEN_ENTRY:
+        if (tok->vlen > max) {
+          char *tmp = realloc(buf, tok->vlen);
+          if (!tmp) {
+            cfgcli_msg(cfg, "failed to allocate memory for parameter", tok->key);
+            err = CFGCLI_ERRNO(cfg) = CFGCLI_ERR_MEMORY;
+            break;
+          }
+          buf = tmp;
+          max = tok->vlen;
+        }
+        memcpy(buf, tok->value, tok->vlen);
+        err = cfgcli_read_entry(cfg, cfgcli_section_key(cfg, &sec, tok->key),
+            buf, prior, false);
+        break;
+      case CFGCLI_TOKEN_INCLUDE:
+        err = cfgcli_read_include(cfg, inc->fname, tok->value, prior, chain);
+        break;
+      case CFGCLI_TOKEN_SECTION:
+        cfgcli_section_set(cfg, &sec, tok->key);
+        break;
+      default:
+        snprintf(msg, sizeof msg, "%s:%zu", inc->fname, tok->line);
+        cfgcli_msg(cfg, "invalid configuration entry at", msg);
+        break;
+    }
+  }
+  free(buf);
+  return err;
+}
+
+/******************************************************************************
+Function `cfgcli_read_include`:
+  Read configuration parameters from an included file, using cached tokens
+  if the file is not modified since it was read.
+Arguments:
+  * `cfg`:      entry for the configurations;
+  * `from`:     name of the including file, NULL for the working directory;
+  * `path`:     path of the included file, relative to the including file;
+  * `prior`:    priority of values read from this file;
+  * `chain`:    the chain of files being read.
+Return:
+  Zero on success; non-zero on error.
+******************************************************************************/
+static int cfgcli_read_include(cfgcli_t *cfg, const char *from,
+    const char *path, const int prior, cfgcli_chain_t *chain) {
+  char fname[CFGCLI_MAX_FILENAME_LEN];
+  const char *sep = from ? strrchr(from, '/') : NULL;
+  int dlen = (sep && *path != '/') ? sep - from + 1 : 0;
+  if (*path == '\0' || dlen >= CFGCLI_MAX_FILENAME_LEN ||
+      snprintf(fname, sizeof fname, "%.*s%s", dlen, from, path) >=
+      (int) sizeof fname) {
+    cfgcli_msg(cfg, "invalid path of the included file", path);
+    return CFGCLI_ERRNO(cfg) = CFGCLI_ERR_INPUT;
+  }
+
+  struct stat st;
+  if (stat(fname, &st)) {
+    cfgcli_msg(cfg, "cannot open the included file", fname);
+    return CFGCLI_ERRNO(cfg) = CFGCLI_ERR_FILE;
+  }
+  for (int i = 0; i < chain->depth; i++) {
+    if (chain->dev[i] == st.st_dev && chain->ino[i] == st.st_ino) {
+      cfgcli_msg(cfg, "recursive inclusion of file", fname);
+      return CFGCLI_ERRNO(cfg) = CFGCLI_ERR_FILE;
+    }
+  }
+  if (chain->depth > CFGCLI_MAX_INCLUDE_DEPTH) {
+    cfgcli_msg(cfg, "too many nested included files at", fname);
+    return CFGCLI_ERRNO(cfg) = CFGCLI_ERR_FILE;
+  }
+
+  /* Search for the cached tokens, and drop them if the file is modified. */
+  cfgcli_include_t **pinc = (cfgcli_include_t **) &cfg->includes;
+  cfgcli_include_t *inc;
+  for (inc = *pinc; inc; pinc = &inc->next, inc = inc->next)
+    if (inc->dev == st.st_dev && inc->ino == st.st_ino) break;
+  if (inc && (inc->size != st.st_size ||
+      inc->mtime != st.st_mtime || inc->mtime_ns != CFGCLI_MTIME_NS(st))) {
+    *pinc = inc->next;
+    cfgcli_include_free(inc);
+    inc = NULL;
+  }
+  if (!inc) {
+    if (!(inc = cfgcli_include_load(cfg, fname))) return CFGCLI_ERRNO(cfg);
+    inc->next = (cfgcli_include_t *) cfg->includes;
+    cfg->includes = inc;
+  }
+
+  chain->dev[chain->depth] = inc->dev;
+  chain->ino[chain->depth] = inc->ino;
+  chain->depth += 1;
+  int err = cfgcli_read_tokens(cfg, inc, prior, chain);
+  chain->depth -= 1;
+  return err;
+}
+
+
+/*============================================================================*\
+               Functions for reading command line response files
+\*============================================================================*/
+
+/******************************************************************************
+Function `cfgcli_response_map`:
+  Map a response file into memory privately, or read it if `mmap` is not
+  available, so that it can be split into arguments in place, with a '\0'
+  available after the last character.
+Arguments:
+  * `cfg`:      entry for the configurations;
+  * `fname`:    name of the response file;
+  * `len`:      length of the file.
+Return:
+  Address of the content on success; NULL on error.
+******************************************************************************/
+static char *cfgcli_response_map(cfgcli_t *cfg, const char *fname,
+    size_t *len) {
+#ifdef HAVE_MMAP
+  struct stat st;
+  int fd = open(fname, O_RDONLY);
+  if (fd == -1 || fstat(fd, &st)) {
+    if (fd != -1) close(fd);
+#else
+  FILE *fp = fopen(fname, "r");
+  if (!fp) {
+#endif
+    cfgcli_msg(cfg, "cannot open the response file", fname);
+    CFGCLI_ERRNO(cfg) = CFGCLI_ERR_FILE;
+    return NULL;
+  }
+
+  cfgcli_map_t *map = malloc(sizeof(cfgcli_map_t));
+  if (!map) {
+#ifdef HAVE_MMAP
+    close(fd);
+#else
+    fclose(fp);
+#endif
+    cfgcli_msg(cfg, "failed to allocate memory for the response file", fname);
+    CFGCLI_ERRNO(cfg) = CFGCLI_ERR_MEMORY;
+    return NULL;
+  }
+
+#ifdef HAVE_MMAP
+  /* Reserve zeroed memory beyond the end of the file, and map the file to
+     the start of it, as pages past the end of the file cannot be accessed. */
+  *len = st.st_size;
+  map->len = *len + 1;
+  map->addr = mmap(NULL, map->len, PROT_READ | PROT_WRITE,
+      MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (map->addr != MAP_FAILED && *len && mmap(map->addr, *len,
+      PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_FIXED, fd, 0) == MAP_FAILED) {
+    munmap(map->addr, map->len);
+    map->addr = MAP_FAILED;
+  }
+  close(fd);
+  if (map->addr == MAP_FAILED) {
+    free(map);
+    cfgcli_msg(cfg, "failed to map the response file", fname);
+    CFGCLI_ERRNO(cfg) = CFGCLI_ERR_FILE;
+    return NULL;
+  }
+#else
+  /* Read the full file, with a byte reserved for the '\0'. */
+  char *text = NULL;
+  size_t size = 0, cnt;
+  *len = 0;
+  do {
+    if (*len + 1 >= size) {
+      const size_t new_size = cfgcli_grow_size(size, *len + 2);
+      char *tmp = new_size ? realloc(text, new_size) : NULL;
+      if (!tmp) {
+        free(text);
+        free(map);
+        fclose(fp);
+        cfgcli_msg(cfg, "failed to allocate memory for the response file",
+            fname);
+        CFGCLI_ERRNO(cfg) = CFGCLI_ERR_MEMORY;
+        return NULL;
+      }
+      text = tmp;
+      size = new_size;
+    }
+    *len += cnt = fread(text + *len, sizeof(char), size - *len - 1, fp);
+  }
+  while (cnt);
+  const bool fail = ferror(fp);
+  fclose(fp);
+  if (fail) {
+    free(text);
+    free(map);
+    cfgcli_msg(cfg, "failed to read the response file", fname);
+    CFGCLI_ERRNO(cfg) = CFGCLI_ERR_FILE;
+    return NULL;
+  }
+  text[*len] = '\0';
+  map->addr = text;
+  map->len = size;
+#endif
+  map->next = (cfgcli_map_t *) cfg->maps;
+  cfg->maps = map;
+  return map->addr;
+}
+
+/******************************************************************************
+Function `cfgcli_response_token`:
+  Extract the next argument from a response file in place. Arguments are
+  separated by whitespaces, unless they are enclosed by quotation marks,
+  which are removed.
+Arguments:
+  * `pos`:      position of the next unread character;
+  * `end`:      end of the file, which is followed by a writable byte.
+Return:
+  The null terminated argument; NULL if there is no more argument.
+******************************************************************************/
+static char *cfgcli_response_token(char **pos, char *end) {
+  char *src = *pos;
+  while (src < end && isspace(*src)) src++;
+  if (src >= end) {
+    *pos = end;
+    return NULL;
+  }
+  char *arg = src, *dst = src;
+  char quote = '\0';
+  for (; src < end && *src != '\0'; src++) {
+    if (quote) {
+      if (*src == quote) quote = '\0';
+      else *dst++ = *src;
+    }
+    else if (*src == '"' || *src == '\'') quote = *src;
+    else if (isspace(*src)) break;
+    else *dst++ = *src;
+  }
+  *pos = (src < end) ? src + 1 : end;
+  *dst = '\0';                  /* never beyond the separator */
+  return arg;
+}
+
+/******************************************************************************
+Function `cfgcli_args_next`:
+  Retrieve the next command line argument, and expand response files.
+Arguments:
+  * `cfg`:      entry for the configurations;
+  * `args`:     the argument iterator;
+  * `arg`:      the argument, NULL if there is no more argument.
+Return:
+  Zero on success; non-zero on error.
+******************************************************************************/
+static int cfgcli_args_next(cfgcli_t *cfg, cfgcli_args_t *args, char **arg) {
+  if (args->peeked) {
+    args->peeked = false;
+    *arg = args->ahead;
+    return 0;
+  }
+  for (;;) {
+    /* Read arguments from the innermost response file first. */
+    char *a = NULL;
+    while (args->depth && !(a = cfgcli_response_token(
+        args->pos + args->depth - 1, args->end[args->depth - 1])))
+      args->depth -= 1;
+    if (!a && args->idx < args->argc) a = args->argv[args->idx++];
+    if (!a || a[0] != CFGCLI_CMD_RESPONSE || a[1] == '\0') {
+      *arg = a;
+      return 0;
+    }
+
+    if (args->depth >= CFGCLI_MAX_RESPONSE_DEPTH) {
+      cfgcli_msg(cfg, "too many nested response files at", a + 1);
+      return CFGCLI_ERRNO(cfg) = CFGCLI_ERR_CMD;
+    }
+    size_t len;
+    char *text = cfgcli_response_map(cfg, a + 1, &len);
+    if (!text) return CFGCLI_ERRNO(cfg);
+    args->pos[args->depth] = text;
+    args->end[args->depth] = text + len;
+    args->depth += 1;
+  }
+}
+
+/******************************************************************************
+Function `cfgcli_args_peek`:
+  Retrieve the next command line argument without consuming it.
+Arguments:
+  * `cfg`:      entry for the configurations;
+  * `args`:     the argument iterator;
+  * `arg`:      the argument, NULL if there is no more argument.
+Return:
+  Zero on success; non-zero on error.
+******************************************************************************/
+static int cfgcli_args_peek(cfgcli_t *cfg, cfgcli_args_t *args, char **arg) {
+  if (!args->peeked) {
+    int err = cfgcli_args_next(cfg, args, &args->ahead);
+    if (err) return err;
+    args->peeked = true;
+  }
+  *arg = args->ahead;
+  return 0;
+}
+
+
+/*============================================================================*\
+                High-level functions for reading configurations
+                    from command line options and text files
+\*============================================================================*/
+
+/******************************************************************************
+Function `cfgcli_find_cmd`:
+  Find a pending subcommand by name.
+Arguments:
+  * `cfg`:      entry for all subcommands;
+  * `arg`:      the command line argument.
+Return:
+  Index of the subcommand; -1 if it is not found.
+******************************************************************************/
+static int cfgcli_find_cmd(const cfgcli_t *cfg, const char *arg) {
+  const cfgcli_cmd_valid_t *cmds = (cfgcli_cmd_valid_t *) cfg->cmds;
+  for (int i = 0; i < cfg->ncmd; i++) {
+    if (!strncmp(cmds[i].name, arg, cmds[i].nlen + 1)) return i;
+  }
+  return -1;
+}
+
+/******************************************************************************
+Function `cfgcli_select_cmd`:
+  Select a subcommand, and register its parameters, functions, and nested
+  subcommands, which replace the pending subcommands.
+Arguments:
+  * `cfg`:      entry for all subcommands;
+  * `idx`:      index of the selected subcommand.
+Return:
+  Zero on success; non-zero on error.
+******************************************************************************/
+static int cfgcli_select_cmd(cfgcli_t *cfg, const int idx) {
+  cfgcli_cmd_valid_t cmd = ((cfgcli_cmd_valid_t *) cfg->cmds)[idx];
+  free(cfg->cmds);
+  cfg->cmds = NULL;
+  cfg->ncmd = 0;
+  cfg->cmd = cmd.name;
+
+  if (cmd.func(cfg, cmd.args)) {
+    if (CFGCLI_IS_ERROR(cfg)) return CFGCLI_ERRNO(cfg);
+    cfgcli_msg(cfg, "failed to register options of subcommand", cmd.name);
+    return CFGCLI_ERRNO(cfg) = CFGCLI_ERR_CMD;
+  }
+  return 0;
+}
+
+/******************************************************************************
+Function `cfgcli_read_opts`:
+  Parse command line options.
+Arguments:
+  * `cfg`:      entry for the configurations;
+  * `argc`:     number of arguments passed via command line;
+  * `argv`:     array of command line arguments;
+  * `prior`:    priority of values set via command line options;
+  * `optidx`:   position of the first unparsed argument.
+Return:
+  Zero on success; non-zero on error.
+******************************************************************************/
+int cfgcli_read_opts(cfgcli_t *cfg, const int argc, char *const *argv,
+    const int prior, int *optidx) {
+  /* Validate function arguments. */
+  if (!cfg) return CFGCLI_ERR_INIT;
+  if (CFGCLI_IS_ERROR(cfg)) return CFGCLI_ERRNO(cfg);
+  if (cfg->npar <= 0 && cfg->nfunc <= 0 && cfg->ncmd <= 0) {
+    cfgcli_msg(cfg, "no parameter or function has been registered", NULL);
+    return CFGCLI_ERRNO(cfg) = CFGCLI_ERR_INIT;
+  }
+  if (prior <= CFGCLI_SRC_NULL) {
+    cfgcli_msg(cfg, "invalid priority for command line options", NULL);
+    return CFGCLI_ERRNO(cfg) = CFGCLI_ERR_INPUT;
+  }
+
+  *optidx = 0;
+  if (argc <= 0 || !argv || !(*argv)) return 0;
+  cfgcli_args_t args;
+  memset(&args, 0, sizeof(cfgcli_args_t));
+  args.argc = argc;
+  args.argv = argv;
+  args.idx = 1;
+  char *arg;
+  int err;
+
+  /* Start parsing command line options. */
+  while (!(err = cfgcli_args_next(cfg, &args, &arg)) && arg) {
+    if (!(CFGCLI_IS_OPT(arg))) {
+      if (cfg->ncmd > 0) {              /* select a subcommand */
+        const int idx = cfgcli_find_cmd(cfg, arg);
+        if (idx < 0) {
+          cfgcli_msg(cfg, "unknown subcommand", arg);
+          return CFGCLI_ERRNO(cfg) = CFGCLI_ERR_CMD;
+        }
+        if ((err = cfgcli_select_cmd(cfg, idx))) return err;
+      }
+      else                              /* unrecognised option */
+        cfgcli_msg(cfg, "unrecognised command line option", arg);
+      continue;
+    }
+
+    int j;
+    char *optarg = NULL;
+
+    /* The option and its argument are located without modifying `arg`. */
+    for (j = 0; j < CFGCLI_MAX_LOPT_LEN + 2; j++)  /* check if '=' exists */
+      if (arg[j] == '\0' || arg[j] == CFGCLI_CMD_ASSIGN) break;
+    const size_t olen = j - 2;          /* length of the long option */
+    if (arg[j] == '\0') {                       /* '=' is not found */
+      char *next = NULL;
+      /* The argument after "--" is the first unparsed one. */
+      if (!(arg[1] == CFGCLI_CMD_FLAG && arg[2] == '\0') &&
+          (err = cfgcli_args_peek(cfg, &args, &next))) return err;
+      if (next && !(CFGCLI_IS_OPT(next)) && cfgcli_find_cmd(cfg, next) < 0) {
+        optarg = next;
+        args.peeked = false;            /* consume the argument */
+      }
+    }
+    else if (arg[j] == CFGCLI_CMD_ASSIGN) {        /* '=' is found */
+      optarg = &arg[j + 1];
+    }
+    else {
+      cfgcli_msg(cfg, "the command line option is too long", arg);
+      return CFGCLI_ERRNO(cfg) = CFGCLI_ERR_CMD;
+    }
+
+    cfgcli_param_valid_t *params = (cfgcli_param_valid_t *) cfg->params;
+    cfgcli_func_valid_t *funcs = (cfgcli_func_valid_t *) cfg->funcs;
+    enum { not_found, is_param, is_func } status;
+    status = not_found;
+
+    if (arg[1] != CFGCLI_CMD_FLAG) {               /* short option */
+      for (j = 0; j < cfg->npar; j++) {
+        if (arg[1] == params[j].opt) {
+          status = is_param;
+          break;
+        }
+      }
+      if (status != is_param) {
+        for (j = 0; j < cfg->nfunc; j++) {
+          if (arg[1] == funcs[j].opt) {
+            status = is_func;
+            break;
+          }
+        }
+      }
+    }
+    else if (arg[2] != '\0') {                  /* long option */
+      /* Match the option or an unambiguous prefix, in O(olen). */
+      int node;
+      const int opt = cfgcli_trie_match((cfgcli_trie_t *) cfg->lopts,
+          arg + 2, olen, &node);
+      if (opt == CFGCLI_TRIE_AMBIGUOUS)
+        return cfgcli_trie_ambiguous(cfg, arg, olen + 2, node);
+      if (opt >= 0) {
+        j = opt >> 1;
+        status = (opt & 1) ? is_func : is_param;
+      }
+    }
+    else {                                      /* parser termination */
+      if (args.depth) {         /* positional arguments must be in `argv` */
+        cfgcli_msg(cfg, "parser termination in response file", arg);
+        return CFGCLI_ERRNO(cfg) = CFGCLI_ERR_CMD;
+      }
+      *optidx = args.idx;               /* the argument after "--" */
+      break;
+    }
+
+    if (status == is_func) {            /* call the command line function */
+      if (optarg) cfgcli_msg(cfg, "omitting command line argument", optarg);
+      if (funcs[j].called)
+        cfgcli_msg(cfg, "the function has already been called with option", arg);
+      else {
+        funcs[j].func(funcs[j].args);   /* call the function */
+        funcs[j].called = 1;
+      }
+    }
+    else if (status == is_param) {      /* assign parameter value */
+      /* Priority check. */
+      if (CFGCLI_SRC_VAL(params[j].src) > prior) continue;
+      else if (CFGCLI_SRC_VAL(params[j].src) == prior) {
+        cfgcli_msg(cfg, "omitting duplicate entry of parameter", params[j].name);
+        continue;
+      }
+      /* Command line arguments can be omitted for bool type variables. */
+      if (!optarg || *optarg == '\0') {
+        if (params[j].dtype == CFGCLI_DTYPE_BOOL) {
+          params[j].value = "T";
+          params[j].vlen = 2;
+        }
+        else {
+          cfgcli_msg(cfg, "argument not found for option", arg);
+          return CFGCLI_ERRNO(cfg) = CFGCLI_ERR_CMD;
+        }
+      }
+      else {
+        params[j].value = optarg;       /* args are surely null terminated */
+        params[j].vlen = strlen(optarg) + 1;    /* safe strlen */
+      }
+      /* Assign value to variable, arguments are valid until destruction. */
+      err = cfgcli_deferring(cfg) ?
+        cfgcli_defer(cfg, params + j, CFGCLI_SRC_OF_OPT(prior), true) :
+        cfgcli_get(cfg, params + j, CFGCLI_SRC_OF_OPT(prior));
+      if (err) return err;
+      params[j].src = CFGCLI_SRC_OF_OPT(prior);
+    }
+    else                                /* option not registered */
+      cfgcli_msg(cfg, "unrecognised command line option", arg);
+  }
+
+  if (err) return err;
+  if (*optidx == 0) *optidx = args.idx;
+  return 0;
+}
+
+/******************************************************************************
+Function `cfgcli_read_stream`:
+  Read configuration parameters from a source, by chunk.
+Arguments:
+  * `cfg`:      entry for the configurations;
+  * `src`:      the source, decompressed into the chunk if necessary;
+  * `prior`:    priority of values read from this source;
+  * `fname`:    name of the file, the base of included files;
+  * `chain`:    the chain of files being read.
+Return:
+  Zero on success; non-zero on error.
+******************************************************************************/
+static int cfgcli_read_stream(cfgcli_t *cfg, cfgcli_source_t *src,
+    const int prior, const char *fname, cfgcli_chain_t *chain) {
+  /* Read file by chunk. */
+  size_t clen = CFGCLI_STR_INIT_SIZE;
+  char *chunk = calloc(clen, sizeof(char));
+  if (!chunk) {
+    cfgcli_msg(cfg, "failed to allocate memory for reading file", fname);
+    return CFGCLI_ERRNO(cfg) = CFGCLI_ERR_MEMORY;
+  }
+
+  size_t nline, nrest, nproc, cnt;
+  char *key, *value;
+  cfgcli_parse_state_t state = CFGCLI_PARSE_START;
+  cfgcli_stream_mode_t smode = CFGCLI_STREAM_NONE;
+  cfgcli_stream_t stream;
+  cfgcli_section_t sec;
+  cfgcli_section_set(cfg, &sec, "");
+  nline = nrest = nproc = 0;
+  key = value = NULL;
+  memset(&stream, 0, sizeof(cfgcli_stream_t));
+
+  while ((cnt = cfgcli_source_read(src, chunk + nrest, clen - nrest))) {
+    char *p = (smode == CFGCLI_STREAM_KEEP) ? chunk + nproc : chunk;
+    char *end = chunk + nrest + cnt;
+    char *endl;
+    if (cnt < clen - nrest) *end++ = '\n';      /* terminate the last line */
+
+    /* Process lines in the chunk. */
+    while ((endl = memchr(p, '\n', end - p))) {
+      *endl = '\0';             /* replace '\n' by '\0' for line parser */
+      nline += 1;
+
+      /* Retrieve the keyword and value from the line. */
+      char msg[CFGCLI_NUM_MAX_SIZE(size_t)];
+      cfgcli_param_valid_t *par;
+      char *seg;
+      int err;
+      cfgcli_parse_return_t status =
+        cfgcli_parse_line(p, endl - p, &key, &value, state);
+
+      switch (status) {
+        case CFGCLI_PARSE_DONE:
+          if (smode == CFGCLI_STREAM_DATA) {
+            /* the last elements are followed by the closing bracket */
+            seg = p + strlen(p);
+            while (seg > p && isspace(seg[-1])) seg--;
+            *(--seg) = '\0';             /* remove the ending ']' */
+            err = cfgcli_stream_push(&stream, p, seg - p, true, prior);
+            if (!err) err = cfgcli_stream_finish(&stream);
+            par = stream.par;
+            cfgcli_stream_free(&stream);
+            if (err) {
+              free(chunk);
+              return cfgcli_get_error(cfg, par, err);
+            }
+            par->src = prior;
+            cfgcli_value_digest(cfg, par, true);
+          }
+          else if (smode != CFGCLI_STREAM_SKIP && (err = cfgcli_read_entry(cfg,
+              cfgcli_section_key(cfg, &sec, key), value, prior, false))) {
+            free(chunk);
+            return err;
+          }
+          /* reset states */
+          key = value = NULL;
+          state = CFGCLI_PARSE_START;
+          smode = CFGCLI_STREAM_NONE;
+          break;
+        case CFGCLI_PARSE_CONTINUE:        /* line continuation */
+          /* elements of the first line start after the '[' */
+          seg = p;
+          if (smode == CFGCLI_STREAM_NONE) {
+            smode = cfgcli_stream_begin(cfg, &stream,
+                cfgcli_section_key(cfg, &sec, key), prior);
+            seg = value + 1;
+          }
+          if (smode == CFGCLI_STREAM_DATA) {
+            /* convert the elements, and drop the line from the chunk */
+            if ((err = cfgcli_stream_push(&stream, seg, endl - seg, false,
+                prior))) {
+              par = stream.par;
+              cfgcli_stream_free(&stream);
+              free(chunk);
+              return cfgcli_get_error(cfg, par, err);
+            }
+          }
+          else *endl = ' ';             /* remove line break */
+          state = CFGCLI_PARSE_ARRAY_START;
+          break;
+        case CFGCLI_PARSE_INCLUDE:
+          if ((err = cfgcli_read_include(cfg, fname, value, prior, chain))) {
+            free(chunk);
+            return err;
+          }
+          key = value = NULL;
+          state = CFGCLI_PARSE_START;
+          break;
+        case CFGCLI_PARSE_SECTION:
+          cfgcli_section_set(cfg, &sec, key);
+          key = value = NULL;
+          state = CFGCLI_PARSE_START;
+          break;
+        case CFGCLI_PARSE_ERROR:
+          sprintf(msg, "%zu", nline);
+          cfgcli_msg(cfg, "invalid configuration entry at line", msg);
+#if __STDC_VERSION__ > 201710L
+          [[fallthrough]];
+#endif
+        case CFGCLI_PARSE_PASS:
+          if (smode == CFGCLI_STREAM_DATA) cfgcli_stream_free(&stream);
+          state = CFGCLI_PARSE_START;
+          smode = CFGCLI_STREAM_NONE;
+          break;
+        default:
+          free(chunk);
+          sprintf(msg, "%d", status);
+          cfgcli_msg(cfg, "unknown line parser status", msg);
+          return CFGCLI_ERRNO(cfg) = CFGCLI_ERR_UNKNOWN;
+      }
+      p = endl + 1;
+    }
+
+    /* The chunk cannot hold a full line. */
+    if (p == chunk) {
+      size_t new_len = 0;
+      if (clen >= CFGCLI_STR_MAX_DOUBLE_SIZE) {
+        if (SIZE_MAX - CFGCLI_STR_MAX_DOUBLE_SIZE >= clen)
+          new_len = clen + CFGCLI_STR_MAX_DOUBLE_SIZE;
+      }
+      else if (SIZE_MAX / 2 >= clen) new_len = clen << 1;
+      if (!new_len) {                   /* overflow occurred */
+        cfgcli_msg(cfg, "failed to allocate memory for reading the file", fname);
+        return CFGCLI_ERRNO(cfg) = CFGCLI_ERR_MEMORY;
+      }
+      char *tmp = realloc(chunk, new_len);
+      if (!tmp) {
+        cfgcli_msg(cfg, "failed to allocate memory for reading the file", fname);
+        return CFGCLI_ERRNO(cfg) = CFGCLI_ERR_MEMORY;
+      }
+      chunk = tmp;
+      clen = new_len;
+      nrest += cnt;
+      continue;
+    }
+
+    /* Copy the remaining characters to the beginning of the chunk. */
+    if (smode == CFGCLI_STREAM_KEEP) {             /* copy also parsed part */
+      if (!key) {
+        free(chunk);
+        cfgcli_msg(cfg, "unknown parser interruption", NULL);
+        return CFGCLI_ERRNO(cfg) = CFGCLI_ERR_UNKNOWN;
+      }
+      /* `key` is the starting point of this effective line */
+      nrest = end - key;
+      nproc = p - key;
+      memmove(chunk, key, nrest);
+      /* shift `key` and `value` */
+      if (value) value -= key - chunk;
+      key = chunk;
+    }
+    else {                      /* copy only from the current position */
+      nrest = end - p;
+      memmove(chunk, p, nrest);
+    }
+
+    /* The chunk is full. */
+    if (nrest == clen) {
+      size_t new_len = 0;
+      if (clen >= CFGCLI_STR_MAX_DOUBLE_SIZE) {
+        if (SIZE_MAX - CFGCLI_STR_MAX_DOUBLE_SIZE >= clen)
+          new_len = clen + CFGCLI_STR_MAX_DOUBLE_SIZE;
+      }
+      else if (SIZE_MAX / 2 >= clen) new_len = clen << 1;
+      if (!new_len) {
+        cfgcli_msg(cfg, "failed to allocate memory for reading the file", fname);
+        return CFGCLI_ERRNO(cfg) = CFGCLI_ERR_MEMORY;
+      }
+      size_t key_shift = key ? key - chunk : 0;
+      size_t value_shift = value ? value - chunk : 0;
+      char *tmp = realloc(chunk, new_len);
+      if (!tmp) {
+        cfgcli_msg(cfg, "failed to allocate memory for reading the file", fname);
+        return CFGCLI_ERRNO(cfg) = CFGCLI_ERR_MEMORY;
+      }
+      chunk = tmp;
+      clen = new_len;
+      if (key) key = chunk + key_shift;
+      if (value) value = chunk + value_shift;
+    }
+  }
+
+  if (smode == CFGCLI_STREAM_DATA) cfgcli_stream_free(&stream);
+  if (!src->eof) {
+    cfgcli_msg(cfg, (src->codec == CFGCLI_CODEC_NONE) ?
+        "unexpected end of file" : "corrupted or truncated compressed file",
+        fname);
+    free(chunk);
+    return CFGCLI_ERRNO(cfg) = CFGCLI_ERR_FILE;
+  }
+
+  free(chunk);
+  return 0;
+}
+
+/******************************************************************************
+Function `cfgcli_read_file`:
+  Read configuration parameters from a file.
+Arguments:
+  * `cfg`:      entry for the configurations;
+  * `fname`:    name of the input file;
+  * `prior`:    priority of values read from this file.
+Return:
+  Zero on success; non-zero on error.
+******************************************************************************/
+int cfgcli_read_file(cfgcli_t *cfg, const char *fname, const int prior) {
+  /* Validate function arguments. */
+  if (!cfg) return CFGCLI_ERR_INIT;
+  if (CFGCLI_IS_ERROR(cfg)) return CFGCLI_ERRNO(cfg);
+  if (cfg->npar <= 0) {
+    cfgcli_msg(cfg, "no parameter has been registered", NULL);
+    return CFGCLI_ERRNO(cfg) = CFGCLI_ERR_INIT;
+  }
+  if (!fname || *fname == '\0') {
+    cfgcli_msg(cfg, "the input configuration file is not set", NULL);
+    return CFGCLI_ERRNO(cfg) = CFGCLI_ERR_INPUT;
+  }
+  if (!(cfgcli_strnlen(fname, CFGCLI_MAX_FILENAME_LEN))) {
+    cfgcli_msg(cfg, "invalid filename of the configuration file", NULL);
+    return CFGCLI_ERRNO(cfg) = CFGCLI_ERR_INPUT;
+  }
+  if (prior <= CFGCLI_SRC_NULL) {
+    cfgcli_msg(cfg, "invalid priority for configuration file", fname);
+    return CFGCLI_ERRNO(cfg) = CFGCLI_ERR_INPUT;
+  }
+
+  FILE *fp = fopen(fname, "r");
+  if (!fp) {
+    cfgcli_msg(cfg, "cannot open the configuration file", fname);
+    return CFGCLI_ERRNO(cfg) = CFGCLI_ERR_FILE;
+  }
+
+  /* Record the file for detecting recursive inclusions. */
+  struct stat st;
+  cfgcli_chain_t chain;
+  chain.depth = 0;
+  if (!fstat(fileno(fp), &st)) {
+    chain.dev[0] = st.st_dev;
+    chain.ino[0] = st.st_ino;
+    chain.depth = 1;
+  }
+
+  /* Compressed files are decompressed while they are parsed. */
+  cfgcli_source_t src;
+  int err = cfgcli_source_init(cfg, &src, fp, NULL, 0, fname);
+  if (!err) err = cfgcli_read_stream(cfg, &src, prior, fname, &chain);
+  cfgcli_source_close(&src);
+  fclose(fp);
+  return err;
+}
+
+
+/******************************************************************************
+Function `cfgcli_read_lines`:
+  Read configuration parameters from the lines of a buffer, in place.
+Arguments:
+  * `cfg`:      entry for the configurations;
+  * `buf`:      the buffer, parsed until `len` characters or the first '\0';
+  * `len`:      length of the buffer;
+  * `prior`:    priority of values read from this buffer;
+  * `fname`:    name of the file in the buffer, NULL for the working
+                directory as the base of included files;
+  * `chain`:    the chain of files being read;
+  * `resident`: true if the buffer is valid until the entry is destroyed.
+Return:
+  Zero on success; non-zero on error.
+******************************************************************************/
+static int cfgcli_read_lines(cfgcli_t *cfg, char *buf, const size_t len,
+    const int prior, const char *fname, cfgcli_chain_t *chain,
+    const bool resident) {
+  char *end = memchr(buf, '\0', len);
+  bool terminated = (end != NULL);
+  if (!end) end = buf + len;
+
+  size_t nline = 0;
+  char *p, *key, *value;
+  cfgcli_parse_state_t state = CFGCLI_PARSE_START;
+  cfgcli_section_t sec;
+  cfgcli_section_set(cfg, &sec, "");
+  key = value = NULL;
+
+  /* Process lines in place. */
+  for (p = buf; p < end; ) {
+    char *endl = memchr(p, '\n', end - p);
+    if (endl) *endl = '\0';            /* replace '\n' by '\0' for line parser */
+    else if (terminated) endl = end;
+    else {
+      /* Continue with a terminated copy of the last effective line. */
+      char *from = (state == CFGCLI_PARSE_ARRAY_START) ? key : p;
+      char *copy = cfgcli_keep(cfg, end - from + 1);
+      if (!copy) {
+        cfgcli_msg(cfg, "failed to allocate memory for reading the buffer",
+            NULL);
+        return CFGCLI_ERRNO(cfg) = CFGCLI_ERR_MEMORY;
+      }
+      memcpy(copy, from, end - from);
+      if (state == CFGCLI_PARSE_ARRAY_START) {
+        if (value) value = copy + (value - from);
+        key = copy;
+      }
+      p = copy + (p - from);
+      endl = end = copy + (end - from);
+      *end = '\0';
+      terminated = true;
+    }
+    nline += 1;
+
+    char msg[CFGCLI_NUM_MAX_SIZE(size_t)];
+    int err;
+    cfgcli_parse_return_t status =
+      cfgcli_parse_line(p, endl - p, &key, &value, state);
+
+    switch (status) {
+      case CFGCLI_PARSE_DONE:
+        if ((err = cfgcli_read_entry(cfg, cfgcli_section_key(cfg, &sec, key),
+            value, prior, resident))) return err;
+        key = value = NULL;
+        state = CFGCLI_PARSE_START;
+        break;
+      case CFGCLI_PARSE_CONTINUE:          /* line continuation */
+        if (endl < end) *endl = ' ';    /* remove line break */
+        state = CFGCLI_PARSE_ARRAY_START;
+        break;
+      case CFGCLI_PARSE_INCLUDE:           /* relative to the file */
+        if ((err = cfgcli_read_include(cfg, fname, value, prior, chain)))
+          return err;
+        key = value = NULL;
+        state = CFGCLI_PARSE_START;
+        break;
+      case CFGCLI_PARSE_SECTION:
+        cfgcli_section_set(cfg, &sec, key);
+        key = value = NULL;
+        state = CFGCLI_PARSE_START;
+        break;
+      case CFGCLI_PARSE_ERROR:
+        sprintf(msg, "%zu", nline);
+        cfgcli_msg(cfg, "invalid configuration entry at line", msg);
+#if __STDC_VERSION__ > 201710L
+        [[fallthrough]];
+#endif
+      case CFGCLI_PARSE_PASS:
+        state = CFGCLI_PARSE_START;
+        break;
+      default:
+        sprintf(msg, "%d", status);
+        cfgcli_msg(cfg, "unknown line parser status", msg);
+        return CFGCLI_ERRNO(cfg) = CFGCLI_ERR_UNKNOWN;
+    }
+    p = endl + 1;
+  }
+
+  return 0;
+}
+
+/******************************************************************************
+Function `cfgcli_read_buffer`:
+  Read configuration parameters from a resident buffer, with the format of
+  configuration files.
+Arguments:
+  * `cfg`:      entry for the configurations;
+  * `buf`:      the buffer, parsed until `len` characters or the first '\0';
+  * `len`:      length of the buffer;
+  * `prior`:    priority of values read from this buffer.
+Return:
+  Zero on success; non-zero on error.
+******************************************************************************/
+int cfgcli_read_buffer(cfgcli_t *cfg, char *buf, const size_t len,
+    const int prior) {
+  /* Validate function arguments. */
+  if (!cfg) return CFGCLI_ERR_INIT;
+  if (CFGCLI_IS_ERROR(cfg)) return CFGCLI_ERRNO(cfg);
+  if (cfg->npar <= 0) {
+    cfgcli_msg(cfg, "no parameter has been registered", NULL);
+    return CFGCLI_ERRNO(cfg) = CFGCLI_ERR_INIT;
+  }
+  if (!buf) {
+    cfgcli_msg(cfg, "the input configuration buffer is not set", NULL);
+    return CFGCLI_ERRNO(cfg) = CFGCLI_ERR_INPUT;
+  }
+  if (prior <= CFGCLI_SRC_NULL) {
+    cfgcli_msg(cfg, "invalid priority for configuration buffer", NULL);
+    return CFGCLI_ERRNO(cfg) = CFGCLI_ERR_INPUT;
+  }
+
+  cfgcli_chain_t chain;
+  chain.depth = 0;
+  return cfgcli_read_lines(cfg, buf, len, prior, NULL, &chain, true);
+}
+
+
+/*============================================================================*\
+            Functions for loading configuration files asynchronously
+\*============================================================================*/
+
+#ifdef HAVE_IO_URING
+/******************************************************************************
+Function `cfgcli_ring_free`:
+  Unmap and close the rings of io_uring.
+Arguments:
+  * `ring`:     the rings.
+******************************************************************************/
+static void cfgcli_ring_free(cfgcli_ring_t *ring) {
+  if (ring->sqes) munmap(ring->sqes, ring->sqe_len);
+  if (ring->cq_ptr && ring->cq_ptr != ring->sq_ptr)
+    munmap(ring->cq_ptr, ring->cq_len);
+  if (ring->sq_ptr) munmap(ring->sq_ptr, ring->sq_len);
+  if (ring->fd >= 0) close(ring->fd);
+  memset(ring, 0, sizeof(cfgcli_ring_t));
+  ring->fd = -1;
+}
+
+/******************************************************************************
+Function `cfgcli_ring_init`:
+  Set up io_uring with raw system calls, and check that asynchronous opens
+  and reads are supported.
+Arguments:
+  * `ring`:     the rings;
+  * `entries`:  number of submission queue entries.
+Return:
+  Zero on success; -1 if io_uring is unavailable.
+******************************************************************************/
+static int cfgcli_ring_init(cfgcli_ring_t *ring, const unsigned entries) {
+  struct io_uring_params p;
+  memset(&p, 0, sizeof p);
+  memset(ring, 0, sizeof(cfgcli_ring_t));
+  if ((ring->fd = syscall(__NR_io_uring_setup, entries, &p)) < 0) {
+    ring->fd = -1;
+    return -1;
+  }
+
+  /* Map the rings, which may share a single mapping. */
+  ring->sq_len = p.sq_off.array + p.sq_entries * sizeof(unsigned);
+  ring->cq_len = p.cq_off.cqes + p.cq_entries * sizeof(struct io_uring_cqe);
+  if ((p.features & IORING_FEAT_SINGLE_MMAP) && ring->cq_len > ring->sq_len)
+    ring->sq_len = ring->cq_len;
+  ring->sq_ptr = mmap(NULL, ring->sq_len, PROT_READ | PROT_WRITE,
+      MAP_SHARED | MAP_POPULATE, ring->fd, IORING_OFF_SQ_RING);
+  if (ring->sq_ptr == MAP_FAILED) {
+    ring->sq_ptr = NULL;
+    cfgcli_ring_free(ring);
+    return -1;
+  }
+  if (p.features & IORING_FEAT_SINGLE_MMAP) ring->cq_ptr = ring->sq_ptr;
+  else {
+    ring->cq_ptr = mmap(NULL, ring->cq_len, PROT_READ | PROT_WRITE,
+        MAP_SHARED | MAP_POPULATE, ring->fd, IORING_OFF_CQ_RING);
+    if (ring->cq_ptr == MAP_FAILED) {
+      ring->cq_ptr = NULL;
+      cfgcli_ring_free(ring);
+      return -1;
+    }
+  }
+  ring->sqe_len = p.sq_entries * sizeof(struct io_uring_sqe);
+  ring->sqes = mmap(NULL, ring->sqe_len, PROT_READ | PROT_WRITE,
+      MAP_SHARED | MAP_POPULATE, ring->fd, IORING_OFF_SQES);
+  if (ring->sqes == MAP_FAILED) {
+    ring->sqes = NULL;
+    cfgcli_ring_free(ring);
+    return -1;
+  }
+
+  ring->entries = p.sq_entries;
+  ring->sq_head = (unsigned *) ((char *) ring->sq_ptr + p.sq_off.head);
+  ring->sq_tail = (unsigned *) ((char *) ring->sq_ptr + p.sq_off.tail);
+  ring->sq_mask = (unsigned *) ((char *) ring->sq_ptr + p.sq_off.ring_mask);
+  ring->sq_array = (unsigned *) ((char *) ring->sq_ptr + p.sq_off.array);
+  ring->cq_head = (unsigned *) ((char *) ring->cq_ptr + p.cq_off.head);
+  ring->cq_tail = (unsigned *) ((char *) ring->cq_ptr + p.cq_off.tail);
+  ring->cq_mask = (unsigned *) ((char *) ring->cq_ptr + p.cq_off.ring_mask);
+  ring->cqes = (struct io_uring_cqe *) ((char *) ring->cq_ptr + p.cq_off.cqes);
+
+  /* Opening and reading files are supported since Linux 5.6. */
+  const size_t nop = IORING_OP_READ + 1;
+  struct io_uring_probe *probe = calloc(1, sizeof(struct io_uring_probe) +
+      nop * sizeof(struct io_uring_probe_op));
+  if (!probe || syscall(__NR_io_uring_register, ring->fd,
+      IORING_REGISTER_PROBE, probe, nop) < 0 ||
+      probe->last_op < IORING_OP_READ ||
+      !(probe->ops[IORING_OP_OPENAT].flags & IO_URING_OP_SUPPORTED) ||
+      !(probe->ops[IORING_OP_READ].flags & IO_URING_OP_SUPPORTED)) {
+    free(probe);
+    cfgcli_ring_free(ring);
+    return -1;
+  }
+  free(probe);
+  return 0;
+}
+
+/******************************************************************************
+Function `cfgcli_ring_enter`:
+  Submit the queued operations, and wait for a completion if required.
+Arguments:
+  * `ring`:     the rings;
+  * `submit`:   number of queued operations;
+  * `wait`:     true for waiting for at least one completion.
+Return:
+  Zero on success; -1 on error.
+******************************************************************************/
+static int cfgcli_ring_enter(cfgcli_ring_t *ring, const unsigned submit,
+    const bool wait) {
+  if (!submit && !wait) return 0;
+  /* Only interrupted waits and temporary shortages of resources are
+     retried, a limited number of times. */
+  for (int i = 0; i < CFGCLI_LOAD_MAX_RETRY; i++) {
+    if (syscall(__NR_io_uring_enter, ring->fd, submit, wait ? 1 : 0,
+        wait ? IORING_ENTER_GETEVENTS : 0, NULL, 0) >= 0) return 0;
+    if (errno != EINTR && errno != EAGAIN && errno != EBUSY) break;
+  }
+  return -1;
+}
+#endif
+
+/******************************************************************************
+Function `cfgcli_load_close`:
+  Close a file, if it is opened.
+Arguments:
+  * `f`:        the file.
+******************************************************************************/
+static void cfgcli_load_close(cfgcli_load_file_t *f) {
+  if (f->fp) fclose(f->fp);     /* the descriptor is owned by the stream */
+#ifdef HAVE_PREAD
+  else if (f->fd >= 0) close(f->fd);
+#endif
+  f->fp = NULL;
+  f->fd = -1;
+}
+
+/******************************************************************************
+Function `cfgcli_load_opened`:
+  Prepare the buffer for a file that is opened.
+Arguments:
+  * `f`:        the file;
+  * `fd`:       the file descriptor, negative if the file is not opened.
+Return:
+  True if the file has to be read; false otherwise.
+******************************************************************************/
+static bool cfgcli_load_opened(cfgcli_load_file_t *f, const int fd) {
+  if (fd < 0) {
+    f->fail = "cannot open the configuration file";
+    f->state = CFGCLI_LOAD_FAIL;
+    return false;
+  }
+  f->fd = fd;
+
+  /* Regular files are read at once, and others by growing chunks. */
+  struct stat st;
+  f->size = CFGCLI_STR_INIT_SIZE;
+  if (!fstat(fd, &st)) {
+    f->dev = st.st_dev;
+    f->ino = st.st_ino;
+    if (S_ISREG(st.st_mode) && st.st_size > 0) {
+      f->regular = true;
+      f->size = st.st_size;
+    }
+  }
+  if (!(f->buf = malloc(f->size + 1))) {
+    f->fail = "failed to allocate memory for reading file";
+    f->state = CFGCLI_LOAD_FAIL;
+    return false;
+  }
+  f->state = CFGCLI_LOAD_READ;
+  return true;
+}
+
+/******************************************************************************
+Function `cfgcli_load_read`:
+  Record the bytes read from a file.
+Arguments:
+  * `f`:        the file;
+  * `res`:      number of bytes read, negative on error.
+Return:
+  True if the file has to be read further; false otherwise.
+******************************************************************************/
+static bool cfgcli_load_read(cfgcli_load_file_t *f, const long res) {
+  if (res < 0) {
+    f->fail = "failed to read the configuration file";
+    f->state = CFGCLI_LOAD_FAIL;
+    return false;
+  }
+  f->len += res;
+  if (f->len == f->size && res && !f->regular) {
+    char *buf;
+    size_t size = cfgcli_grow_size(f->size, f->size + 1);
+    if (!size || !(buf = realloc(f->buf, size + 1))) {
+      f->fail = "failed to allocate memory for reading file";
+      f->state = CFGCLI_LOAD_FAIL;
+      return false;
+    }
+    f->buf = buf;
+    f->size = size;
+  }
+  /* A regular file is complete once its size is reached. */
+  if (res && f->len < f->size) return true;
+  f->buf[f->len] = '\0';
+  cfgcli_load_close(f);
+  f->state = CFGCLI_LOAD_DONE;
+  return false;
+}
+
+/******************************************************************************
+Function `cfgcli_load_chunk`:
+  Number of bytes to be requested by the next read of a file.
+Arguments:
+  * `f`:        the file.
+Return:
+  The number of bytes.
+******************************************************************************/
+static inline size_t cfgcli_load_chunk(const cfgcli_load_file_t *f) {
+  const size_t n = f->size - f->len;
+  return (n > CFGCLI_LOAD_MAX_READ) ? CFGCLI_LOAD_MAX_READ : n;
+}
+
+#ifdef HAVE_IO_URING
+/******************************************************************************
+Function `cfgcli_load_queue`:
+  Queue the open or the next read of a file in the submission queue.
+Arguments:
+  * `ld`:       the loader;
+  * `i`:        index of the file.
+Return:
+  Zero on success; -1 if the queue is full.
+******************************************************************************/
+static int cfgcli_load_queue(cfgcli_loader_t *ld, const int i) {
+  cfgcli_ring_t *ring = &ld->ring;
+  const unsigned tail = *ring->sq_tail;
+  if (tail - __atomic_load_n(ring->sq_head, __ATOMIC_ACQUIRE) >= ring->entries)
+    return -1;
+
+  const unsigned idx = tail & *ring->sq_mask;
+  struct io_uring_sqe *sqe = ring->sqes + idx;
+  cfgcli_load_file_t *f = ld->file + i;
+  memset(sqe, 0, sizeof(struct io_uring_sqe));
+  if (f->state == CFGCLI_LOAD_OPEN) {
+    sqe->opcode = IORING_OP_OPENAT;
+    sqe->fd = AT_FDCWD;
+    sqe->addr = (uintptr_t) f->fname;
+    sqe->open_flags = O_RDONLY | O_CLOEXEC;
+  }
+  else {
+    sqe->opcode = IORING_OP_READ;
+    sqe->fd = f->fd;
+    sqe->addr = (uintptr_t) (f->buf + f->len);
+    sqe->len = cfgcli_load_chunk(f);
+    sqe->off = f->len;
+  }
+  sqe->user_data = i;
+  ring->sq_array[idx] = idx;
+  __atomic_store_n(ring->sq_tail, tail + 1, __ATOMIC_RELEASE);
+  ld->inflight += 1;
+  ld->queued += 1;
+  return 0;
+}
+
+/******************************************************************************
+Function `cfgcli_load_reap`:
+  Process the completed operations, and queue the following reads.
+Arguments:
+  * `ld`:       the loader.
+Return:
+  Zero on success; -1 if the submission queue is full.
+******************************************************************************/
+static int cfgcli_load_reap(cfgcli_loader_t *ld) {
+  cfgcli_ring_t *ring = &ld->ring;
+  unsigned head = *ring->cq_head;
+  const unsigned tail = __atomic_load_n(ring->cq_tail, __ATOMIC_ACQUIRE);
+  int err = 0;
+  for (; head != tail; head++) {
+    const struct io_uring_cqe *cqe = ring->cqes + (head & *ring->cq_mask);
+    cfgcli_load_file_t *f = ld->file + cqe->user_data;
+    const bool more = (f->state == CFGCLI_LOAD_OPEN) ?
+      cfgcli_load_opened(f, cqe->res) : cfgcli_load_read(f, cqe->res);
+    ld->inflight -= 1;
+    if (more && cfgcli_load_queue(ld, cqe->user_data)) err = -1;
+  }
+  __atomic_store_n(ring->cq_head, head, __ATOMIC_RELEASE);
+  return err;
+}
+#endif
+
+/******************************************************************************
+Function `cfgcli_load_blocking`:
+  Open and read a file with blocking calls, or with stdio if `pread` is not
+  available.
+Arguments:
+  * `f`:        the file.
+******************************************************************************/
+static void cfgcli_load_blocking(cfgcli_load_file_t *f) {
+#ifdef HAVE_PREAD
+  if (!cfgcli_load_opened(f, open(f->fname, O_RDONLY | O_CLOEXEC))) return;
+  while (cfgcli_load_read(f, pread(f->fd, f->buf + f->len,
+      cfgcli_load_chunk(f), f->len)));
+#else
+  f->fp = fopen(f->fname, "r");
+  if (!cfgcli_load_opened(f, f->fp ? fileno(f->fp) : -1)) return;
+  for (;;) {
+    const size_t n = fread(f->buf + f->len, sizeof(char), cfgcli_load_chunk(f),
+        f->fp);
+    if (!cfgcli_load_read(f, (n || !ferror(f->fp)) ? (long) n : -1)) break;
+  }
+#endif
+}
+
+/******************************************************************************
+Function `cfgcli_load_parse`:
+  Parse the files that are read completely, in the order of the file names.
+Arguments:
+  * `ld`:       the loader.
+Return:
+  Zero on success; non-zero on error.
+******************************************************************************/
+static int cfgcli_load_parse(cfgcli_loader_t *ld) {
+  cfgcli_t *cfg = ld->cfg;
+  while (ld->next < ld->nfile) {
+    cfgcli_load_file_t *f = ld->file + ld->next;
+    if (f->state == CFGCLI_LOAD_FAIL) {
+      cfgcli_msg(cfg, f->fail, f->fname);
+      return CFGCLI_ERRNO(cfg) = CFGCLI_ERR_FILE;
+    }
+    if (f->state != CFGCLI_LOAD_DONE) return 0;
+
+    /* Record the file for detecting recursive inclusions. */
+    cfgcli_chain_t chain;
+    chain.depth = 1;
+    chain.dev[0] = f->dev;
+    chain.ino[0] = f->ino;
+    /* Compressed files are decompressed by chunk while they are parsed. */
+    cfgcli_source_t src;
+    int err;
+    if (cfgcli_source_codec((unsigned char *) f->buf, f->len) ==
+        CFGCLI_CODEC_NONE)
+      err = cfgcli_read_lines(cfg, f->buf, f->len + 1, f->prior, f->fname,
+          &chain, false);
+    else if (!(err = cfgcli_source_init(cfg, &src, NULL, f->buf, f->len,
+        f->fname))) {
+      err = cfgcli_read_stream(cfg, &src, f->prior, f->fname, &chain);
+      cfgcli_source_close(&src);
+    }
+    free(f->buf);
+    f->buf = NULL;
+    f->state = CFGCLI_LOAD_PARSED;
+    ld->next += 1;
+    if (err) return err;
+  }
+  return 0;
+}
+
+/******************************************************************************
+Function `cfgcli_load_files`:
+  Start reading configuration files asynchronously.
+Arguments:
+  * `cfg`:      entry for the configurations;
+  * `fname`:    names of the input files;
+  * `prior`:    priorities of values read from the files;
+  * `nfile`:    number of files.
+Return:
+  The loader on success; NULL on error.
+******************************************************************************/
+cfgcli_loader_t *cfgcli_load_files(cfgcli_t *cfg, const char *const *fname,
+    const int *prior, const int nfile) {
+  /* Validate function arguments. */
+  if (!cfg || CFGCLI_IS_ERROR(cfg)) return NULL;
+  if (cfg->npar <= 0) {
+    cfgcli_msg(cfg, "no parameter has been registered", NULL);
+    CFGCLI_ERRNO(cfg) = CFGCLI_ERR_INIT;
+    return NULL;
+  }
+  if (!fname || !prior || nfile <= 0) {
+    cfgcli_msg(cfg, "the input configuration files are not set", NULL);
+    CFGCLI_ERRNO(cfg) = CFGCLI_ERR_INPUT;
+    return NULL;
+  }
+
+  size_t nlen = 0;
+  for (int i = 0; i < nfile; i++) {
+    size_t len;
+    if (!fname[i] || !(len = cfgcli_strnlen(fname[i],
+        CFGCLI_MAX_FILENAME_LEN))) {
+      cfgcli_msg(cfg, "invalid filename of the configuration file", NULL);
+      CFGCLI_ERRNO(cfg) = CFGCLI_ERR_INPUT;
+      return NULL;
+    }
+    if (prior[i] <= CFGCLI_SRC_NULL) {
+      cfgcli_msg(cfg, "invalid priority for configuration file", fname[i]);
+      CFGCLI_ERRNO(cfg) = CFGCLI_ERR_INPUT;
+      return NULL;
+    }
+    nlen += len + 1;
+  }
+
+  /* The file names are copied after the files. */
+  cfgcli_loader_t *ld = calloc(1, sizeof(cfgcli_loader_t));
+  if (ld) ld->file = malloc(nfile * sizeof(cfgcli_load_file_t) + nlen);
+  if (!ld || !ld->file) {
+    free(ld);
+    cfgcli_msg(cfg, "failed to allocate memory for loading files", NULL);
+    CFGCLI_ERRNO(cfg) = CFGCLI_ERR_MEMORY;
+    return NULL;
+  }
+  ld->cfg = cfg;
+  ld->nfile = nfile;
+  char *names = (char *) (ld->file + nfile);
+  for (int i = 0; i < nfile; i++) {
+    cfgcli_load_file_t *f = ld->file + i;
+    memset(f, 0, sizeof(cfgcli_load_file_t));
+    f->state = CFGCLI_LOAD_OPEN;
+    f->prior = prior[i];
+    f->fd = -1;
+    f->fname = names;
+    const size_t len = strlen(fname[i]) + 1;
+    memcpy(names, fname[i], len);
+    names += len;
+  }
+
+#ifdef HAVE_IO_URING
+  /* Submit the opens of all files in one batch, as the ring allows. */
+  unsigned entries = 1;
+  while (entries < (unsigned) nfile && entries < CFGCLI_LOAD_MAX_RING)
+    entries <<= 1;
+  if (!cfgcli_ring_init(&ld->ring, entries)) {
+    while (ld->nopen < nfile && !cfgcli_load_queue(ld, ld->nopen))
+      ld->nopen += 1;
+    if (cfgcli_ring_enter(&ld->ring, ld->queued, false)) {
+      cfgcli_load_free(ld);
+      cfgcli_msg(cfg, "failed to submit reads of configuration files", NULL);
+      CFGCLI_ERRNO(cfg) = CFGCLI_ERR_FILE;
+      return NULL;
+    }
+    ld->queued = 0;
+  }
+#endif
+  return ld;
+}
+
+/******************************************************************************
+Function `cfgcli_load_fd`:
+  Get the file descriptor that is readable when the loader can make progress.
+Arguments:
+  * `ld`:       the loader.
+Return:
+  The file descriptor; -1 if files are read with blocking calls.
+******************************************************************************/
+int cfgcli_load_fd(const cfgcli_loader_t *ld) {
+#ifdef HAVE_IO_URING
+  if (ld) return ld->ring.fd;
+#else
+  (void) ld;
+#endif
+  return -1;
+}
+
+/******************************************************************************
+Function `cfgcli_load_poll`:
+  Process completed reads, and parse the files that are read completely.
+Arguments:
+  * `ld`:       the loader;
+  * `wait`:     true for waiting until all files are parsed.
+Return:
+  Number of files not parsed yet; negative error code on error.
+******************************************************************************/
+int cfgcli_load_poll(cfgcli_loader_t *ld, const bool wait) {
+  if (!ld) return CFGCLI_ERR_INIT;
+  cfgcli_t *cfg = ld->cfg;
+  if (CFGCLI_IS_ERROR(cfg)) return CFGCLI_ERRNO(cfg);
+  int err;
+
+#ifdef HAVE_IO_URING
+  if (ld->ring.fd >= 0) {
+    for (;;) {
+      /* Parse completed files while the other reads are in flight. */
+      if (cfgcli_load_reap(ld)) {
+        cfgcli_msg(cfg, "too many reads of configuration files", NULL);
+        return CFGCLI_ERRNO(cfg) = CFGCLI_ERR_UNKNOWN;
+      }
+      if ((err = cfgcli_load_parse(ld))) return err;
+      if (ld->next == ld->nfile) return 0;
+
+      while (ld->nopen < ld->nfile && ld->inflight < (int) ld->ring.entries &&
+          !cfgcli_load_queue(ld, ld->nopen)) ld->nopen += 1;
+      if (wait && ld->inflight <= 0) {
+        cfgcli_msg(cfg, "no pending reads of configuration files", NULL);
+        return CFGCLI_ERRNO(cfg) = CFGCLI_ERR_UNKNOWN;
+      }
+      if (cfgcli_ring_enter(&ld->ring, ld->queued, wait)) {
+        cfgcli_msg(cfg, "failed to submit reads of configuration files", NULL);
+        return CFGCLI_ERRNO(cfg) = CFGCLI_ERR_FILE;
+      }
+      ld->queued = 0;
+      if (!wait) return ld->nfile - ld->next;
+    }
+  }
+#endif
+
+  /* Blocking fallback: files are read one by one, then parsed, and only
+     one file is processed per call without `wait`. */
+  while (ld->next < ld->nfile) {
+    cfgcli_load_blocking(ld->file + ld->next);
+    if ((err = cfgcli_load_parse(ld))) return err;
+    if (!wait) break;
+  }
+  return ld->nfile - ld->next;
+}
+
+/******************************************************************************
+Function `cfgcli_load_free`:
+  Wait for outstanding reads, and release the loader.
+Arguments:
+  * `ld`:       the loader.
+******************************************************************************/
+void cfgcli_load_free(cfgcli_loader_t *ld) {
+  if (!ld) return;
+#ifdef HAVE_IO_URING
+  if (ld->ring.fd >= 0) {
+    /* The kernel may still write to the buffers and open files. */
+    while (ld->inflight > 0) {
+      if (cfgcli_ring_enter(&ld->ring, ld->queued, true)) break;
+      ld->queued = 0;
+      cfgcli_ring_t *ring = &ld->ring;
+      unsigned head = *ring->cq_head;
+      const unsigned tail = __atomic_load_n(ring->cq_tail, __ATOMIC_ACQUIRE);
+      for (; head != tail; head++) {
+        const struct io_uring_cqe *cqe = ring->cqes + (head & *ring->cq_mask);
+        cfgcli_load_file_t *f = ld->file + cqe->user_data;
+        if (f->state == CFGCLI_LOAD_OPEN && cqe->res >= 0) close(cqe->res);
+        ld->inflight -= 1;
+      }
+      __atomic_store_n(ring->cq_head, head, __ATOMIC_RELEASE);
+    }
+    cfgcli_ring_free(&ld->ring);
+  }
+#endif
+  for (int i = 0; i < ld->nfile; i++) {
+    cfgcli_load_close(ld->file + i);
+    free(ld->file[i].buf);
+  }
+  free(ld->file);
+  free(ld);
+}
+
+/******************************************************************************
+Function `cfgcli_read_files`:
+  Read configuration parameters from multiple files concurrently.
+Arguments:
+  * `cfg`:      entry for the configurations;
+  * `fname`:    names of the input files;
+  * `prior`:    priorities of values read from the files;
+  * `nfile`:    number of files.
+Return:
+  Zero on success; non-zero on error.
+******************************************************************************/
+int cfgcli_read_files(cfgcli_t *cfg, const char *const *fname,
+    const int *prior, const int nfile) {
+  if (!cfg) return CFGCLI_ERR_INIT;
+  cfgcli_loader_t *ld = cfgcli_load_files(cfg, fname, prior, nfile);
+  if (!ld) return CFGCLI_ERRNO(cfg);
+  const int err = cfgcli_load_poll(ld, true);
+  cfgcli_load_free(ld);
+  return (err < 0) ? err : 0;
+}
+
+
+/*============================================================================*\
+                 Functions for reading environment variables
+\*============================================================================*/
+
+/******************************************************************************
+Function `cfgcli_env_free`:
+  Release memory allocated for the table of environment variable names.
+Arguments:
+  * `env`:      the table of environment variable names.
+******************************************************************************/
+static void cfgcli_env_free(cfgcli_env_t *env) {
+  free(env->slot);
+  free(env->hash);
+  free(env->name);
+}
+
+/******************************************************************************
+Function `cfgcli_env_build`:
+  Build the table of environment variable names for all parameters, i.e.,
+  the names in upper case, with '.' and '-' replaced by `CFGCLI_ENV_SEP`.
+Arguments:
+  * `cfg`:      entry for the configurations;
+  * `env`:      the table to be built.
+Return:
+  Zero on success; non-zero on error.
+******************************************************************************/
+static int cfgcli_env_build(cfgcli_t *cfg, cfgcli_env_t *env) {
+  cfgcli_param_valid_t *params = (cfgcli_param_valid_t *) cfg->params;
+  for (env->nslot = 2; env->nslot < (size_t) cfg->npar * 2; env->nslot <<= 1);
+  env->slot = calloc(env->nslot, sizeof(int));
+  env->hash = malloc(cfg->npar * sizeof(uint64_t));
+  env->name = malloc((size_t) cfg->npar * CFGCLI_MAX_NAME_LEN);
+  if (!env->slot || !env->hash || !env->name) {
+    cfgcli_env_free(env);
+    return CFGCLI_ERR_MEMORY;
+  }
+
+  for (int j = 0; j < cfg->npar; j++) {
+    char *name = env->name + (size_t) j * CFGCLI_MAX_NAME_LEN;
+    const size_t len = params[j].nlen - 1;
+    for (size_t k = 0; k < len; k++) {
+      const char c = params[j].name[k];
+      name[k] = (c == CFGCLI_SYM_SECTION_SEP || c == '-') ?
+        CFGCLI_ENV_SEP : toupper(c);
+    }
+    env->hash[j] = cfgcli_hash(name, len);
+
+    size_t i;
+    for (i = env->hash[j] & (env->nslot - 1); env->slot[i];
+        i = (i + 1) & (env->nslot - 1)) {
+      const int n = env->slot[i] - 1;
+      if (env->hash[n] == env->hash[j] && params[n].nlen == params[j].nlen &&
+          !memcmp(env->name + (size_t) n * CFGCLI_MAX_NAME_LEN, name, len)) {
+        cfgcli_msg(cfg, "omitting ambiguous environment variable for parameter",
+            params[j].name);
+        break;
+      }
+    }
+    if (!env->slot[i]) env->slot[i] = j + 1;
+  }
+  return 0;
+}
+
+/******************************************************************************
+Function `cfgcli_env_find`:
+  Search for the parameter given an environment variable name.
+Arguments:
+  * `cfg`:      entry for the configurations;
+  * `env`:      the table of environment variable names;
+  * `name`:     name of the variable without the prefix, not terminated;
+  * `len`:      length of the name.
+Return:
+  Address of the parameter on success; NULL if it is not found.
+******************************************************************************/
+static cfgcli_param_valid_t *cfgcli_env_find(const cfgcli_t *cfg,
+    const cfgcli_env_t *env, const char *name, const size_t len) {
+  cfgcli_param_valid_t *params = (cfgcli_param_valid_t *) cfg->params;
+  const uint64_t hash = cfgcli_hash(name, len);
+  for (size_t i = hash & (env->nslot - 1); env->slot[i];
+      i = (i + 1) & (env->nslot - 1)) {
+    const int n = env->slot[i] - 1;
+    if (env->hash[n] == hash && params[n].nlen == len + 1 &&
+        !memcmp(env->name + (size_t) n * CFGCLI_MAX_NAME_LEN, name, len))
+      return params + n;
+  }
+  return NULL;
+}
+
+/******************************************************************************
+Function `cfgcli_env_assign`:
+  Copy the value of an environment variable, and assign it to a parameter.
+Arguments:
+  * `cfg`:      entry for the configurations;
+  * `par`:      address of the verified configuration parameter;
+  * `var`:      the value of the variable;
+  * `prior`:    priority of the value;
+  * `buf`:      buffer for the copies, which is reused by all values;
+  * `max`:      size of the buffer.
+Return:
+  Zero on success; non-zero on error.
+******************************************************************************/
+static int cfgcli_env_assign(cfgcli_t *cfg, cfgcli_param_valid_t *par,
+    const char *var, const int prior, char **buf, size_t *max) {
+  /* Copy the value, as the environment must not be modified. */
+  const size_t size = strlen(var) + 1;
+  char *value = *buf;
+  if (CFGCLI_DTYPE_IS_VIEW(par->dtype)) value = cfgcli_keep(cfg, size);
+  else if (size > *max) {
+    if ((value = realloc(*buf, size))) {
+      *buf = value;
+      *max = size;
+    }
+  }
+  if (!value) {
+    cfgcli_msg(cfg, "failed to allocate memory for environment variables",
+        NULL);
+    return CFGCLI_ERRNO(cfg) = CFGCLI_ERR_MEMORY;
+  }
+  memcpy(value, var, size);
+  return cfgcli_assign_entry(cfg, par, value, prior,
+      CFGCLI_DTYPE_IS_VIEW(par->dtype));
+}
+
+/******************************************************************************
+Function `cfgcli_read_env`:
+  Read configuration parameters from environment variables.
+Arguments:
+  * `cfg`:      entry for the configurations;
+  * `prefix`:   prefix of the variable names, NULL for no prefix;
+  * `prior`:    priority of values read from the environment.
+Return:
+  Zero on success; non-zero on error.
+******************************************************************************/
+int cfgcli_read_env(cfgcli_t *cfg, const char *prefix, const int prior) {
+  /* Validate function arguments. */
+  if (!cfg) return CFGCLI_ERR_INIT;
+  if (CFGCLI_IS_ERROR(cfg)) return CFGCLI_ERRNO(cfg);
+  if (cfg->npar <= 0) {
+    cfgcli_msg(cfg, "no parameter has been registered", NULL);
+    return CFGCLI_ERRNO(cfg) = CFGCLI_ERR_INIT;
+  }
+  if (prior <= CFGCLI_SRC_NULL) {
+    cfgcli_msg(cfg, "invalid priority for environment variables", NULL);
+    return CFGCLI_ERRNO(cfg) = CFGCLI_ERR_INPUT;
+  }
+#ifdef HAVE_ENVIRON
+  if (!environ) return 0;
+#endif
+  const size_t plen = prefix ? strlen(prefix) : 0;
+
+  cfgcli_env_t env;
+  if (cfgcli_env_build(cfg, &env)) {
+    cfgcli_msg(cfg, "failed to allocate memory for environment variables",
+        NULL);
+    return CFGCLI_ERRNO(cfg) = CFGCLI_ERR_MEMORY;
+  }
+
+  char *buf = NULL;             /* values are modified by the conversion */
+  size_t max = 0;
+  int err = 0;
+#ifdef HAVE_ENVIRON
+  for (char **ep = environ; *ep; ep++) {
+    const char *var = *ep;
+    if (plen && strncmp(var, prefix, plen)) continue;
+    const char *name = var + plen;
+    const char *eq = strchr(name, CFGCLI_SYM_EQUAL);
+    if (!eq || eq == name || eq - name >= CFGCLI_MAX_NAME_LEN) continue;
+
+    cfgcli_param_valid_t *par = cfgcli_env_find(cfg, &env, name, eq - name);
+    if (!par || eq[1] == '\0' || !cfgcli_in_scope(cfg, par->name)) continue;
+    if ((err = cfgcli_env_assign(cfg, par, eq + 1, prior, &buf, &max))) break;
+  }
+#else
+  /* Look up the variable of every parameter, as the list of all variables
+     is not available. */
+  char *var = malloc(plen + CFGCLI_MAX_NAME_LEN);
+  if (!var) {
+    cfgcli_env_free(&env);
+    cfgcli_msg(cfg, "failed to allocate memory for environment variables",
+        NULL);
+    return CFGCLI_ERRNO(cfg) = CFGCLI_ERR_MEMORY;
+  }
+  if (plen) memcpy(var, prefix, plen);
+  for (int j = 0; j < cfg->npar; j++) {
+    cfgcli_param_valid_t *par = (cfgcli_param_valid_t *) cfg->params + j;
+    const char *name = env.name + (size_t) j * CFGCLI_MAX_NAME_LEN;
+    const size_t len = par->nlen - 1;
+    /* Ambiguous names are only read by the first parameter. */
+    if (cfgcli_env_find(cfg, &env, name, len) != par ||
+        !cfgcli_in_scope(cfg, par->name)) continue;
+    memcpy(var + plen, name, len);
+    var[plen + len] = '\0';
+    const char *value = getenv(var);
+    if (!value || value[0] == '\0') continue;
+    if ((err = cfgcli_env_assign(cfg, par, value, prior, &buf, &max))) break;
+  }
+  free(var);
+#endif
+
+  free(buf);
+  cfgcli_env_free(&env);
+  return err;
+}
+
+
+/*============================================================================*\
+                 Functions for checking the status of variables
+\*============================================================================*/
+
+/******************************************************************************
+Function `cfgcli_is_set`:
+  Check if a variable is set via the command line or files.
+Arguments:
+  * `cfg`:      entry of all configurations;
+  * `var`:      address of the variable.
+Return:
+  True if the variable is set; false otherwise.
+******************************************************************************/
+bool cfgcli_is_set(const cfgcli_t *cfg, const void *var) {
+  if (!cfg || !var || !cfg->npar) return false;
+  for (int i = 0; i < cfg->npar; i++) {
+    cfgcli_param_valid_t *par = (cfgcli_param_valid_t *) cfg->params + i;
+    if (par->var == var) {
+      if (par->src != CFGCLI_SRC_NULL) return true;
+      break;
+    }
+  }
+  return false;
+}
+
+/******************************************************************************
+Function `cfgcli_get_size`:
+  Return the number of elements for the parsed array.
+Arguments:
+  * `cfg`:      entry of all configurations;
+  * `var`:      address of the variable.
+Return:
+  The number of array elements on success; 0 on error, or if the number
+  cannot be represented by an int (see `cfgcli_get_array_size`).
+******************************************************************************/
+int cfgcli_get_size(const cfgcli_t *cfg, const void *var) {
+  size_t n = cfgcli_get_array_size(cfg, var);
+  return (n > INT_MAX) ? 0 : (int) n;
+}
+
+/******************************************************************************
+Function `cfgcli_get_array_size`:
+  Return the number of elements for the parsed array.
+Arguments:
+  * `cfg`:      entry of all configurations;
+  * `var`:      address of the variable.
+Return:
+  The number of array elements on success; 0 on error.
+******************************************************************************/
+size_t cfgcli_get_array_size(const cfgcli_t *cfg, const void *var) {
+  if (!cfg || !var || !cfg->npar) return 0;
+  for (int i = 0; i < cfg->npar; i++) {
+    cfgcli_param_valid_t *par = (cfgcli_param_valid_t *) cfg->params + i;
+    if (par->var == var) {
+      if (par->src != CFGCLI_SRC_NULL) return par->narr;
+      break;
+    }
+  }
+  return 0;
+}
+
+
+/******************************************************************************
+Function `cfgcli_foreach_param`:
+  Call a function for all parameters in a section.
+Arguments:
+  * `cfg`:      entry of all configurations;
+  * `section`:  name of the section, NULL or "" for all parameters;
+  * `func`:     function called with the name and variable of parameters;
+  * `arg`:      argument passed to the function.
+Return:
+  Zero if all parameters are visited; the non-zero value returned by `func`;
+  or non-zero if the section is not registered.
+******************************************************************************/
+int cfgcli_foreach_param(const cfgcli_t *cfg, const char *section,
+    int (*func) (const char *name, void *var, void *arg), void *arg) {
+  if (!cfg || !func || !cfg->index) return CFGCLI_ERR_INIT;
+  if (!section) section = "";
+  const int n = cfgcli_index_find(cfg->index, section, strlen(section));
+  if (n < 0) return CFGCLI_ERR_INPUT;
+  return cfgcli_index_visit(cfg, n, func, arg);
+}
+
+/******************************************************************************
+Function `cfgcli_diff`:
+  Report parameters that differ between two configurations.
+Arguments:
+  * `a`:        entry of the first configurations;
+  * `b`:        entry of the second configurations;
+  * `func`:     function called with the name, the kind of the difference,
+                and the sources of the value in both configurations;
+  * `arg`:      argument passed to the function.
+Return:
+  Zero if all differences are reported; the non-zero value returned by
+  `func`; or non-zero on error.
+******************************************************************************/
+int cfgcli_diff(cfgcli_t *a, cfgcli_t *b,
+    int (*func) (const char *name, const cfgcli_diff_t kind, const int src_a,
+      const int src_b, void *arg), void *arg) {
+  if (!a || !b || !func) return CFGCLI_ERR_INIT;
+  int i, ret;
+
+  /* Parameters of the first configurations, compared by hashes first. */
+  for (i = 0; i < a->npar; i++) {
+    cfgcli_param_valid_t *pa = (cfgcli_param_valid_t *) a->params + i;
+    cfgcli_param_valid_t *pb = cfgcli_find_param(b, pa->name);
+    const int src_b = pb ? pb->src : CFGCLI_SRC_NULL;
+    cfgcli_diff_t kind;
+    if (pa->src == CFGCLI_SRC_NULL && src_b == CFGCLI_SRC_NULL) continue;
+    if (src_b == CFGCLI_SRC_NULL) kind = CFGCLI_DIFF_REMOVED;
+    else if (pa->src == CFGCLI_SRC_NULL) kind = CFGCLI_DIFF_ADDED;
+    else {
+      /* Deferred values are converted before their hashes are compared. */
+      if ((ret = cfgcli_resolve_set(a, pa)) ||
+          (ret = cfgcli_resolve_set(b, pb))) return ret;
+      if (pa->hash == pb->hash && cfgcli_value_equal(pa, pb)) continue;
+      kind = CFGCLI_DIFF_CHANGED;
+    }
+    if ((ret = func(pa->name, kind, pa->src, src_b, arg))) return ret;
+  }
+
+  /* Parameters registered only in the second configurations. */
+  for (i = 0; i < b->npar; i++) {
+    const cfgcli_param_valid_t *pb = (cfgcli_param_valid_t *) b->params + i;
+    if (pb->src == CFGCLI_SRC_NULL || cfgcli_find_param(a, pb->name)) continue;
+    if ((ret = func(pb->name, CFGCLI_DIFF_ADDED, CFGCLI_SRC_NULL, pb->src,
+        arg))) return ret;
+  }
+  return 0;
+}
+
+/******************************************************************************
+Function `cfgcli_fingerprint`:
+  Retrieve the fingerprint of the converted values of all set parameters.
+Arguments:
+  * `cfg`:      entry of all configurations;
+  * `out`:      the fingerprint.
+Return:
+  Zero on success; non-zero on error.
+******************************************************************************/
+int cfgcli_fingerprint(cfgcli_t *cfg,
+    unsigned char out[CFGCLI_FINGERPRINT_SIZE]) {
+  if (!cfg || !out) return CFGCLI_ERR_INIT;
+  /* Deferred values are converted, to update their digests. */
+  for (int i = 0; i < cfg->npar; i++) {
+    int err = cfgcli_resolve_set(cfg, (cfgcli_param_valid_t *) cfg->params + i);
+    if (err) return err;
+  }
+  for (int i = 0; i < 4; i++)
+    for (int k = 0; k < 8; k++) out[8 * i + k] = cfg->fprint[i] >> (56 - 8 * k);
+  return 0;
+}
+
+/******************************************************************************
+Function `cfgcli_unset_param`:
+  Save the state of a parameter, and mark it as not set, with its recorded
+  deferred value dropped; used by `cfgcli_reload_section`.
+Arguments:
+  * `name`:     name of the parameter;
+  * `var`:      address of the variable;
+  * `arg`:      the parameters of the reloaded section.
+Return:
+  Zero.
+******************************************************************************/
+static int cfgcli_unset_param(const char *name, void *var, void *arg) {
+  cfgcli_reload_t *rl = (cfgcli_reload_t *) arg;
+  if (!rl->saved) {                     /* count the parameters only */
+    rl->num += 1;
+    return 0;
+  }
+  cfgcli_t *cfg = rl->cfg;
+  cfgcli_param_valid_t *par = cfgcli_find_param(cfg, name);
+  cfgcli_defer_t *def = (cfgcli_defer_t *) cfg->defer;
+  cfgcli_saved_t *sv = rl->saved + rl->num++;
+  sv->idx = par - (cfgcli_param_valid_t *) cfg->params;
+  sv->par = *par;
+  memcpy(&sv->var, var, CFGCLI_DTYPE_IS_ARRAY(par->dtype) ? sizeof(void *) :
+      cfgcli_dtype_size(par->dtype));
+  memset(&sv->rec, 0, sizeof(cfgcli_pending_t));
+  if (def && sv->idx < def->max) {
+    sv->rec = def->rec[sv->idx];
+    memset(def->rec + sv->idx, 0, sizeof(cfgcli_pending_t));
+  }
+
+  cfgcli_value_digest(cfg, par, false);
+  par->src = CFGCLI_SRC_NULL;
+  par->narr = 0;
+  return 0;
+}
+
+/******************************************************************************
+Function `cfgcli_restore_param`:
+  Restore the saved state of a parameter of a section that is not reloaded.
+Arguments:
+  * `cfg`:      entry for all configurations;
+  * `sv`:       the saved state.
+******************************************************************************/
+static void cfgcli_restore_param(cfgcli_t *cfg, cfgcli_saved_t *sv) {
+  cfgcli_param_valid_t *par = (cfgcli_param_valid_t *) cfg->params + sv->idx;
+  cfgcli_defer_t *def = (cfgcli_defer_t *) cfg->defer;
+  cfgcli_value_digest(cfg, par, false);
+  *par = sv->par;
+  memcpy(par->var, &sv->var, CFGCLI_DTYPE_IS_ARRAY(par->dtype) ?
+      sizeof(void *) : cfgcli_dtype_size(par->dtype));
+  cfgcli_fprint_update(cfg, par->digest, true);
+  if (def && sv->idx < def->max) {
+    if (def->rec[sv->idx].owned) free(def->rec[sv->idx].value);
+    def->rec[sv->idx] = sv->rec;
+  }
+}
+
+/******************************************************************************
+Function `cfgcli_reload_section`:
+  Read again the parameters of a section from a file, regardless of their
+  previous sources, and leave other parameters untouched. The parameters of
+  the section are restored if the file cannot be read.
+Arguments:
+  * `cfg`:      entry for the configurations;
+  * `fname`:    name of the input file;
+  * `section`:  name of the section;
+  * `prior`:    priority of values read from this file.
+Return:
+  Zero on success; non-zero on error.
+******************************************************************************/
+int cfgcli_reload_section(cfgcli_t *cfg, const char *fname,
+    const char *section, const int prior) {
+  if (!cfg) return CFGCLI_ERR_INIT;
+  if (CFGCLI_IS_ERROR(cfg)) return CFGCLI_ERRNO(cfg);
+  cfgcli_index_t *idx = (cfgcli_index_t *) cfg->index;
+  const size_t len = section ? strlen(section) : 0;
+  const int n = cfgcli_index_find(idx, section, len);
+  if (!len || n < 0) {
+    cfgcli_msg(cfg, "unregistered section name", section);
+    return CFGCLI_ERRNO(cfg) = CFGCLI_ERR_INPUT;
+  }
+
+  /* Save and unset the parameters of the section. */
+  cfgcli_reload_t rl = {cfg, 0, NULL};
+  cfgcli_index_visit(cfg, n, cfgcli_unset_param, &rl);
+  if (rl.num &&
+      !(rl.saved = malloc(rl.num * sizeof(cfgcli_saved_t)))) {
+    cfgcli_msg(cfg, "failed to allocate memory for reloading section",
+        section);
+    return CFGCLI_ERRNO(cfg) = CFGCLI_ERR_MEMORY;
+  }
+  rl.num = 0;
+  if (rl.saved) cfgcli_index_visit(cfg, n, cfgcli_unset_param, &rl);
+
+  idx->scope = section;
+  idx->sclen = len;
+  int err = cfgcli_read_file(cfg, fname, prior);
+  idx->scope = NULL;
+  idx->sclen = 0;
+
+  /* Restore the previous states on failure, or drop them. */
+  for (int i = 0; i < rl.num; i++) {
+    if (err) cfgcli_restore_param(cfg, rl.saved + i);
+    else if (rl.saved[i].rec.owned) free(rl.saved[i].rec.value);
+  }
+  free(rl.saved);
+  return err;
+}
+
+
+/******************************************************************************
+Function `cfgcli_get_shape`:
+  Return the shape of a parsed multi-dimensional array.
+Arguments:
+  * `cfg`:      entry of all configurations;
+  * `var`:      address of the variable;
+  * `shape`:    array for the length of every dimension.
+Return:
+  Number of dimensions on success; 0 on error, or if the array is not set.
+******************************************************************************/
+int cfgcli_get_shape(const cfgcli_t *cfg, const void *var, size_t *shape) {
+  if (!cfg || !var || !shape || !cfg->npar) return 0;
+  for (int i = 0; i < cfg->npar; i++) {
+    cfgcli_param_valid_t *par = (cfgcli_param_valid_t *) cfg->params + i;
+    if (par->var == var) {
+      if (par->src == CFGCLI_SRC_NULL || !CFGCLI_DTYPE_IS_NDARRAY(par->dtype))
+        break;
+      memcpy(shape, par->shape, par->ndim * sizeof(size_t));
+      return par->ndim;
+    }
+  }
+  return 0;
+}
+
+/******************************************************************************
+Function `cfgcli_get_var`:
+  Retrieve the value of a parameter given its name, and convert the
+  recorded value on first access if conversions are deferred.
+Arguments:
+  * `cfg`:      entry of all configurations;
+  * `name`:     name of the parameter;
+  * `dtype`:    data type of the parameter;
+  * `out`:      address of the variable for the value.
+Return:
+  Zero on success; positive if the parameter is not set; negative on error.
+******************************************************************************/
+int cfgcli_get_var(cfgcli_t *cfg, const char *name, const cfgcli_dtype_t dtype,
+    void *out) {
+  if (!cfg) return CFGCLI_ERR_INIT;
+  if (CFGCLI_IS_ERROR(cfg)) return CFGCLI_ERRNO(cfg);
+  if (!name || !out) return CFGCLI_ERR_INPUT;
+  cfgcli_param_valid_t *par = cfgcli_find_param(cfg, name);
+  if (!par) {
+    cfgcli_msg(cfg, "unregistered parameter name", name);
+    return CFGCLI_ERR_INPUT;
+  }
+  if (par->dtype != dtype) {
+    cfgcli_msg(cfg, "data type mismatch for parameter", name);
+    return CFGCLI_ERR_INPUT;
+  }
+  if (par->src == CFGCLI_SRC_NULL) return 1;
+
+  int err = cfgcli_resolve_param(cfg, par);
+  if (err) return err;
+  /* Arrays and strings are passed by address. */
+  memcpy(out, par->var, CFGCLI_DTYPE_IS_ARRAY(dtype) ? sizeof(void *) :
+      cfgcli_dtype_size(dtype));
+  return 0;
+}
+
+/******************************************************************************
+Functions `cfgcli_get_<type>`:
+  Typed shortcuts of `cfgcli_get_var` for scalar parameters.
+******************************************************************************/
+int cfgcli_get_bool(cfgcli_t *cfg, const char *name, bool *out) {
+  return cfgcli_get_var(cfg, name, CFGCLI_DTYPE_BOOL, out);
+}
+
+int cfgcli_get_char(cfgcli_t *cfg, const char *name, char *out) {
+  return cfgcli_get_var(cfg, name, CFGCLI_DTYPE_CHAR, out);
+}
+
+int cfgcli_get_int(cfgcli_t *cfg, const char *name, int *out) {
+  return cfgcli_get_var(cfg, name, CFGCLI_DTYPE_INT, out);
+}
+
+int cfgcli_get_long(cfgcli_t *cfg, const char *name, long *out) {
+  return cfgcli_get_var(cfg, name, CFGCLI_DTYPE_LONG, out);
+}
+
+int cfgcli_get_flt(cfgcli_t *cfg, const char *name, float *out) {
+  return cfgcli_get_var(cfg, name, CFGCLI_DTYPE_FLT, out);
+}
+
+int cfgcli_get_dbl(cfgcli_t *cfg, const char *name, double *out) {
+  return cfgcli_get_var(cfg, name, CFGCLI_DTYPE_DBL, out);
+}
+
+int cfgcli_get_str(cfgcli_t *cfg, const char *name, char **out) {
+  return cfgcli_get_var(cfg, name, CFGCLI_DTYPE_STR, out);
+}
+
+
+/*============================================================================*\
+                     Functions for writing configurations
+\*============================================================================*/
+
+/******************************************************************************
+Function `cfgcli_out_reserve`:
+  Reserve space for characters to be written, and the ending '\0'.
+Arguments:
+  * `out`:      the output buffer;
+  * `n`:        number of characters to be written.
+Return:
+  Address for writing the characters on success; NULL on error.
+******************************************************************************/
+static char *cfgcli_out_reserve(cfgcli_output_t *out, const size_t n) {
+  if (out->len + n + 1 > out->max) {
+    size_t max = cfgcli_grow_size(out->max, out->len + n + 1);
+    if (!max) return NULL;
+    char *tmp = realloc(out->buf, max);
+    if (!tmp) return NULL;
+    out->buf = tmp;
+    out->max = max;
+  }
+  return out->buf + out->len;
+}
+
+/******************************************************************************
+Function `cfgcli_out_str`:
+  Append characters to the output buffer.
+Arguments:
+  * `out`:      the output buffer;
+  * `str`:      the characters;
+  * `n`:        number of characters.
+Return:
+  Zero on success; non-zero on error.
+******************************************************************************/
+static int cfgcli_out_str(cfgcli_output_t *out, const char *str,
+    const size_t n) {
+  char *dst = cfgcli_out_reserve(out, n);
+  if (!dst) return CFGCLI_ERR_MEMORY;
+  memcpy(dst, str, n);
+  out->len += n;
+  out->buf[out->len] = '\0';
+  return 0;
+}
+
+/******************************************************************************
+Function `cfgcli_out_quoted`:
+  Append a string enclosed by quotation marks that it does not contain, or
+  without quotation marks if it contains both kinds, and no symbols of the
+  format, which is the same for scalars and array elements.
+Arguments:
+  * `out`:      the output buffer;
+  * `str`:      the string;
+  * `n`:        length of the string.
+Return:
+  Zero on success; non-zero on error.
+******************************************************************************/
+static int cfgcli_out_quoted(cfgcli_output_t *out, const char *str,
+    const size_t n) {
+  /* Values cannot contain line breaks, and there are no escape sequences. */
+  if (memchr(str, '\n', n)) return CFGCLI_ERR_VALUE;
+  const char quote = !memchr(str, '"', n) ? '"' :
+    (!memchr(str, '\'', n) ? '\'' : '\0');
+  if (!quote) {
+    /* The value starts with a quotation mark, or is trimmed, otherwise. */
+    if (!n || str[0] == '"' || str[0] == '\'' ||
+        str[0] == CFGCLI_SYM_NEWLINE || isspace((unsigned char) str[0]) ||
+        isspace((unsigned char) str[n - 1])) return CFGCLI_ERR_VALUE;
+    for (size_t i = 0; i < n; i++) {
+      if (!isprint((unsigned char) str[i]) || str[i] == CFGCLI_SYM_COMMENT ||
+          str[i] == CFGCLI_SYM_ARRAY_SEP || str[i] == CFGCLI_SYM_ARRAY_START ||
+          str[i] == CFGCLI_SYM_ARRAY_END) return CFGCLI_ERR_VALUE;
+    }
+    return cfgcli_out_str(out, str, n);
+  }
+  char *dst = cfgcli_out_reserve(out, n + 2);
+  if (!dst) return CFGCLI_ERR_MEMORY;
+  dst[0] = dst[n + 1] = quote;
+  memcpy(dst + 1, str, n);
+  out->len += n + 2;
+  out->buf[out->len] = '\0';
+  return 0;
+}
+
+/******************************************************************************
+Function `cfgcli_format_real`:
+  Print a floating-point number with the fewest significant digits that
+  convert back to the same value.
+Arguments:
+  * `str`:      the destination, with at least 32 bytes;
+  * `x`:        the number;
+  * `single`:   true if the number is single-precision.
+Return:
+  Number of characters printed.
+******************************************************************************/
+static int cfgcli_format_real(char *str, const double x, const bool single) {
+  /* Shorter representations are printed by "%g" without trailing zeros,
+     except for subnormal numbers, which have fewer significant digits. */
+  const int max = single ? CFGCLI_FLT_MAX_DIGITS : CFGCLI_DBL_MAX_DIGITS;
+  const double min = single ? FLT_MIN : DBL_MIN;
+  int p = (x != 0 && x > -min && x < min) ? 1 : (single ? FLT_DIG : DBL_DIG);
+  int n;
+  for (;; p++) {
+    n = sprintf(str, "%.*g", p, x);
+    if (p >= max || x != x) break;              /* maximum digits or NaN */
+    if (single ? strtof(str, NULL) == (float) x : strtod(str, NULL) == x)
+      break;
+  }
+  return n;
+}
+
+/******************************************************************************
+Function `cfgcli_out_elem`:
+  Append a scalar value, or an element of an array.
+Arguments:
+  * `out`:      the output buffer;
+  * `var`:      address of the value;
+  * `dtype`:    data type of the value.
+Return:
+  Zero on success; non-zero on error.
+******************************************************************************/
+static int cfgcli_out_elem(cfgcli_output_t *out, const void *var,
+    const cfgcli_dtype_t dtype) {
+  char *dst;
+  int n;
+  switch (dtype) {
+    case CFGCLI_DTYPE_CHAR:
+      return cfgcli_out_quoted(out, (const char *) var, 1);
+    case CFGCLI_DTYPE_STR:
+      return cfgcli_out_quoted(out, *((char **) var),
+          strlen(*((char **) var)));
+    case CFGCLI_DTYPE_STRV:
+      return cfgcli_out_quoted(out, ((cfgcli_strview_t *) var)->ptr,
+          ((cfgcli_strview_t *) var)->len);
+    case CFGCLI_DTYPE_BOOL:
+      return *((bool *) var) ? cfgcli_out_str(out, "true", 4) :
+        cfgcli_out_str(out, "false", 5);
+    default:
+      break;
+  }
+
+  /* Numbers are printed into the buffer directly. */
+  if (!(dst = cfgcli_out_reserve(out, 32))) return CFGCLI_ERR_MEMORY;
+  switch (dtype) {
+    case CFGCLI_DTYPE_INT:    n = sprintf(dst, "%d", *((int *) var)); break;
+    case CFGCLI_DTYPE_LONG:   n = sprintf(dst, "%ld", *((long *) var)); break;
+    case CFGCLI_DTYPE_FLT:
+      n = cfgcli_format_real(dst, *((float *) var), true);
+      break;
+    case CFGCLI_DTYPE_DBL:
+      n = cfgcli_format_real(dst, *((double *) var), false);
+      break;
+    case CFGCLI_DTYPE_INT8:   n = sprintf(dst, "%" PRId8, *((int8_t *) var)); break;
+    case CFGCLI_DTYPE_INT16:  n = sprintf(dst, "%" PRId16, *((int16_t *) var)); break;
+    case CFGCLI_DTYPE_INT32:  n = sprintf(dst, "%" PRId32, *((int32_t *) var)); break;
+    case CFGCLI_DTYPE_INT64:  n = sprintf(dst, "%" PRId64, *((int64_t *) var)); break;
+    case CFGCLI_DTYPE_UINT8:  n = sprintf(dst, "%" PRIu8, *((uint8_t *) var)); break;
+    case CFGCLI_DTYPE_UINT16: n = sprintf(dst, "%" PRIu16, *((uint16_t *) var)); break;
+    case CFGCLI_DTYPE_UINT32: n = sprintf(dst, "%" PRIu32, *((uint32_t *) var)); break;
+    case CFGCLI_DTYPE_UINT64: n = sprintf(dst, "%" PRIu64, *((uint64_t *) var)); break;
+    case CFGCLI_DTYPE_SIZE:   n = sprintf(dst, "%zu", *((size_t *) var)); break;
+    default:
+      return CFGCLI_ERR_DTYPE;
+  }
+  out->len += n;
+  return 0;
+}
+
+/******************************************************************************
+Function `cfgcli_out_array`:
+  Append the elements of an array, with nested brackets for arrays with
+  multiple dimensions.
+Arguments:
+  * `out`:      the output buffer;
+  * `par`:      address of the verified configuration parameter.
+Return:
+  Zero on success; non-zero on error.
+******************************************************************************/
+static int cfgcli_out_array(cfgcli_output_t *out,
+    const cfgcli_param_valid_t *par) {
+  const cfgcli_dtype_t dtype = cfgcli_elem_dtype(par->dtype);
+  const size_t size = cfgcli_dtype_size(dtype);
+  const char *arr = *((char **) par->var);
+  size_t stride[CFGCLI_MAX_NDIM];
+  int d, err, ndim = 1;
+  stride[0] = par->narr;
+  if (CFGCLI_DTYPE_IS_NDARRAY(par->dtype)) {    /* elements of sub-arrays */
+    ndim = par->ndim;
+    stride[ndim - 1] = par->shape[ndim - 1];
+    for (d = ndim - 2; d >= 0; d--) stride[d] = stride[d + 1] * par->shape[d];
+  }
+
+  for (size_t i = 0; i < par->narr; i++) {
+    /* Close and open the sub-arrays that end before this element. */
+    for (d = 0; d < ndim; d++) if (i % stride[d] == 0) break;
+    if (i && (err = cfgcli_out_str(out, "]]]]]]]]", ndim - d))) return err;
+    if (i && (err = cfgcli_out_str(out, ", ", 2))) return err;
+    if ((err = cfgcli_out_str(out, "[[[[[[[[", ndim - d))) return err;
+
+    if (par->dtype == CFGCLI_ARRAY_BITS)
+      err = cfgcli_out_str(out, CFGCLI_BITS_TEST((const uint64_t *) arr, i) ?
+          "1" : "0", 1);
+    else err = cfgcli_out_elem(out, arr + i * size, dtype);
+    if (err) return err;
+  }
+  return cfgcli_out_str(out, "]]]]]]]]", ndim);
+}
+
+/******************************************************************************
+Function `cfgcli_out_param`:
+  Append the entry of a parameter, if its value is set.
+Arguments:
+  * `out`:      the output buffer;
+  * `par`:      address of the verified configuration parameter.
+Return:
+  Zero on success; non-zero on error.
+******************************************************************************/
+static int cfgcli_out_param(cfgcli_output_t *out,
+    const cfgcli_param_valid_t *par) {
+  int err;
+  /* Elements passed to sinks are not kept. */
+  if (par->src == CFGCLI_SRC_NULL || par->sink) return 0;
+  if (par->dtype == CFGCLI_DTYPE_STR && !*((char **) par->var)) return 0;
+  if (CFGCLI_DTYPE_IS_ARRAY(par->dtype) && !par->narr) return 0;
+
+  if ((err = cfgcli_out_str(out, par->name, par->nlen - 1)) ||
+      (err = cfgcli_out_str(out, " = ", 3))) return err;
+  if (par->dtype == CFGCLI_DTYPE_BLOB) {
+    const unsigned char *blob = *((unsigned char **) par->var);
+    char *dst = cfgcli_out_reserve(out, 2 * par->narr + 2);
+    if (!dst) return CFGCLI_ERR_MEMORY;
+    *dst++ = '0';
+    *dst++ = 'x';
+    for (size_t i = 0; i < par->narr; i++) {
+      *dst++ = "0123456789abcdef"[blob[i] >> 4];
+      *dst++ = "0123456789abcdef"[blob[i] & 0xF];
+    }
+    out->len += 2 * par->narr + 2;
+  }
+  else if (CFGCLI_DTYPE_IS_ARRAY(par->dtype)) err = cfgcli_out_array(out, par);
+  else err = cfgcli_out_elem(out, par->var, par->dtype);
+  if (err) return err;
+  return cfgcli_out_str(out, "\n", 1);
+}
+
+/******************************************************************************
+Function `cfgcli_write_buffer`:
+  Write the values of all set parameters in the configuration file format.
+Arguments:
+  * `cfg`:      entry for the configurations;
+  * `buf`:      address of the null terminated output;
+  * `len`:      length of the output, NOT including the ending '\0'.
+Return:
+  Zero on success; non-zero on error.
+******************************************************************************/
+int cfgcli_write_buffer(cfgcli_t *cfg, char **buf, size_t *len) {
+  if (!cfg) return CFGCLI_ERR_INIT;
+  if (CFGCLI_IS_ERROR(cfg)) return CFGCLI_ERRNO(cfg);
+  if (!buf || !len) {
+    cfgcli_msg(cfg, "the output buffer is not set", NULL);
+    return CFGCLI_ERRNO(cfg) = CFGCLI_ERR_INPUT;
+  }
+
+  cfgcli_output_t out = {NULL, 0, 0};
+  if (!cfgcli_out_reserve(&out, 0)) {
+    cfgcli_msg(cfg, "failed to allocate memory for writing parameters", NULL);
+    return CFGCLI_ERRNO(cfg) = CFGCLI_ERR_MEMORY;
+  }
+  out.buf[0] = '\0';
+  for (int i = 0; i < cfg->npar; i++) {
+    cfgcli_param_valid_t *par = (cfgcli_param_valid_t *) cfg->params + i;
+    /* Convert deferred values before they are written. */
+    int err = cfgcli_resolve_set(cfg, par);
+    if (err) {
+      free(out.buf);
+      return err;
+    }
+    /* Values that cannot be represented are omitted with a warning. */
+    const size_t len0 = out.len;
+    err = cfgcli_out_param(&out, par);
+    if (err == CFGCLI_ERR_VALUE) {
+      out.len = len0;
+      out.buf[len0] = '\0';
+      cfgcli_msg(cfg, "omitting the value that cannot be written for parameter",
+          par->name);
+    }
+    else if (err) {
+      free(out.buf);
+      return cfgcli_get_error(cfg, par, err);
+    }
+  }
+  *buf = out.buf;
+  *len = out.len;
+  return 0;
+}
+
+/******************************************************************************
+Function `cfgcli_write_file`:
+  Write the values of all set parameters to a file in the configuration
+  file format.
+Arguments:
+  * `cfg`:      entry for the configurations;
+  * `fname`:    name of the output file.
+Return:
+  Zero on success; non-zero on error.
+******************************************************************************/
+int cfgcli_write_file(cfgcli_t *cfg, const char *fname) {
+  if (!cfg) return CFGCLI_ERR_INIT;
+  if (CFGCLI_IS_ERROR(cfg)) return CFGCLI_ERRNO(cfg);
+  if (!fname) {
+    cfgcli_msg(cfg, "the output file is not set", NULL);
     return CFGCLI_ERRNO(cfg) = CFGCLI_ERR_INPUT;
   }
 
-  FILE *fp = fopen(fname, "r");
+  char *buf;
+  size_t len;
+  int err;
+  if ((err = cfgcli_write_buffer(cfg, &buf, &len))) return err;
+
+  /* Write the full content at once, without copying it to a stream buffer. */
+  FILE *fp = fopen(fname, "w");
   if (!fp) {
-    cfgcli_msg(cfg, "cannot open the configuration file", fname);
+    free(buf);
+    cfgcli_msg(cfg, "cannot open the file for writing", fname);
     return CFGCLI_ERRNO(cfg) = CFGCLI_ERR_FILE;
   }
-
-  /* Read file by chunk. */
-  size_t clen = CFGCLI_STR_INIT_SIZE;
-  char *chunk = calloc(clen, sizeof(char));
-  if (!chunk) {
-    fclose(fp);
-    cfgcli_msg(cfg, "failed to allocate memory for reading file", fname);
-    return CFGCLI_ERRNO(cfg) = CFGCLI_ERR_MEMORY;
+  setvbuf(fp, NULL, _IONBF, 0);
+  const bool fail = (fwrite(buf, 1, len, fp) != len);
+  free(buf);
+  if (fclose(fp) || fail) {
+    cfgcli_msg(cfg, "failed to write the file", fname);
+    return CFGCLI_ERRNO(cfg) = CFGCLI_ERR_FILE;
   }
+  return 0;
+}
 
-  size_t nline, nrest, nproc, cnt;
-  char *key, *value;
-  cfgcli_parse_state_t state = CFGCLI_PARSE_START;
-  nline = nrest = nproc = 0;
-  key = value = NULL;
-  cfgcli_param_valid_t *params = (cfgcli_param_valid_t *) cfg->params;
 
-  while ((cnt = fread(chunk + nrest, sizeof(char), clen - nrest, fp))) {
-    char *p = (state == CFGCLI_PARSE_ARRAY_START) ? chunk + nproc : chunk;
-    char *end = chunk + nrest + cnt;
-    char *endl;
-    if (cnt < clen - nrest) *end++ = '\n';      /* terminate the last line */
+/*============================================================================*\
+             Functions for sharing configurations between processes
+\*============================================================================*/
 
-    /* Process lines in the chunk. */
-    while ((endl = memchr(p, '\n', end - p))) {
-      *endl = '\0';             /* replace '\n' by '\0' for line parser */
-      nline += 1;
+/******************************************************************************
+Function `cfgcli_shared_put`:
+  Reserve space in a shared segment, and copy data into it.
+Arguments:
+  * `base`:     start of the segment, NULL for computing the layout only;
+  * `off`:      end of the used space, updated by this function;
+  * `src`:      the data, NULL for reserving space only;
+  * `len`:      number of bytes of the data;
+  * `align`:    alignment of the data, a power of 2.
+Return:
+  Offset of the data in the segment.
+******************************************************************************/
+static size_t cfgcli_shared_put(char *base, size_t *off, const void *src,
+    const size_t len, const size_t align) {
+  const size_t pos = (*off + align - 1) & ~(align - 1);
+  if (base && src && len) memcpy(base + pos, src, len);
+  *off = pos + len;
+  return pos;
+}
 
-      /* Retrieve the keyword and value from the line. */
-      char msg[CFGCLI_NUM_MAX_SIZE(size_t)];
-      int j;
-      cfgcli_parse_return_t status =
-        cfgcli_parse_line(p, endl - p, &key, &value, state);
+/******************************************************************************
+Function `cfgcli_shared_layout`:
+  Compute the layout of a shared segment, and write the segment.
+Arguments:
+  * `cfg`:      entry for the configurations;
+  * `base`:     start of the zero-filled segment, NULL for computing the
+                size only;
+  * `npar`:     number of parameters to be shared;
+  * `nslot`:    number of hash slots, a power of 2.
+Return:
+  Size of the segment.
+******************************************************************************/
+static size_t cfgcli_shared_layout(const cfgcli_t *cfg, char *base,
+    const uint32_t npar, const uint64_t nslot) {
+  const cfgcli_param_valid_t *params = (cfgcli_param_valid_t *) cfg->params;
+  size_t off = sizeof(cfgcli_shared_head_t);
+  const size_t slot = cfgcli_shared_put(base, &off, NULL,
+      nslot * sizeof(uint32_t), sizeof(uint64_t));
+  const size_t entry = cfgcli_shared_put(base, &off, NULL,
+      npar * sizeof(cfgcli_shared_entry_t), sizeof(uint64_t));
+  uint32_t *slots = base ? (uint32_t *) (base + slot) : NULL;
+  uint32_t n = 0;
 
-      switch (status) {
-        case CFGCLI_PARSE_DONE:
-          /* search for the parameter given the name */
-          for (j = 0; j < cfg->npar; j++)
-            if (!strncmp(key, params[j].name, params[j].nlen)) break;
-          if (j == cfg->npar)           /* parameter not found */
-            cfgcli_msg(cfg, "unregistered parameter name", key);
-          else {
-            /* priority check */
-            if  (CFGCLI_SRC_VAL(params[j].src) < prior) {
-              params[j].value = value;
-              params[j].vlen = strlen(value) + 1;
-              int err = cfgcli_get(cfg, params + j, prior);
-              if (err) {
-                free(chunk);
-                fclose(fp);
-                return err;
-              }
-              params[j].src = prior;
-            }
-            else if (CFGCLI_SRC_VAL(params[j].src) == prior)
-              cfgcli_msg(cfg, "omitting duplicate entry of parameter", key);
-          }
-          /* reset states */
-          key = value = NULL;
-          state = CFGCLI_PARSE_START;
-          break;
-        case CFGCLI_PARSE_CONTINUE:        /* line continuation */
-          *endl = ' ';                  /* remove line break */
-          state = CFGCLI_PARSE_ARRAY_START;
-          break;
-        case CFGCLI_PARSE_ERROR:
-          sprintf(msg, "%zu", nline);
-          cfgcli_msg(cfg, "invalid configuration entry at line", msg);
-#if __STDC_VERSION__ > 201710L
-          [[fallthrough]];
-#endif
-        case CFGCLI_PARSE_PASS:
-          state = CFGCLI_PARSE_START;
-          break;
-        default:
-          free(chunk);
-          fclose(fp);
-          sprintf(msg, "%d", status);
-          cfgcli_msg(cfg, "unknown line parser status", msg);
-          return CFGCLI_ERRNO(cfg) = CFGCLI_ERR_UNKNOWN;
-      }
-      p = endl + 1;
-    }
+  for (int i = 0; i < cfg->npar; i++) {
+    const cfgcli_param_valid_t *par = params + i;
+    if (par->src == CFGCLI_SRC_NULL || par->sink) continue;
+    cfgcli_shared_entry_t e;
+    memset(&e, 0, sizeof(cfgcli_shared_entry_t));
+    e.hash = cfgcli_hash(par->name, par->nlen - 1);
+    e.name = cfgcli_shared_put(base, &off, par->name, par->nlen, 1);
+    e.narr = par->narr;
+    e.dtype = par->dtype;
 
-    /* The chunk cannot hold a full line. */
-    if (p == chunk) {
-      size_t new_len = 0;
-      if (clen >= CFGCLI_STR_MAX_DOUBLE_SIZE) {
-        if (SIZE_MAX - CFGCLI_STR_MAX_DOUBLE_SIZE >= clen)
-          new_len = clen + CFGCLI_STR_MAX_DOUBLE_SIZE;
-      }
-      else if (SIZE_MAX / 2 >= clen) new_len = clen << 1;
-      if (!new_len) {                   /* overflow occurred */
-        cfgcli_msg(cfg, "failed to allocate memory for reading the file", fname);
-        return CFGCLI_ERRNO(cfg) = CFGCLI_ERR_MEMORY;
-      }
-      char *tmp = realloc(chunk, new_len);
-      if (!tmp) {
-        cfgcli_msg(cfg, "failed to allocate memory for reading the file", fname);
-        return CFGCLI_ERRNO(cfg) = CFGCLI_ERR_MEMORY;
-      }
-      chunk = tmp;
-      clen = new_len;
-      nrest += cnt;
-      continue;
+    const void *ptr;
+    size_t len;
+    if (par->dtype == CFGCLI_DTYPE_STR || par->dtype == CFGCLI_DTYPE_STRV) {
+      ptr = cfgcli_value_span(par, 0, &len);
+      e.value = cfgcli_shared_put(base, &off, ptr, len, 1);
+      e.len = len;
+      off += 1;                         /* the ending '\0' */
     }
-
-    /* Copy the remaining characters to the beginning of the chunk. */
-    if (state == CFGCLI_PARSE_ARRAY_START) {       /* copy also parsed part */
-      if (!key) {
-        free(chunk);
-        fclose(fp);
-        cfgcli_msg(cfg, "unknown parser interruption", NULL);
-        return CFGCLI_ERRNO(cfg) = CFGCLI_ERR_UNKNOWN;
+    else if (par->dtype == CFGCLI_ARRAY_STR ||
+        par->dtype == CFGCLI_ARRAY_STRV) {
+      /* Offsets and lengths of the elements, followed by the characters. */
+      e.len = par->narr * 2 * sizeof(uint64_t);
+      e.value = cfgcli_shared_put(base, &off, NULL, e.len, sizeof(uint64_t));
+      uint64_t *tab = base ? (uint64_t *) (base + e.value) : NULL;
+      for (size_t j = 0; j < par->narr; j++) {
+        ptr = cfgcli_value_span(par, j, &len);
+        const size_t pos = cfgcli_shared_put(base, &off, ptr, len, 1);
+        off += 1;
+        if (tab) {
+          tab[2 * j] = pos;
+          tab[2 * j + 1] = len;
+        }
       }
-      /* `key` is the starting point of this effective line */
-      nrest = end - key;
-      nproc = p - key;
-      memmove(chunk, key, nrest);
-      /* shift `key` and `value` */
-      if (value) value -= key - chunk;
-      key = chunk;
     }
-    else {                      /* copy only from the current position */
-      nrest = end - p;
-      memmove(chunk, p, nrest);
+    else {
+      size_t k = 0;
+      if (CFGCLI_DTYPE_IS_NDARRAY(par->dtype)) {
+        ptr = cfgcli_value_span(par, k++, &len);
+        e.shape = cfgcli_shared_put(base, &off, ptr, len, sizeof(uint64_t));
+        e.ndim = par->ndim;
+      }
+      ptr = cfgcli_value_span(par, k, &len);
+      e.value = cfgcli_shared_put(base, &off, ptr, len,
+          (CFGCLI_DTYPE_IS_ARRAY(par->dtype) ||
+          par->dtype == CFGCLI_DTYPE_BLOB) ?
+          CFGCLI_SHARED_ALIGN : sizeof(uint64_t));
+      e.len = len;
     }
 
-    /* The chunk is full. */
-    if (nrest == clen) {
-      size_t new_len = 0;
-      if (clen >= CFGCLI_STR_MAX_DOUBLE_SIZE) {
-        if (SIZE_MAX - CFGCLI_STR_MAX_DOUBLE_SIZE >= clen)
-          new_len = clen + CFGCLI_STR_MAX_DOUBLE_SIZE;
-      }
-      else if (SIZE_MAX / 2 >= clen) new_len = clen << 1;
-      if (!new_len) {
-        cfgcli_msg(cfg, "failed to allocate memory for reading the file", fname);
-        return CFGCLI_ERRNO(cfg) = CFGCLI_ERR_MEMORY;
-      }
-      size_t key_shift = key ? key - chunk : 0;
-      size_t value_shift = value ? value - chunk : 0;
-      char *tmp = realloc(chunk, new_len);
-      if (!tmp) {
-        cfgcli_msg(cfg, "failed to allocate memory for reading the file", fname);
-        return CFGCLI_ERRNO(cfg) = CFGCLI_ERR_MEMORY;
-      }
-      chunk = tmp;
-      clen = new_len;
-      if (key) key = chunk + key_shift;
-      if (value) value = chunk + value_shift;
+    /* Record the parameter, and index it by the name. */
+    if (base) {
+      uint64_t h = e.hash & (nslot - 1);
+      while (slots[h]) h = (h + 1) & (nslot - 1);
+      slots[h] = n + 1;
+      memcpy(base + entry + n * sizeof(cfgcli_shared_entry_t), &e,
+          sizeof(cfgcli_shared_entry_t));
     }
+    n += 1;
   }
 
-  if (!feof(fp)) {
-    cfgcli_msg(cfg, "unexpected end of file", fname);
-    free(chunk);
-    fclose(fp);
+  if (base) {
+    cfgcli_shared_head_t head;
+    memset(&head, 0, sizeof(cfgcli_shared_head_t));
+    memcpy(head.magic, CFGCLI_SHARED_MAGIC, sizeof(head.magic));
+    head.version = CFGCLI_SHARED_VERSION;
+    head.npar = npar;
+    head.size = off;
+    head.nslot = nslot;
+    head.slot = slot;
+    head.entry = entry;
+    memcpy(base, &head, sizeof(cfgcli_shared_head_t));
+  }
+  return off;
+}
+
+#ifdef CFGCLI_HAVE_SHARED
+/******************************************************************************
+Function `cfgcli_shared_create`:
+  Create an anonymous file in memory for a shared segment, with memfd if it
+  is available, or an unlinked POSIX shared memory object otherwise.
+Arguments:
+  * `rdonly`:   the read-only descriptor to be shared, which is the same as
+                the returned one if the file can be sealed.
+Return:
+  The writable file descriptor on success; -1 on error.
+******************************************************************************/
+static int cfgcli_shared_create(int *rdonly) {
+#ifdef HAVE_MEMFD
+  return *rdonly = syscall(__NR_memfd_create, "libcfgcli",
+      MFD_CLOEXEC | MFD_ALLOW_SEALING);
+#else
+  /* Open the object twice, before it is unlinked. */
+  static unsigned count = 0;
+  char name[64];
+  for (int i = 0; i < CFGCLI_SHARED_MAX_RETRY; i++) {
+    snprintf(name, sizeof name, "/libcfgcli-%ld-%u", (long) getpid(),
+        count++);
+    const int wfd = shm_open(name, O_RDWR | O_CREAT | O_EXCL, 0600);
+    if (wfd < 0) continue;
+    *rdonly = shm_open(name, O_RDONLY, 0);
+    shm_unlink(name);
+    if (*rdonly >= 0) return wfd;
+    close(wfd);
+    return -1;
+  }
+  return -1;
+#endif
+}
+#endif
+
+/******************************************************************************
+Function `cfgcli_shared_export`:
+  Write the values of all set parameters into a read-only shared segment.
+Arguments:
+  * `cfg`:      entry for the configurations.
+Return:
+  File descriptor of the segment on success; negative error code on error.
+******************************************************************************/
+int cfgcli_shared_export(cfgcli_t *cfg) {
+  if (!cfg) return CFGCLI_ERR_INIT;
+  if (CFGCLI_IS_ERROR(cfg)) return CFGCLI_ERRNO(cfg);
+
+  /* Convert deferred values, and count the parameters with values. */
+  cfgcli_param_valid_t *params = (cfgcli_param_valid_t *) cfg->params;
+  uint32_t npar = 0;
+  uint64_t nslot = 8;
+  for (int i = 0; i < cfg->npar; i++) {
+    if (params[i].src == CFGCLI_SRC_NULL || params[i].sink) continue;
+    const int err = cfgcli_resolve_param(cfg, params + i);
+    if (err) return err;
+    npar += 1;
+  }
+  while (nslot < (uint64_t) npar * 2) nslot <<= 1;
+  const size_t size = cfgcli_shared_layout(cfg, NULL, npar, nslot);
+
+#ifndef CFGCLI_HAVE_SHARED
+  (void) size;
+  cfgcli_msg(cfg, "shared segments are not supported on this system", NULL);
+  return CFGCLI_ERRNO(cfg) = CFGCLI_ERR_FILE;
+#else
+  int fd, wfd = cfgcli_shared_create(&fd);
+  if (wfd < 0) {
+    cfgcli_msg(cfg, "cannot create the shared segment", NULL);
     return CFGCLI_ERRNO(cfg) = CFGCLI_ERR_FILE;
   }
+  char *base = MAP_FAILED;
+  if (ftruncate(wfd, size) || (base = mmap(NULL, size, PROT_READ | PROT_WRITE,
+      MAP_SHARED, wfd, 0)) == MAP_FAILED) {
+    if (fd != wfd) close(fd);
+    close(wfd);
+    cfgcli_msg(cfg, "failed to allocate memory for the shared segment", NULL);
+    return CFGCLI_ERRNO(cfg) = CFGCLI_ERR_MEMORY;
+  }
+  cfgcli_shared_layout(cfg, base, npar, nslot);
+  munmap(base, size);
 
-  free(chunk);
-  fclose(fp);
-  return 0;
+  /* Forbid modifications by any process, if the file can be sealed. */
+  if (fd == wfd) {
+#ifdef HAVE_MEMFD
+    if (fcntl(fd, F_ADD_SEALS, F_SEAL_SHRINK | F_SEAL_GROW | F_SEAL_WRITE |
+        F_SEAL_SEAL)) {
+      close(fd);
+      cfgcli_msg(cfg, "cannot seal the shared segment", NULL);
+      return CFGCLI_ERRNO(cfg) = CFGCLI_ERR_FILE;
+    }
+#endif
+  }
+  else close(wfd);
+  return fd;
+#endif
 }
 
+/******************************************************************************
+Function `cfgcli_shared_attach`:
+  Map a shared segment read-only.
+Arguments:
+  * `fd`:       file descriptor of the segment.
+Return:
+  The attached segment on success; NULL on error.
+******************************************************************************/
+cfgcli_shared_t *cfgcli_shared_attach(const int fd) {
+#ifndef HAVE_MMAP
+  (void) fd;
+  return NULL;
+#else
+  struct stat st;
+  if (fd < 0 || fstat(fd, &st) ||
+      st.st_size < (off_t) sizeof(cfgcli_shared_head_t) ||
+      (uintmax_t) st.st_size >= SIZE_MAX) return NULL;
+  const size_t size = st.st_size;
+  char *base = mmap(NULL, size, PROT_READ, MAP_SHARED, fd, 0);
+  if (base == MAP_FAILED) return NULL;
 
-/*============================================================================*\
-                 Functions for checking the status of variables
-\*============================================================================*/
+  /* Validate the header, and bounds of the tables. */
+  const cfgcli_shared_head_t *head = (const cfgcli_shared_head_t *) base;
+  cfgcli_shared_t *sh = NULL;
+  if (memcmp(head->magic, CFGCLI_SHARED_MAGIC, sizeof(head->magic)) ||
+      head->version != CFGCLI_SHARED_VERSION || head->size != size ||
+      !head->nslot || (head->nslot & (head->nslot - 1)) ||
+      head->nslot <= head->npar || head->slot % sizeof(uint64_t) ||
+      head->entry % sizeof(uint64_t) || head->slot > size ||
+      head->nslot > (size - head->slot) / sizeof(uint32_t) ||
+      head->entry > size ||
+      head->npar > (size - head->entry) / sizeof(cfgcli_shared_entry_t) ||
+      !(sh = malloc(sizeof(cfgcli_shared_t)))) {
+    munmap(base, size);
+    return NULL;
+  }
+  sh->base = base;
+  sh->size = size;
+  return sh;
+#endif
+}
 
 /******************************************************************************
-Function `cfgcli_is_set`:
-  Check if a variable is set via the command line or files.
+Function `cfgcli_shared_find`:
+  Search for a parameter in a shared segment given its name.
 Arguments:
-  * `cfg`:      entry of all configurations;
-  * `var`:      address of the variable.
+  * `sh`:       the attached segment;
+  * `name`:     the null terminated name of the parameter.
 Return:
-  True if the variable is set; false otherwise.
+  Address of the parameter if it is found with a valid value; NULL otherwise.
 ******************************************************************************/
-bool cfgcli_is_set(const cfgcli_t *cfg, const void *var) {
-  if (!cfg || !var || !cfg->npar) return false;
-  for (int i = 0; i < cfg->npar; i++) {
-    cfgcli_param_valid_t *par = (cfgcli_param_valid_t *) cfg->params + i;
-    if (par->var == var) {
-      if (par->src != CFGCLI_SRC_NULL) return true;
-      break;
-    }
+static const cfgcli_shared_entry_t *cfgcli_shared_find(
+    const cfgcli_shared_t *sh, const char *name) {
+  if (!sh || !name) return NULL;
+  const cfgcli_shared_head_t *head = (const cfgcli_shared_head_t *) sh->base;
+  const uint32_t *slots = (const uint32_t *) (sh->base + head->slot);
+  const cfgcli_shared_entry_t *entry =
+    (const cfgcli_shared_entry_t *) (sh->base + head->entry);
+  const size_t len = strlen(name);
+  const uint64_t hash = cfgcli_hash(name, len);
+  uint64_t h = hash & (head->nslot - 1);
+
+  for (uint64_t i = 0; i < head->nslot && slots[h]; i++) {
+    const cfgcli_shared_entry_t *e = entry + slots[h] - 1;
+    if (slots[h] <= head->npar && e->hash == hash && e->name < sh->size &&
+        len < sh->size - e->name && !memcmp(sh->base + e->name, name, len + 1))
+      return (e->value <= sh->size && e->len <= sh->size - e->value) ?
+        e : NULL;
+    h = (h + 1) & (head->nslot - 1);
   }
-  return false;
+  return NULL;
 }
 
 /******************************************************************************
-Function `cfgcli_get_size`:
-  Return the number of elements for the parsed array.
+Function `cfgcli_shared_fits`:
+  Check if the value of a parameter in a shared segment is aligned, and has
+  enough bytes for the number of elements of its data type.
 Arguments:
-  * `cfg`:      entry of all configurations;
-  * `var`:      address of the variable.
+  * `e`:        the parameter, with a value inside the segment.
 Return:
-  The number of array elements on success; 0 on error.
+  True if the value can be read; false otherwise.
 ******************************************************************************/
-int cfgcli_get_size(const cfgcli_t *cfg, const void *var) {
-  if (!cfg || !var || !cfg->npar) return 0;
-  for (int i = 0; i < cfg->npar; i++) {
-    cfgcli_param_valid_t *par = (cfgcli_param_valid_t *) cfg->params + i;
-    if (par->var == var) {
-      if (par->src != CFGCLI_SRC_NULL) return par->narr;
-      break;
-    }
+static bool cfgcli_shared_fits(const cfgcli_shared_entry_t *e) {
+  const cfgcli_dtype_t dtype = (cfgcli_dtype_t) e->dtype;
+  uint64_t num = e->narr;
+  size_t size;
+  if (e->value % sizeof(uint64_t)) return false;
+  if (dtype == CFGCLI_ARRAY_BITS) {
+    num = (num >> 6) + ((num & 63) != 0);
+    size = sizeof(uint64_t);
   }
-  return 0;
+  else if (dtype == CFGCLI_ARRAY_STR || dtype == CFGCLI_ARRAY_STRV)
+    size = 2 * sizeof(uint64_t);                /* offsets and lengths */
+  else if (dtype == CFGCLI_DTYPE_BLOB) size = 1;
+  else if (CFGCLI_DTYPE_IS_ARRAY(dtype)) size = cfgcli_dtype_size(dtype);
+  else {
+    num = 1;
+    size = cfgcli_dtype_size(dtype);
+  }
+  return size && num <= e->len / size;
+}
+
+/******************************************************************************
+Function `cfgcli_shared_get`:
+  Retrieve the value of a parameter from a shared segment.
+Arguments:
+  * `sh`:       the attached segment;
+  * `name`:     name of the parameter;
+  * `dtype`:    data type of the parameter, as registered;
+  * `num`:      number of array elements, bits, bytes of blobs, or characters
+                of strings; 1 for other scalars; unused if NULL.
+Return:
+  Address of the value in the segment; NULL if the parameter is not set, or
+  on error.
+******************************************************************************/
+const void *cfgcli_shared_get(const cfgcli_shared_t *sh, const char *name,
+    const cfgcli_dtype_t dtype, size_t *num) {
+  const cfgcli_shared_entry_t *e = cfgcli_shared_find(sh, name);
+  if (!e || e->dtype != (int32_t) dtype) return NULL;
+  if (dtype == CFGCLI_DTYPE_STR || dtype == CFGCLI_DTYPE_STRV) {
+    if (e->len == sh->size - e->value || sh->base[e->value + e->len] != '\0')
+      return NULL;                                      /* no ending '\0' */
+  }
+  else if (!cfgcli_shared_fits(e)) return NULL;
+  if (num) {
+    if (dtype == CFGCLI_DTYPE_STR || dtype == CFGCLI_DTYPE_STRV) *num = e->len;
+    else if (CFGCLI_DTYPE_IS_ARRAY(dtype) || dtype == CFGCLI_DTYPE_BLOB)
+      *num = e->narr;
+    else *num = 1;
+  }
+  return sh->base + e->value;
+}
+
+/******************************************************************************
+Function `cfgcli_shared_str`:
+  Retrieve an element of a string array from a shared segment.
+Arguments:
+  * `sh`:       the attached segment;
+  * `name`:     name of the parameter;
+  * `idx`:      index of the element;
+  * `len`:      number of characters of the element; unused if NULL.
+Return:
+  Address of the null terminated element; NULL if the parameter is not set,
+  or on error.
+******************************************************************************/
+const char *cfgcli_shared_str(const cfgcli_shared_t *sh, const char *name,
+    const size_t idx, size_t *len) {
+  const cfgcli_shared_entry_t *e = cfgcli_shared_find(sh, name);
+  if (!e || (e->dtype != CFGCLI_ARRAY_STR && e->dtype != CFGCLI_ARRAY_STRV) ||
+      idx >= e->narr || !cfgcli_shared_fits(e)) return NULL;
+  const uint64_t *tab = (const uint64_t *) (sh->base + e->value);
+  if (tab[2 * idx] > sh->size || tab[2 * idx + 1] >= sh->size - tab[2 * idx])
+    return NULL;
+  if (len) *len = tab[2 * idx + 1];
+  return sh->base + tab[2 * idx];
+}
+
+/******************************************************************************
+Function `cfgcli_shared_shape`:
+  Retrieve the shape of a multi-dimensional array from a shared segment.
+Arguments:
+  * `sh`:       the attached segment;
+  * `name`:     name of the parameter;
+  * `shape`:    array of at least `CFGCLI_MAX_NDIM` elements for the length
+                of every dimension.
+Return:
+  Number of dimensions on success; 0 if the array is not set, or on error.
+******************************************************************************/
+int cfgcli_shared_shape(const cfgcli_shared_t *sh, const char *name,
+    size_t *shape) {
+  const cfgcli_shared_entry_t *e = cfgcli_shared_find(sh, name);
+  if (!e || !shape || !CFGCLI_DTYPE_IS_NDARRAY(e->dtype) || e->ndim <= 0 ||
+      e->ndim > CFGCLI_MAX_NDIM || e->shape > sh->size ||
+      e->ndim * sizeof(size_t) > sh->size - e->shape) return 0;
+  memcpy(shape, sh->base + e->shape, e->ndim * sizeof(size_t));
+  return e->ndim;
+}
+
+/******************************************************************************
+Function `cfgcli_shared_detach`:
+  Unmap a shared segment.
+Arguments:
+  * `sh`:       the attached segment.
+******************************************************************************/
+void cfgcli_shared_detach(cfgcli_shared_t *sh) {
+  if (!sh) return;
+#ifdef HAVE_MMAP
+  munmap((void *) sh->base, sh->size);
+#endif
+  free(sh);
 }
 
 
@@ -1596,8 +7597,58 @@ Arguments:
 ******************************************************************************/
 void cfgcli_destroy(cfgcli_t *cfg) {
   if (!cfg) return;
-  if (cfg->npar) free(cfg->params);
-  if (cfg->nfunc) free(cfg->funcs);
+  for (int i = 0; i < cfg->npar; i++) {
+    cfgcli_check_valid_t *chk = (cfgcli_check_valid_t *)
+      ((cfgcli_param_valid_t *) cfg->params)[i].check;
+    if (chk) free(chk->set);
+    free(chk);
+  }
+  free(cfg->params);
+  free(cfg->funcs);
+  free(cfg->cmds);
+  if (cfg->lopts) {
+    free(((cfgcli_trie_t *) cfg->lopts)->node);
+    free(cfg->lopts);
+  }
+  if (cfg->index) {
+    free(((cfgcli_index_t *) cfg->index)->node);
+    free(((cfgcli_index_t *) cfg->index)->slot);
+    free(cfg->index);
+  }
+  cfgcli_include_t *inc = (cfgcli_include_t *) cfg->includes;
+  while (inc) {
+    cfgcli_include_t *next = inc->next;
+    cfgcli_include_free(inc);
+    inc = next;
+  }
+  if (cfg->intern) {
+    free(((cfgcli_intern_t *) cfg->intern)->slot);
+    free(cfg->intern);
+  }
+  if (cfg->defer) {
+    cfgcli_defer_t *def = (cfgcli_defer_t *) cfg->defer;
+    for (int i = 0; i < def->max; i++)
+      if (def->rec[i].owned) free(def->rec[i].value);
+    free(def->rec);
+    free(cfg->defer);
+  }
+  cfgcli_map_t *map = (cfgcli_map_t *) cfg->maps;
+  while (map) {
+    cfgcli_map_t *next = map->next;
+#ifdef HAVE_MMAP
+    munmap(map->addr, map->len);
+#else
+    free(map->addr);
+#endif
+    free(map);
+    map = next;
+  }
+  cfgcli_block_t *block = (cfgcli_block_t *) cfg->blocks;
+  while (block) {
+    cfgcli_block_t *next = block->next;
+    free(block);
+    block = next;
+  }
   cfgcli_error_t *err = cfg->error;
   if (err->max) free(err->msg);
   free(cfg->error);
@@ -34,6 +34,7 @@
 
 #include <stdio.h>
 #include <stdbool.h>
+#include <stdint.h>
 
 /*============================================================================*\
                            Definitions for data types
@@ -54,11 +55,45 @@ typedef enum {
   CFGCLI_ARRAY_LONG,
   CFGCLI_ARRAY_FLT,
   CFGCLI_ARRAY_DBL,
-  CFGCLI_ARRAY_STR
+  CFGCLI_ARRAY_STR,
+  CFGCLI_DTYPE_STRV,
+  CFGCLI_ARRAY_STRV,
+  CFGCLI_DTYPE_INT8,
+  CFGCLI_DTYPE_INT16,
+  CFGCLI_DTYPE_INT32,
+  CFGCLI_DTYPE_INT64,
+  CFGCLI_DTYPE_UINT8,
+  CFGCLI_DTYPE_UINT16,
+  CFGCLI_DTYPE_UINT32,
+  CFGCLI_DTYPE_UINT64,
+  CFGCLI_DTYPE_SIZE,
+  CFGCLI_ARRAY_INT8,
+  CFGCLI_ARRAY_INT16,
+  CFGCLI_ARRAY_INT32,
+  CFGCLI_ARRAY_INT64,
+  CFGCLI_ARRAY_UINT8,
+  CFGCLI_ARRAY_UINT16,
+  CFGCLI_ARRAY_UINT32,
+  CFGCLI_ARRAY_UINT64,
+  CFGCLI_ARRAY_SIZE,
+  CFGCLI_ARRAY_BITS,
+  CFGCLI_NDARRAY_INT,
+  CFGCLI_NDARRAY_LONG,
+  CFGCLI_NDARRAY_FLT,
+  CFGCLI_NDARRAY_DBL,
+  CFGCLI_DTYPE_BLOB
 } cfgcli_dtype_t;
 
-#define CFGCLI_DTYPE_INVALID(x)    ((x) < CFGCLI_DTYPE_BOOL || (x) > CFGCLI_ARRAY_STR)
-#define CFGCLI_DTYPE_IS_ARRAY(x)   ((x) >= CFGCLI_ARRAY_BOOL && (x) <= CFGCLI_ARRAY_STR)
+#define CFGCLI_DTYPE_INVALID(x)    ((x) < CFGCLI_DTYPE_BOOL || (x) > CFGCLI_DTYPE_BLOB)
+#define CFGCLI_DTYPE_IS_ARRAY(x)   (((x) >= CFGCLI_ARRAY_BOOL && (x) <= CFGCLI_ARRAY_STR) \
+                                   || (x) == CFGCLI_ARRAY_STRV                       \
+                                   || ((x) >= CFGCLI_ARRAY_INT8 && (x) <= CFGCLI_NDARRAY_DBL))
+#define CFGCLI_DTYPE_IS_NDARRAY(x) ((x) >= CFGCLI_NDARRAY_INT && (x) <= CFGCLI_NDARRAY_DBL)
+
+/* Access bit-packed boolean arrays, with 64 elements per `uint64_t` word. */
+#define CFGCLI_BITS_NWORD(n)       (((n) + 63) >> 6)
+#define CFGCLI_BITS_TEST(a,i)      ((bool) (((a)[(i) >> 6] >> ((i) & 63)) & 1))
+#define CFGCLI_DTYPE_IS_VIEW(x)    ((x) == CFGCLI_DTYPE_STRV || (x) == CFGCLI_ARRAY_STRV)
 
 /*============================================================================*\
                          Definitions for string lengths
@@ -67,6 +102,9 @@ typedef enum {
 #define CFGCLI_MAX_LOPT_LEN        128
 #define CFGCLI_MAX_HELP_LEN        1024
 #define CFGCLI_MAX_FILENAME_LEN    1024
+#define CFGCLI_MAX_NDIM            8
+#define CFGCLI_PARALLEL_MIN_ELEM   65536
+#define CFGCLI_FINGERPRINT_SIZE    32
 
 /*============================================================================*\
                           Definitions for the formats
@@ -77,6 +115,10 @@ typedef enum {
 #define CFGCLI_SYM_ARRAY_SEP       ','
 #define CFGCLI_SYM_COMMENT         '#'
 #define CFGCLI_SYM_NEWLINE         '\\'
+#define CFGCLI_SYM_INCLUDE         "include"
+#define CFGCLI_SYM_SECTION_START   '['
+#define CFGCLI_SYM_SECTION_END     ']'
+#define CFGCLI_SYM_SECTION_SEP     '.'
 
 #define CFGCLI_CMD_FLAG            '-'
 #define CFGCLI_CMD_ASSIGN          '='
@@ -90,11 +132,63 @@ typedef enum {
 typedef struct {
   int npar;             /* number of verified configuration parameters  */
   int nfunc;            /* number of verified command line functions    */
+  int ncmd;             /* number of pending subcommands                */
+  int nthread;          /* number of threads for converting arrays      */
   void *params;         /* data structure for storing parameters        */
   void *funcs;          /* data structure for storing function pointers */
+  void *cmds;           /* data structure for storing subcommands       */
+  const char *cmd;      /* name of the selected subcommand              */
   void *error;          /* data structure for storing error messages    */
+  void *blocks;         /* memory kept until the entry is destroyed     */
+  void *intern;         /* table of interned strings                    */
+  void *includes;       /* cached tokens of included files              */
+  void *index;          /* index of the dotted parameter names          */
+  void *lopts;          /* trie of the long command line options        */
+  void *defer;          /* raw values recorded for deferred conversion  */
+  void *maps;           /* memory-mapped response files                 */
+  uint64_t fprint[4];   /* sum of the digests of all set parameters     */
 } cfgcli_t;
 
+/* String view pointing to a value in the source of the configurations. */
+typedef struct {
+  const char *ptr;              /* first character of the value         */
+  size_t len;                   /* number of characters of the value    */
+} cfgcli_strview_t;
+
+/* Callback receiving batches of converted array elements, in order.
+   String elements are passed as `char *`, valid only during the call. */
+typedef int (*cfgcli_sink_t) (const void *elems, const size_t num, void *arg);
+
+/* Flags of constraints on numeric values, checked during conversions. */
+#define CFGCLI_CHECK_MIN           1    /* not smaller than `min`           */
+#define CFGCLI_CHECK_MAX           2    /* not larger than `max`            */
+#define CFGCLI_CHECK_NOT_NAN       4    /* not NaN                          */
+#define CFGCLI_CHECK_INCREASING    8    /* non-decreasing array elements    */
+#define CFGCLI_CHECK_DECREASING    16   /* non-increasing array elements    */
+#define CFGCLI_CHECK_SET           32   /* one of the allowed values        */
+
+/* Constraints on the values of a numeric parameter. */
+typedef struct {
+  int flags;                    /* combination of CFGCLI_CHECK_* flags  */
+  double min;                   /* inclusive lower bound                */
+  double max;                   /* inclusive upper bound                */
+  const double *set;            /* allowed values                       */
+  size_t nset;                  /* number of allowed values             */
+} cfgcli_check_t;
+
+/* Loader reading configuration files asynchronously. */
+typedef struct cfgcli_loader_struct cfgcli_loader_t;
+
+/* Read-only segment of configurations shared between processes. */
+typedef struct cfgcli_shared_struct cfgcli_shared_t;
+
+/* Kinds of differences between parameters of two configurations. */
+typedef enum {
+  CFGCLI_DIFF_ADDED,            /* set only in the second configuration     */
+  CFGCLI_DIFF_REMOVED,          /* set only in the first configuration      */
+  CFGCLI_DIFF_CHANGED           /* set in both, with different values       */
+} cfgcli_diff_t;
+
 /* Interface for registering configuration parameters. */
 typedef struct {
   int opt;                      /* short command line option            */
@@ -114,6 +208,14 @@ typedef struct {
   char *help;                   /* help message                         */
 } cfgcli_func_t;
 
+/* Interface for registering subcommands. */
+typedef struct {
+  char *name;                   /* name of the subcommand               */
+  int (*func) (cfgcli_t *, void *);     /* registration of its options  */
+  void *args;                   /* pointer to the arguments             */
+  char *help;                   /* help message                         */
+} cfgcli_cmd_t;
+
 
 /*============================================================================*\
                             Definition of functions
@@ -151,9 +253,127 @@ Return:
 ******************************************************************************/
 int cfgcli_set_funcs(cfgcli_t *cfg, const cfgcli_func_t *func, const int nfunc);
 
+/******************************************************************************
+Function `cfgcli_set_cmds`:
+  Verify and register subcommands. The registration function of a
+  subcommand is called by `cfgcli_read_opts` only when the subcommand is
+  selected, and may register parameters, functions, or further subcommands.
+Arguments:
+  * `cfg`:      entry for all subcommands;
+  * `cmd`:      stucture for the input subcommands;
+  * `ncmd`:     number of input subcommands.
+Return:
+  Zero on success; non-zero on error.
+******************************************************************************/
+int cfgcli_set_cmds(cfgcli_t *cfg, const cfgcli_cmd_t *cmd, const int ncmd);
+
+/******************************************************************************
+Function `cfgcli_get_cmd`:
+  Get the name of the innermost subcommand selected from the command line.
+Arguments:
+  * `cfg`:      entry for all subcommands.
+Return:
+  The name of the subcommand; NULL if no subcommand is selected.
+******************************************************************************/
+const char *cfgcli_get_cmd(const cfgcli_t *cfg);
+
+/******************************************************************************
+Function `cfgcli_set_intern`:
+  Enable or disable the interning of string values. Once enabled, identical
+  values of string variables and string array elements share the same
+  address, and are owned by `cfg`: they must not be freed, and are released
+  by `cfgcli_destroy`. Arrays of strings are still allocated for the caller.
+Arguments:
+  * `cfg`:      entry for the configurations;
+  * `intern`:   true for enabling string interning.
+Return:
+  Zero on success; non-zero on error.
+******************************************************************************/
+int cfgcli_set_intern(cfgcli_t *cfg, const bool intern);
+
+/******************************************************************************
+Function `cfgcli_set_deferred`:
+  Enable or disable deferred value conversion. Once enabled, values read by
+  the `cfgcli_read_*` functions are only recorded with their priorities, and
+  each parameter is converted from the value with the highest priority by
+  `cfgcli_resolve`. Variables are untouched until then, but `cfgcli_is_set`
+  already reports the parameters with recorded values.
+Arguments:
+  * `cfg`:      entry for the configurations;
+  * `defer`:    true for recording values until `cfgcli_resolve` is called.
+Return:
+  Zero on success; non-zero on error.
+******************************************************************************/
+int cfgcli_set_deferred(cfgcli_t *cfg, const bool defer);
+
+/******************************************************************************
+Function `cfgcli_resolve`:
+  Convert the values recorded with deferred value conversion, and release
+  the records. Values of buffers and command line options are not copied
+  while recorded, so they must be valid until this function is called.
+Arguments:
+  * `cfg`:      entry for the configurations.
+Return:
+  Zero on success; non-zero on error.
+******************************************************************************/
+int cfgcli_resolve(cfgcli_t *cfg);
+
+/******************************************************************************
+Function `cfgcli_set_threads`:
+  Set the number of threads for converting arrays with at least
+  `CFGCLI_PARALLEL_MIN_ELEM` elements. Conversions are sequential if the
+  library is built without POSIX threads.
+Arguments:
+  * `cfg`:      entry for the configurations;
+  * `nthread`:  number of threads, 1 or 0 for sequential conversions.
+Return:
+  Zero on success; non-zero on error.
+******************************************************************************/
+int cfgcli_set_threads(cfgcli_t *cfg, const int nthread);
+
+/******************************************************************************
+Function `cfgcli_set_sink`:
+  Attach a callback to an array parameter, which receives the converted
+  elements in batches instead of the variable. The elements are not kept
+  by the library, and the variable is not assigned.
+Arguments:
+  * `cfg`:      entry for the configurations;
+  * `var`:      address of the registered variable;
+  * `func`:     the callback, which returns non-zero to reject the elements,
+                or NULL to assign the array to the variable again;
+  * `arg`:      the argument passed to the callback.
+Return:
+  Zero on success; non-zero on error.
+******************************************************************************/
+int cfgcli_set_sink(cfgcli_t *cfg, const void *var, cfgcli_sink_t func,
+    void *arg);
+
+/******************************************************************************
+Function `cfgcli_set_check`:
+  Attach constraints to a numeric parameter, which are checked for the
+  scalar value or every array element once it is converted. Violations are
+  reported as errors, with the index of the first invalid array element.
+Arguments:
+  * `cfg`:      entry for the configurations;
+  * `var`:      address of the registered variable;
+  * `check`:    the constraints, which are copied, or NULL for removing the
+                constraints; NaN is not allowed in `set`.
+Return:
+  Zero on success; non-zero on error.
+******************************************************************************/
+int cfgcli_set_check(cfgcli_t *cfg, const void *var,
+    const cfgcli_check_t *check);
+
 /******************************************************************************
 Function `cfgcli_read_opts`:
-  Parse command line options.
+  Parse command line options. Arguments in the form of `@path` are replaced
+  by the whitespace-separated arguments in the response file `path`, and
+  the files are kept in memory until `cfg` is destroyed. If subcommands are
+  registered, the first non-option argument selects one of them, and its
+  options are registered and parsed from the following arguments. `argv`
+  is never written to: scalar values are converted from the arguments
+  directly, while array values are copied once before their elements are
+  separated.
 Arguments:
   * `cfg`:      entry for the configurations;
   * `argc`:     number of arguments passed via command line;
@@ -168,7 +388,9 @@ int cfgcli_read_opts(cfgcli_t *cfg, const int argc, char *const *argv,
 
 /******************************************************************************
 Function `cfgcli_read_file`:
-  Read configuration parameters from a file.
+  Read configuration parameters from a file. Files included with the
+  `include "path"` directive are cached by `cfg`, and read again only if
+  they are modified.
 Arguments:
   * `cfg`:      entry for the configurations;
   * `fname`:    name of the input file;
@@ -178,6 +400,212 @@ Return:
 ******************************************************************************/
 int cfgcli_read_file(cfgcli_t *cfg, const char *fname, const int prior);
 
+/******************************************************************************
+Function `cfgcli_read_buffer`:
+  Read configuration parameters from a resident buffer, with the format of
+  configuration files. The buffer is modified in place, and string views
+  point to its content, so it must be valid as long as the views are used.
+Arguments:
+  * `cfg`:      entry for the configurations;
+  * `buf`:      the buffer, parsed until `len` characters or the first '\0';
+  * `len`:      length of the buffer;
+  * `prior`:    priority of values read from this buffer.
+Return:
+  Zero on success; non-zero on error.
+******************************************************************************/
+int cfgcli_read_buffer(cfgcli_t *cfg, char *buf, const size_t len,
+    const int prior);
+
+/******************************************************************************
+Function `cfgcli_read_files`:
+  Read configuration parameters from multiple files, with all the files
+  opened and read concurrently, and parsed in the order of `fname`.
+Arguments:
+  * `cfg`:      entry for the configurations;
+  * `fname`:    names of the input files;
+  * `prior`:    priorities of values read from the files;
+  * `nfile`:    number of files.
+Return:
+  Zero on success; non-zero on error.
+******************************************************************************/
+int cfgcli_read_files(cfgcli_t *cfg, const char *const *fname,
+    const int *prior, const int nfile);
+
+/******************************************************************************
+Function `cfgcli_load_files`:
+  Start reading configuration files asynchronously, with io_uring if it is
+  available. The files are parsed by `cfgcli_load_poll`.
+Arguments:
+  * `cfg`:      entry for the configurations;
+  * `fname`:    names of the input files;
+  * `prior`:    priorities of values read from the files;
+  * `nfile`:    number of files.
+Return:
+  The loader on success; NULL on error.
+******************************************************************************/
+cfgcli_loader_t *cfgcli_load_files(cfgcli_t *cfg, const char *const *fname,
+    const int *prior, const int nfile);
+
+/******************************************************************************
+Function `cfgcli_load_fd`:
+  Get the file descriptor that is readable when `cfgcli_load_poll` can make
+  progress without blocking, for event loops.
+Arguments:
+  * `ld`:       the loader.
+Return:
+  The file descriptor; -1 if files are read with blocking calls.
+******************************************************************************/
+int cfgcli_load_fd(const cfgcli_loader_t *ld);
+
+/******************************************************************************
+Function `cfgcli_load_poll`:
+  Process completed reads, and parse the files that are read completely,
+  in the order of the file names. Without io_uring, one file is read with
+  blocking calls and parsed per call, unless `wait` is true.
+Arguments:
+  * `ld`:       the loader;
+  * `wait`:     true for waiting until all files are parsed.
+Return:
+  Number of files not parsed yet; negative error code on error.
+******************************************************************************/
+int cfgcli_load_poll(cfgcli_loader_t *ld, const bool wait);
+
+/******************************************************************************
+Function `cfgcli_load_free`:
+  Wait for outstanding reads, and release the loader.
+Arguments:
+  * `ld`:       the loader.
+******************************************************************************/
+void cfgcli_load_free(cfgcli_loader_t *ld);
+
+/******************************************************************************
+Function `cfgcli_read_env`:
+  Read configuration parameters from environment variables, named by the
+  prefix followed by the parameter names in upper case, with '.' and '-'
+  replaced by '_'. Empty variables are omitted.
+Arguments:
+  * `cfg`:      entry for the configurations;
+  * `prefix`:   prefix of the variable names, NULL for no prefix;
+  * `prior`:    priority of values read from the environment.
+Return:
+  Zero on success; non-zero on error.
+******************************************************************************/
+int cfgcli_read_env(cfgcli_t *cfg, const char *prefix, const int prior);
+
+/******************************************************************************
+Function `cfgcli_write_buffer`:
+  Write the values of all set parameters in the configuration file format,
+  which can be read again by `cfgcli_read_file` or `cfgcli_read_buffer`.
+  Deferred values are converted first. Strings with line breaks, or with
+  both kinds of quotation marks and symbols of the format, cannot be
+  represented, and are omitted with a warning.
+Arguments:
+  * `cfg`:      entry for the configurations;
+  * `buf`:      address of the null terminated output, to be released by
+                `free`;
+  * `len`:      length of the output, NOT including the ending '\0'.
+Return:
+  Zero on success; non-zero on error.
+******************************************************************************/
+int cfgcli_write_buffer(cfgcli_t *cfg, char **buf, size_t *len);
+
+/******************************************************************************
+Function `cfgcli_write_file`:
+  Write the values of all set parameters to a file in the configuration
+  file format, with a single write operation.
+Arguments:
+  * `cfg`:      entry for the configurations;
+  * `fname`:    name of the output file.
+Return:
+  Zero on success; non-zero on error.
+******************************************************************************/
+int cfgcli_write_file(cfgcli_t *cfg, const char *fname);
+
+/******************************************************************************
+Function `cfgcli_shared_export`:
+  Write the values of all set parameters, and the index of their names, into
+  a position-independent segment in memory, which can be attached by other
+  processes that inherit or receive the file descriptor. Deferred values are
+  converted first, and arrays with element sinks are not exported. The
+  segment is sealed against modifications if memfd is available, and
+  requires POSIX shared memory otherwise.
+Arguments:
+  * `cfg`:      entry for the configurations.
+Return:
+  File descriptor of the segment on success, to be closed by the caller;
+  negative error code on error.
+******************************************************************************/
+int cfgcli_shared_export(cfgcli_t *cfg);
+
+/******************************************************************************
+Function `cfgcli_shared_attach`:
+  Map a segment written by `cfgcli_shared_export` read-only, without parsing
+  or copying the values.
+Arguments:
+  * `fd`:       file descriptor of the segment, which can be closed after
+                this function.
+Return:
+  The attached segment on success; NULL on error.
+******************************************************************************/
+cfgcli_shared_t *cfgcli_shared_attach(const int fd);
+
+/******************************************************************************
+Function `cfgcli_shared_get`:
+  Retrieve the value of a parameter from a shared segment. Values are read
+  in place, so strings and arrays must not be modified, and are valid until
+  the segment is detached.
+Arguments:
+  * `sh`:       the attached segment;
+  * `name`:     name of the parameter;
+  * `dtype`:    data type of the parameter, as registered;
+  * `num`:      number of array elements, bits, bytes of blobs, or characters
+                of strings; 1 for other scalars; unused if NULL.
+Return:
+  Address of the value, which is the null terminated characters for strings
+  and string views, the first element for arrays, and an opaque address for
+  string arrays, whose elements are retrieved by `cfgcli_shared_str`; NULL
+  if the parameter is not set, or its data type does not match.
+******************************************************************************/
+const void *cfgcli_shared_get(const cfgcli_shared_t *sh, const char *name,
+    const cfgcli_dtype_t dtype, size_t *num);
+
+/******************************************************************************
+Function `cfgcli_shared_str`:
+  Retrieve an element of a string array from a shared segment.
+Arguments:
+  * `sh`:       the attached segment;
+  * `name`:     name of the parameter;
+  * `idx`:      index of the element;
+  * `len`:      number of characters of the element; unused if NULL.
+Return:
+  Address of the null terminated element; NULL if the parameter is not set,
+  or on error.
+******************************************************************************/
+const char *cfgcli_shared_str(const cfgcli_shared_t *sh, const char *name,
+    const size_t idx, size_t *len);
+
+/******************************************************************************
+Function `cfgcli_shared_shape`:
+  Retrieve the shape of a multi-dimensional array from a shared segment.
+Arguments:
+  * `sh`:       the attached segment;
+  * `name`:     name of the parameter;
+  * `shape`:    array of at least `CFGCLI_MAX_NDIM` elements for the length
+                of every dimension, with the last one varying fastest.
+Return:
+  Number of dimensions on success; 0 if the array is not set, or on error.
+******************************************************************************/
+int cfgcli_shared_shape(const cfgcli_shared_t *sh, const char *name,
+    size_t *shape);
+
+/******************************************************************************
+Function `cfgcli_shared_detach`:
+  Unmap a shared segment.
+Arguments:
+  * `sh`:       the attached segment.
+******************************************************************************/
+void cfgcli_shared_detach(cfgcli_shared_t *sh);
+
 /******************************************************************************
 Function `cfgcli_is_set`:
   Check if a variable is set via the command line or files.
@@ -196,10 +624,135 @@ Arguments:
   * `cfg`:      entry of all configurations;
   * `var`:      address of the variable.
 Return:
-  The number of array elements on success; 0 on error.
+  The number of array elements on success; 0 on error, or if the number
+  cannot be represented by an int (see `cfgcli_get_array_size`).
 ******************************************************************************/
 int cfgcli_get_size(const cfgcli_t *cfg, const void *var);
 
+/******************************************************************************
+Function `cfgcli_get_array_size`:
+  Return the number of elements for the parsed array, without the limit of
+  the int type.
+Arguments:
+  * `cfg`:      entry of all configurations;
+  * `var`:      address of the variable.
+Return:
+  The number of array elements on success; 0 on error.
+******************************************************************************/
+size_t cfgcli_get_array_size(const cfgcli_t *cfg, const void *var);
+
+/******************************************************************************
+Function `cfgcli_get_shape`:
+  Return the shape of a parsed multi-dimensional array.
+Arguments:
+  * `cfg`:      entry of all configurations;
+  * `var`:      address of the variable;
+  * `shape`:    array of at least `CFGCLI_MAX_NDIM` elements for the length
+                of every dimension, with the last one varying fastest.
+Return:
+  Number of dimensions on success; 0 on error, or if the array is not set.
+******************************************************************************/
+int cfgcli_get_shape(const cfgcli_t *cfg, const void *var, size_t *shape);
+
+/******************************************************************************
+Function `cfgcli_get_var`:
+  Retrieve the value of a parameter given its name. If conversions are
+  deferred, the recorded value is converted on first access, and the result
+  is kept in the registered variable for later accesses. Strings and arrays
+  are retrieved by address, and not copied.
+Arguments:
+  * `cfg`:      entry of all configurations;
+  * `name`:     name of the parameter;
+  * `dtype`:    data type of the parameter, as registered;
+  * `out`:      address of the variable for the value.
+Return:
+  Zero on success; positive if the parameter is not set; negative on error.
+******************************************************************************/
+int cfgcli_get_var(cfgcli_t *cfg, const char *name, const cfgcli_dtype_t dtype,
+    void *out);
+
+/* Typed shortcuts of `cfgcli_get_var` for scalar parameters. */
+int cfgcli_get_bool(cfgcli_t *cfg, const char *name, bool *out);
+int cfgcli_get_char(cfgcli_t *cfg, const char *name, char *out);
+int cfgcli_get_int(cfgcli_t *cfg, const char *name, int *out);
+int cfgcli_get_long(cfgcli_t *cfg, const char *name, long *out);
+int cfgcli_get_flt(cfgcli_t *cfg, const char *name, float *out);
+int cfgcli_get_dbl(cfgcli_t *cfg, const char *name, double *out);
+int cfgcli_get_str(cfgcli_t *cfg, const char *name, char **out);
+
+/******************************************************************************
+Function `cfgcli_foreach_param`:
+  Call a function for all parameters in a section, i.e., parameters named
+  `section` or `section.*`. The cost is proportional to the section size.
+Arguments:
+  * `cfg`:      entry of all configurations;
+  * `section`:  name of the section, NULL or "" for all parameters;
+  * `func`:     function called with the name and variable of parameters,
+                a non-zero return value stops the iteration;
+  * `arg`:      argument passed to the function.
+Return:
+  Zero if all parameters are visited; the non-zero value returned by `func`;
+  or non-zero if the section is not registered.
+******************************************************************************/
+int cfgcli_foreach_param(const cfgcli_t *cfg, const char *section,
+    int (*func) (const char *name, void *var, void *arg), void *arg);
+
+/******************************************************************************
+Function `cfgcli_diff`:
+  Report parameters that differ between two configurations with the same
+  parameter names. Values are compared by hashes computed on conversion,
+  and contents are only compared if the hashes agree. Deferred values of
+  parameters set in both configurations are converted first.
+Arguments:
+  * `a`:        entry of the first configurations;
+  * `b`:        entry of the second configurations;
+  * `func`:     function called with the name, the kind of the difference,
+                and the sources of the value in both configurations, which
+                are the priorities, negative for command line options, or
+                0 if the value is not set; a non-zero return value stops
+                the comparison;
+  * `arg`:      argument passed to the function.
+Return:
+  Zero if all differences are reported; the non-zero value returned by
+  `func`; or non-zero on error.
+******************************************************************************/
+int cfgcli_diff(cfgcli_t *a, cfgcli_t *b,
+    int (*func) (const char *name, const cfgcli_diff_t kind, const int src_a,
+      const int src_b, void *arg), void *arg);
+
+/******************************************************************************
+Function `cfgcli_fingerprint`:
+  Retrieve the fingerprint of the converted values of all set parameters,
+  which does not depend on the order or formatting of the definitions.
+  It is updated whenever a value is converted, and deferred values are
+  converted first.
+Arguments:
+  * `cfg`:      entry of all configurations;
+  * `out`:      the fingerprint, with `CFGCLI_FINGERPRINT_SIZE` bytes.
+Return:
+  Zero on success; non-zero on error.
+******************************************************************************/
+int cfgcli_fingerprint(cfgcli_t *cfg,
+    unsigned char out[CFGCLI_FINGERPRINT_SIZE]);
+
+/******************************************************************************
+Function `cfgcli_reload_section`:
+  Read again the parameters of a section from a file, regardless of their
+  previous sources, and leave other parameters untouched. Values of the
+  section recorded for deferred conversion are dropped, and the previous
+  values are restored if the file cannot be read. Memory of the previous
+  string and array values is not released.
+Arguments:
+  * `cfg`:      entry for the configurations;
+  * `fname`:    name of the input file;
+  * `section`:  name of the section;
+  * `prior`:    priority of values read from this file.
+Return:
+  Zero on success; non-zero on error.
+******************************************************************************/
+int cfgcli_reload_section(cfgcli_t *cfg, const char *fname,
+    const char *section, const int prior);
+
 /******************************************************************************
 Function `cfgcli_destroy`:
   Release memory allocated for the configuration parameters.
@@ -0,0 +1,76 @@
+/*******************************************************************************
+* access.c: tests of accessing parameters by name.
+
+* libcfgcli: C library for parsing command line option and configuration files.
+
+* Gitlab repository:
+        https://framagit.org/groolot-association/libcfgcli
+
+* Copyright (c) 2019 Cheng Zhao <zhaocheng03@gmail.com>
+* Copyright (c) 2023 Gregory David <dev@groolot.net>
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+
+*******************************************************************************/
+
+#include <stdlib.h>
+#include "check.h"
+
+int main(void) {
+  int vint = 0, *aint = NULL, out = 0, *arr = NULL;
+  double vdbl = 0, dout = 0;
+  char *vstr = NULL, *sout = NULL;
+  const cfgcli_param_t params[] = {
+    { 0, NULL, "int",  CFGCLI_DTYPE_INT, &vint, "" },
+    { 0, NULL, "dbl",  CFGCLI_DTYPE_DBL, &vdbl, "" },
+    { 0, NULL, "str",  CFGCLI_DTYPE_STR, &vstr, "" },
+    { 0, NULL, "ints", CFGCLI_ARRAY_INT, &aint, "" }
+  };
+  char buf[] = "int = 3\nstr = abc\nints = [4, 5]\n";
+  cfgcli_t *cfg = cfgcli_init();
+  CHECK(cfg);
+  CHECK(!cfgcli_set_params(cfg, params, 4));
+  CHECK(!cfgcli_set_deferred(cfg, true));
+  CHECK(!cfgcli_read_buffer(cfg, buf, strlen(buf), 1));
+
+  /* Deferred values are converted on first access, and kept. */
+  CHECK(vint == 0 && !vstr);
+  CHECK(!cfgcli_get_int(cfg, "int", &out) && out == 3 && vint == 3);
+  vint = 9;
+  CHECK(!cfgcli_get_int(cfg, "int", &out) && out == 9);
+  CHECK(!cfgcli_get_str(cfg, "str", &sout) && sout == vstr);
+  CHECK(!strcmp(sout, "abc"));
+  CHECK(!cfgcli_get_var(cfg, "ints", CFGCLI_ARRAY_INT, &arr) && arr == aint);
+  CHECK(cfgcli_get_size(cfg, &aint) == 2 && arr[1] == 5);
+
+  /* Unset parameters are reported with a positive value. */
+  CHECK(cfgcli_get_dbl(cfg, "dbl", &dout) > 0);
+
+  /* Data types must match the registered ones. */
+  CHECK(cfgcli_get_dbl(cfg, "int", &dout) < 0);
+  CHECK(check_error(cfg, "data type mismatch for parameter: int"));
+  CHECK(cfgcli_get_var(cfg, "ints", CFGCLI_ARRAY_LONG, &arr) < 0);
+  CHECK(cfgcli_get_int(cfg, "none", &out) < 0);
+  CHECK(check_error(cfg, "unregistered parameter name: none"));
+
+  free(vstr);
+  free(aint);
+  cfgcli_destroy(cfg);
+  return 0;
+}
@@ -0,0 +1,120 @@
+/*******************************************************************************
+* argv.c: tests of command line options in read-only argument lists.
+
+* libcfgcli: C library for parsing command line option and configuration files.
+
+* Gitlab repository:
+        https://framagit.org/groolot-association/libcfgcli
+
+* Copyright (c) 2019 Cheng Zhao <zhaocheng03@gmail.com>
+* Copyright (c) 2023 Gregory David <dev@groolot.net>
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+
+*******************************************************************************/
+
+#include <stdlib.h>
+#include "check.h"
+
+/* Number of command line arguments. */
+#define NARG            8
+
+/* Variables of all tested parameters. */
+typedef struct {
+  bool vbool;
+  int vint;
+  double vdbl;
+  char *vstr;
+  int *aint;
+} vars_t;
+
+/* Register the parameters with the variables in `v`. */
+static cfgcli_t *setup(vars_t *v) {
+  const cfgcli_param_t params[] = {
+    { 'v', "verbose", "verbose", CFGCLI_DTYPE_BOOL, &v->vbool, "" },
+    { 'i', "int",     "int",     CFGCLI_DTYPE_INT,  &v->vint,  "" },
+    { 'd', "dbl",     "dbl",     CFGCLI_DTYPE_DBL,  &v->vdbl,  "" },
+    { 0,   "str",     "str",     CFGCLI_DTYPE_STR,  &v->vstr,  "" },
+    { 0,   "ints",    "ints",    CFGCLI_ARRAY_INT,  &v->aint,  "" }
+  };
+  cfgcli_t *cfg = cfgcli_init();
+  memset(v, 0, sizeof(vars_t));
+  if (cfg && cfgcli_set_params(cfg, params,
+      sizeof(params) / sizeof(params[0]))) {
+    cfgcli_destroy(cfg);
+    return NULL;
+  }
+  return cfg;
+}
+
+/* Parse a single option, and check that it is rejected with `msg`. */
+static int check_invalid(char *opt, char *val, const char *msg) {
+  vars_t v;
+  char *argv[] = {"argv", opt, val};
+  int optidx = 0;
+  cfgcli_t *cfg = setup(&v);
+  CHECK(cfg);
+  CHECK(cfgcli_read_opts(cfg, val ? 3 : 2, argv, 1, &optidx) != 0);
+  CHECK(check_error(cfg, msg));
+  cfgcli_destroy(cfg);
+  return 0;
+}
+
+int main(void) {
+  vars_t v;
+  /* String literals are read-only, so any write to them would crash. */
+  const char *orig[NARG] = {"argv", "--int=5", "-d=2.5", "--str", "a=b",
+    "--ints=[1, 2]", "--", "-vd"};
+  char *argv[NARG];
+  char copy[NARG][16];
+  int optidx = 0;
+  for (int i = 0; i < NARG; i++) {
+    argv[i] = (char *) orig[i];
+    snprintf(copy[i], sizeof(copy[i]), "%s", orig[i]);
+  }
+
+  /* Values are located in place, without modifying the arguments. */
+  cfgcli_t *cfg = setup(&v);
+  CHECK(cfg);
+  CHECK(!cfgcli_read_opts(cfg, NARG, argv, 1, &optidx));
+  CHECK(optidx == NARG - 1);
+  CHECK(v.vint == 5 && v.vdbl == 2.5 && !strcmp(v.vstr, "a=b"));
+  CHECK(cfgcli_get_size(cfg, &v.aint) == 2 && v.aint[1] == 2);
+  for (int i = 0; i < NARG; i++)
+    CHECK(argv[i] == orig[i] && !strcmp(argv[i], copy[i]));
+  free(v.vstr);
+  free(v.aint);
+  cfgcli_destroy(cfg);
+
+  /* Clustered short options are not split, and left as they are. */
+  char *flags[] = {"argv", "-vd", "-i=-7"};
+  CHECK((cfg = setup(&v)));
+  CHECK(!cfgcli_read_opts(cfg, 3, flags, 1, &optidx));
+  CHECK(!v.vbool && v.vint == -7);
+  CHECK(check_error(cfg, "unrecognised command line option: -vd"));
+  CHECK(!strcmp(flags[1], "-vd") && !strcmp(flags[2], "-i=-7"));
+  cfgcli_destroy(cfg);
+
+  /* Integers are converted within the bounds of the values. */
+  const char *msg = "invalid value for parameter: int";
+  CHECK(!check_invalid("--int=2147483648", NULL, msg));
+  CHECK(!check_invalid("-i", "99999999999", msg));
+  CHECK(!check_invalid("--int=5x", NULL, msg));
+  return 0;
+}
@@ -0,0 +1,101 @@
+/*******************************************************************************
+* bits.c: tests of bit-packed boolean arrays.
+
+* libcfgcli: C library for parsing command line option and configuration files.
+
+* Gitlab repository:
+        https://framagit.org/groolot-association/libcfgcli
+
+* Copyright (c) 2019 Cheng Zhao <zhaocheng03@gmail.com>
+* Copyright (c) 2023 Gregory David <dev@groolot.net>
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+
+*******************************************************************************/
+
+#include <stdlib.h>
+#include "check.h"
+
+/* Read a bit array, and check it against the characters '0' and '1' of
+   `expect`, with the first element first. */
+static int check_bits(const char *entry, const char *expect) {
+  uint64_t *bits = NULL;
+  const cfgcli_param_t param = { 0, NULL, "bits", CFGCLI_ARRAY_BITS, &bits,
+    "" };
+  const size_t n = strlen(expect);
+  char buf[1024];
+  cfgcli_t *cfg = cfgcli_init();
+  CHECK(cfg);
+  CHECK(!cfgcli_set_params(cfg, &param, 1));
+  snprintf(buf, sizeof(buf), "bits = %s\n", entry);
+  CHECK(!cfgcli_read_buffer(cfg, buf, strlen(buf), 1));
+  CHECK(cfgcli_get_array_size(cfg, &bits) == n);
+  for (size_t i = 0; i < n; i++)
+    CHECK(CFGCLI_BITS_TEST(bits, i) == (expect[i] == '1'));
+  /* Bits beyond the length are cleared. */
+  for (size_t i = n; i < 64 * CFGCLI_BITS_NWORD(n); i++)
+    CHECK(!CFGCLI_BITS_TEST(bits, i));
+  free(bits);
+  cfgcli_destroy(cfg);
+  return 0;
+}
+
+/* Read a bit array, and check that it is rejected. */
+static int check_invalid(const char *entry) {
+  uint64_t *bits = NULL;
+  const cfgcli_param_t param = { 0, NULL, "bits", CFGCLI_ARRAY_BITS, &bits,
+    "" };
+  char buf[1024];
+  cfgcli_t *cfg = cfgcli_init();
+  CHECK(cfg);
+  CHECK(!cfgcli_set_params(cfg, &param, 1));
+  snprintf(buf, sizeof(buf), "bits = %s\n", entry);
+  CHECK(cfgcli_read_buffer(cfg, buf, strlen(buf), 1) != 0);
+  CHECK(check_error(cfg, "parameter: bits"));
+  free(bits);
+  cfgcli_destroy(cfg);
+  return 0;
+}
+
+int main(void) {
+  /* Lists of boolean values, with 70 elements over two words. */
+  char list[512], expect[80];
+  size_t n = sprintf(list, "[");
+  for (int i = 0; i < 70; i++) {
+    expect[i] = (i % 3 == 0 || i == 69) ? '1' : '0';
+    n += sprintf(list + n, "%s, ", (expect[i] == '1') ? "T" : "false");
+  }
+  expect[70] = '\0';
+  sprintf(list + n - 2, "]");
+  CHECK(!check_bits(list, expect));
+  CHECK(!check_bits("[1, 0, t, true, F]", "10110"));
+
+  /* Literals, with the least significant digit as the first element. */
+  CHECK(!check_bits("0b10110", "01101"));
+  CHECK(!check_bits("0B1", "1"));
+  CHECK(!check_bits("0x1f3", "110011111000"));
+  CHECK(!check_bits("0xA0000000000000001", "100000000000000000000000000000"
+      "00000000000000000000000000000000000101"));
+
+  /* Invalid digits. */
+  CHECK(!check_invalid("0b102"));
+  CHECK(!check_invalid("0x1g"));
+  CHECK(!check_invalid("[1, 2]"));
+  return 0;
+}
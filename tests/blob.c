@@ -0,0 +1,87 @@
+/*******************************************************************************
+* blob.c: tests of binary blobs decoded from hexadecimal or base64.
+
+* libcfgcli: C library for parsing command line option and configuration files.
+
+* Gitlab repository:
+        https://framagit.org/groolot-association/libcfgcli
+
+* Copyright (c) 2019 Cheng Zhao <zhaocheng03@gmail.com>
+* Copyright (c) 2023 Gregory David <dev@groolot.net>
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+
+*******************************************************************************/
+
+#include <stdlib.h>
+#include "check.h"
+
+/* Read a blob, and check its bytes, or that it is rejected if `bytes` is
+   NULL. */
+static int check_blob(const char *value, const void *bytes, const size_t n) {
+  unsigned char *blob = NULL;
+  const cfgcli_param_t param = { 0, NULL, "blob", CFGCLI_DTYPE_BLOB, &blob,
+    "" };
+  char buf[256];
+  cfgcli_t *cfg = cfgcli_init();
+  CHECK(cfg);
+  CHECK(!cfgcli_set_params(cfg, &param, 1));
+  snprintf(buf, sizeof(buf), "blob = %s\n", value);
+  if (bytes) {
+    CHECK(!cfgcli_read_buffer(cfg, buf, strlen(buf), 1));
+    CHECK(cfgcli_get_array_size(cfg, &blob) == n);
+    CHECK(!memcmp(blob, bytes, n));
+  }
+  else {
+    CHECK(cfgcli_read_buffer(cfg, buf, strlen(buf), 1) != 0);
+    CHECK(check_error(cfg, "parameter: blob"));
+  }
+  free(blob);
+  cfgcli_destroy(cfg);
+  return 0;
+}
+
+int main(void) {
+  unsigned char seq[24];
+  for (int i = 0; i < 24; i++) seq[i] = i;
+
+  /* Strings shorter and longer than the 16 characters decoded at once. */
+  CHECK(!check_blob("0x00ff3a", "\x00\xff\x3a", 3));
+  CHECK(!check_blob("0X00FF3A", "\x00\xff\x3a", 3));
+  CHECK(!check_blob("0x000102030405060708090a0b0c0d0e0f1011121314151617",
+      seq, 24));
+  CHECK(!check_blob("AP86", "\x00\xff\x3a", 3));
+  CHECK(!check_blob("AAECAwQFBgcICQoLDA0ODxAREhMUFRYX", seq, 24));
+  CHECK(!check_blob("'AAECAwQFBgcICQoLDA0ODxAREhMUFQ=='", seq, 22));
+  CHECK(!check_blob("-_-_--8=", "\xfb\xff\xbf\xfb\xef", 5));
+  CHECK(!check_blob("+/+/++8", "\xfb\xff\xbf\xfb\xef", 5));
+
+  /* Base64 strings starting with "0x" need the prefix. */
+  CHECK(!check_blob("0x00", "\x00", 1));
+  CHECK(!check_blob("b64:0x00", "\xd3\x1d\x34", 3));
+  CHECK(!check_blob("b64:AAECAwQFBgcICQoLDA0ODxAREhMUFRYX", seq, 24));
+
+  /* Invalid characters and lengths. */
+  CHECK(!check_blob("0x000102030405060708090a0b0c0d0e0g", NULL, 0));
+  CHECK(!check_blob("0x0", NULL, 0));
+  CHECK(!check_blob("AAECAwQFBgcICQoLDA0O*xAR", NULL, 0));
+  CHECK(!check_blob("AAECA", NULL, 0));
+  CHECK(!check_blob("0xb64:AP86", NULL, 0));
+  return 0;
+}
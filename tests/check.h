@@ -0,0 +1,64 @@
+/*******************************************************************************
+* check.h: helpers for the tests of the libcfgcli library.
+
+* libcfgcli: C library for parsing command line option and configuration files.
+
+* Gitlab repository:
+        https://framagit.org/groolot-association/libcfgcli
+
+* Copyright (c) 2019 Cheng Zhao <zhaocheng03@gmail.com>
+* Copyright (c) 2023 Gregory David <dev@groolot.net>
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+
+*******************************************************************************/
+
+#ifndef _CHECK_H_
+#define _CHECK_H_
+
+#include <stdio.h>
+#include <string.h>
+#include <libcfgcli.h>
+
+/* Report the failed condition with its location, and fail the test. */
+#define CHECK(cond) do {                                                \
+  if (!(cond)) {                                                        \
+    fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__,   \
+        #cond);                                                         \
+    return 1;                                                           \
+  }                                                                     \
+} while (0)
+
+/* Check if the error or warning messages of the configurations contain
+   `str`, and clean the warnings. */
+static inline int check_error(cfgcli_t *cfg, const char *str) {
+  char msg[1024];
+  size_t n;
+  FILE *fp = tmpfile();
+  if (!fp) return 0;
+  cfgcli_perror(cfg, fp, "");
+  cfgcli_pwarn(cfg, fp, "");
+  rewind(fp);
+  n = fread(msg, 1, sizeof(msg) - 1, fp);
+  msg[n] = '\0';
+  fclose(fp);
+  return strstr(msg, str) != NULL;
+}
+
+#endif
@@ -0,0 +1,123 @@
+/*******************************************************************************
+* compress.c: tests of compressed configuration files.
+
+* libcfgcli: C library for parsing command line option and configuration files.
+
+* Gitlab repository:
+        https://framagit.org/groolot-association/libcfgcli
+
+* Copyright (c) 2019 Cheng Zhao <zhaocheng03@gmail.com>
+* Copyright (c) 2023 Gregory David <dev@groolot.net>
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+
+*******************************************************************************/
+
+#include <stdlib.h>
+#include "check.h"
+#ifdef HAVE_CONFIG_H
+#include "autoconf.h"
+#endif
+#ifdef HAVE_ZLIB
+#include <zlib.h>
+#endif
+#ifdef HAVE_ZSTD
+#include <zstd.h>
+#endif
+
+/* Variables of all tested parameters. */
+typedef struct {
+  int vint;
+  int *aint;
+} vars_t;
+
+/* Register the parameters with the variables in `v`. */
+static cfgcli_t *setup(vars_t *v) {
+  const cfgcli_param_t params[] = {
+    { 0, NULL, "int",  CFGCLI_DTYPE_INT, &v->vint, "" },
+    { 0, NULL, "ints", CFGCLI_ARRAY_INT, &v->aint, "" }
+  };
+  cfgcli_t *cfg = cfgcli_init();
+  memset(v, 0, sizeof(vars_t));
+  if (cfg && cfgcli_set_params(cfg, params, 2)) {
+    cfgcli_destroy(cfg);
+    return NULL;
+  }
+  return cfg;
+}
+
+#if defined(HAVE_ZLIB) || defined(HAVE_ZSTD)
+/* Write `len` bytes of `data` to a file. */
+static int save(const char *fname, const void *data, const size_t len) {
+  FILE *fp = fopen(fname, "wb");
+  CHECK(fp);
+  CHECK(fwrite(data, 1, len, fp) == len);
+  CHECK(!fclose(fp));
+  return 0;
+}
+
+/* Read a compressed file, and its copy with the last 4 bytes cut off. */
+static int check_compressed(const char *fname, const void *data,
+    const size_t len) {
+  vars_t v;
+  cfgcli_t *cfg = setup(&v);
+  CHECK(cfg);
+  CHECK(!save(fname, data, len));
+  CHECK(!cfgcli_read_file(cfg, fname, 1));
+  CHECK(v.vint == 7);
+  CHECK(cfgcli_get_size(cfg, &v.aint) == 3 && v.aint[2] == 3);
+  free(v.aint);
+  cfgcli_destroy(cfg);
+
+  /* Truncated data is reported, instead of parsing the partial text. */
+  CHECK((cfg = setup(&v)));
+  CHECK(!save(fname, data, len - 4));
+  CHECK(cfgcli_read_file(cfg, fname, 1) != 0);
+  CHECK(check_error(cfg, "corrupted or truncated compressed file"));
+  free(v.aint);
+  cfgcli_destroy(cfg);
+  remove(fname);
+  return 0;
+}
+#endif
+
+int main(void) {
+  const char conf[] = "int = 7\nints = [1, \\\n        2, 3]\n";
+  (void) conf;
+#ifdef HAVE_ZLIB
+  unsigned char buf[256];
+  size_t len;
+  gzFile gz = gzopen("compress.conf.gz", "wb");
+  CHECK(gz);
+  CHECK(gzwrite(gz, conf, strlen(conf)) == (int) strlen(conf));
+  CHECK(gzclose(gz) == Z_OK);
+  FILE *fp = fopen("compress.conf.gz", "rb");
+  CHECK(fp);
+  len = fread(buf, 1, sizeof(buf), fp);
+  fclose(fp);
+  CHECK(!check_compressed("compress.conf.gz", buf, len));
+#endif
+#ifdef HAVE_ZSTD
+  char zst[256];
+  const size_t zlen = ZSTD_compress(zst, sizeof(zst), conf, strlen(conf), 1);
+  CHECK(!ZSTD_isError(zlen));
+  CHECK(!check_compressed("compress.conf.zst", zst, zlen));
+#endif
+  return 0;
+}
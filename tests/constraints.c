@@ -0,0 +1,131 @@
+/*******************************************************************************
+* constraints.c: tests of constraints on numeric values.
+
+* libcfgcli: C library for parsing command line option and configuration files.
+
+* Gitlab repository:
+        https://framagit.org/groolot-association/libcfgcli
+
+* Copyright (c) 2019 Cheng Zhao <zhaocheng03@gmail.com>
+* Copyright (c) 2023 Gregory David <dev@groolot.net>
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+
+*******************************************************************************/
+
+#include <stdlib.h>
+#include "check.h"
+
+/* Variables of all tested parameters. */
+typedef struct {
+  int *ints;
+  long *longs;
+  double *dbls;
+  double dbl;
+  float flt;
+} vars_t;
+
+/* Register the parameters with the variables in `v`, and the constraints. */
+static cfgcli_t *setup(vars_t *v) {
+  static const double set[] = {0.5, 1, 2};
+  const cfgcli_param_t params[] = {
+    { 0, NULL, "ints",  CFGCLI_ARRAY_INT,  &v->ints,  "" },
+    { 0, NULL, "longs", CFGCLI_ARRAY_LONG, &v->longs, "" },
+    { 0, NULL, "dbls",  CFGCLI_ARRAY_DBL,  &v->dbls,  "" },
+    { 0, NULL, "dbl",   CFGCLI_DTYPE_DBL,  &v->dbl,   "" },
+    { 0, NULL, "flt",   CFGCLI_DTYPE_FLT,  &v->flt,   "" }
+  };
+  const cfgcli_check_t range = {CFGCLI_CHECK_MIN | CFGCLI_CHECK_MAX,
+    0, 10, NULL, 0};
+  const cfgcli_check_t desc = {CFGCLI_CHECK_DECREASING, 0, 0, NULL, 0};
+  const cfgcli_check_t asc = {CFGCLI_CHECK_INCREASING | CFGCLI_CHECK_NOT_NAN,
+    0, 0, NULL, 0};
+  const cfgcli_check_t allowed = {CFGCLI_CHECK_SET, 0, 0, set, 3};
+  const cfgcli_check_t num = {CFGCLI_CHECK_NOT_NAN, 0, 0, NULL, 0};
+  cfgcli_t *cfg = cfgcli_init();
+  memset(v, 0, sizeof(vars_t));
+  if (cfg && (cfgcli_set_params(cfg, params,
+      sizeof(params) / sizeof(params[0])) ||
+      cfgcli_set_check(cfg, &v->ints, &range) ||
+      cfgcli_set_check(cfg, &v->longs, &desc) ||
+      cfgcli_set_check(cfg, &v->dbls, &asc) ||
+      cfgcli_set_check(cfg, &v->dbl, &allowed) ||
+      cfgcli_set_check(cfg, &v->flt, &num))) {
+    cfgcli_destroy(cfg);
+    return NULL;
+  }
+  return cfg;
+}
+
+/* Release the memory of the values. */
+static void release(vars_t *v) {
+  free(v->ints);
+  free(v->longs);
+  free(v->dbls);
+}
+
+/* Read a single entry, and check that it is rejected with `msg`. */
+static int check_invalid(const char *entry, const char *msg) {
+  vars_t v;
+  char buf[256];
+  cfgcli_t *cfg = setup(&v);
+  CHECK(cfg);
+  snprintf(buf, sizeof(buf), "%s\n", entry);
+  CHECK(cfgcli_read_buffer(cfg, buf, strlen(buf), 1) != 0);
+  CHECK(check_error(cfg, msg));
+  release(&v);
+  cfgcli_destroy(cfg);
+  return 0;
+}
+
+int main(void) {
+  vars_t v;
+  char conf[] = "ints = [0, 10, 5]\nlongs = [3, 3, -1]\n"
+    "dbls = [-1, 0, 0, 2.5]\ndbl = 2\nflt = 1e30\n";
+  cfgcli_t *cfg = setup(&v);
+  CHECK(cfg);
+  CHECK(!cfgcli_read_buffer(cfg, conf, strlen(conf), 1));
+  CHECK(v.ints[1] == 10 && v.longs[2] == -1 && v.dbls[3] == 2.5);
+  CHECK(v.dbl == 2);
+  release(&v);
+  cfgcli_destroy(cfg);
+
+  /* Violations are reported with the index of the first invalid element. */
+  CHECK(!check_invalid("ints = [0, 1, -1, 11]",
+      "value smaller than the minimum for parameter: ints[2]"));
+  CHECK(!check_invalid("ints = [0, 1, 11, -1]",
+      "value larger than the maximum for parameter: ints[2]"));
+  CHECK(!check_invalid("longs = [3, 2, 2, 4, 1]",
+      "elements not in descending order for parameter: longs[3]"));
+  CHECK(!check_invalid("dbls = [1, 2, 1.5]",
+      "elements not in ascending order for parameter: dbls[2]"));
+  CHECK(!check_invalid("dbls = [1, nan]",
+      "NaN value for parameter: dbls[1]"));
+  CHECK(!check_invalid("dbl = 1.5", "value not allowed for parameter: dbl"));
+  CHECK(!check_invalid("flt = nan", "NaN value for parameter: flt"));
+
+  /* Invalid constraints are rejected. */
+  const cfgcli_check_t bad = {CFGCLI_CHECK_MIN | CFGCLI_CHECK_MAX,
+    1, 0, NULL, 0};
+  CHECK((cfg = setup(&v)));
+  CHECK(cfgcli_set_check(cfg, &v.ints, &bad) != 0);
+  CHECK(check_error(cfg, "invalid constraints for parameter: ints"));
+  cfgcli_destroy(cfg);
+  return 0;
+}
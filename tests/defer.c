@@ -0,0 +1,78 @@
+/*******************************************************************************
+* defer.c: tests of deferred value conversions.
+
+* libcfgcli: C library for parsing command line option and configuration files.
+
+* Gitlab repository:
+        https://framagit.org/groolot-association/libcfgcli
+
+* Copyright (c) 2019 Cheng Zhao <zhaocheng03@gmail.com>
+* Copyright (c) 2023 Gregory David <dev@groolot.net>
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+
+*******************************************************************************/
+
+#include <stdlib.h>
+#include "check.h"
+
+int main(void) {
+  int vint = 0, *aint = NULL;
+  char *vstr = NULL;
+  const cfgcli_param_t params[] = {
+    { 'i', "int", "int",  CFGCLI_DTYPE_INT, &vint, "" },
+    { 0,   NULL,  "str",  CFGCLI_DTYPE_STR, &vstr, "" },
+    { 0,   NULL,  "ints", CFGCLI_ARRAY_INT, &aint, "" }
+  };
+  char low[] = "int = invalid\nints = [x, y]\nstr = low\n";
+  char high[] = "ints = [1, 2]\n";
+  char *argv[] = {"defer", "-i", "7"};
+  int optidx;
+  cfgcli_t *cfg = cfgcli_init();
+  CHECK(cfg);
+  CHECK(!cfgcli_set_params(cfg, params, 3));
+  CHECK(!cfgcli_set_deferred(cfg, true));
+
+  /* Values are only recorded, so overridden ones are never converted. */
+  CHECK(!cfgcli_read_buffer(cfg, low, strlen(low), 1));
+  CHECK(!cfgcli_read_buffer(cfg, high, strlen(high), 2));
+  CHECK(!cfgcli_read_opts(cfg, 3, argv, 3, &optidx));
+  CHECK(cfgcli_is_set(cfg, &vint) && cfgcli_is_set(cfg, &vstr));
+  CHECK(vint == 0 && !vstr && !aint);
+
+  /* The winning values are converted by resolving them. */
+  CHECK(!cfgcli_resolve(cfg));
+  CHECK(vint == 7 && !strcmp(vstr, "low"));
+  CHECK(cfgcli_get_size(cfg, &aint) == 2 && aint[1] == 2);
+  free(vstr);
+  free(aint);
+  cfgcli_destroy(cfg);
+
+  /* Invalid winning values are reported when they are resolved. */
+  char bad[] = "int = invalid\n";
+  vint = 0;
+  CHECK((cfg = cfgcli_init()));
+  CHECK(!cfgcli_set_params(cfg, params, 3));
+  CHECK(!cfgcli_set_deferred(cfg, true));
+  CHECK(!cfgcli_read_buffer(cfg, bad, strlen(bad), 1));
+  CHECK(cfgcli_resolve(cfg) != 0);
+  CHECK(check_error(cfg, "parameter: int") && vint == 0);
+  cfgcli_destroy(cfg);
+  return 0;
+}
@@ -0,0 +1,147 @@
+/*******************************************************************************
+* diff.c: tests of differences between configurations.
+
+* libcfgcli: C library for parsing command line option and configuration files.
+
+* Gitlab repository:
+        https://framagit.org/groolot-association/libcfgcli
+
+* Copyright (c) 2019 Cheng Zhao <zhaocheng03@gmail.com>
+* Copyright (c) 2023 Gregory David <dev@groolot.net>
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+
+*******************************************************************************/
+
+#include <stdlib.h>
+#include "check.h"
+
+/* Variables of all tested parameters. */
+typedef struct {
+  int vint;
+  double vdbl;
+  char *vstr;
+  int *aint;
+} vars_t;
+
+/* Differences reported for the parameters. */
+typedef struct {
+  int num;                      /* number of differences                */
+  char kind[4];                 /* 'A'dded, 'R'emoved or 'C'hanged      */
+  int src[4][2];                /* sources in both configurations       */
+} diff_t;
+
+static const char *names[] = {"int", "dbl", "str", "ints"};
+
+/* Register the parameters with the variables in `v`. */
+static cfgcli_t *setup(vars_t *v) {
+  const cfgcli_param_t params[] = {
+    { 'i', NULL, "int",  CFGCLI_DTYPE_INT, &v->vint, "" },
+    { 0,   NULL, "dbl",  CFGCLI_DTYPE_DBL, &v->vdbl, "" },
+    { 0,   NULL, "str",  CFGCLI_DTYPE_STR, &v->vstr, "" },
+    { 0,   NULL, "ints", CFGCLI_ARRAY_INT, &v->aint, "" }
+  };
+  cfgcli_t *cfg = cfgcli_init();
+  memset(v, 0, sizeof(vars_t));
+  if (cfg && cfgcli_set_params(cfg, params, 4)) {
+    cfgcli_destroy(cfg);
+    return NULL;
+  }
+  return cfg;
+}
+
+/* Release the memory of the values. */
+static void release(vars_t *v) {
+  free(v->vstr);
+  free(v->aint);
+}
+
+/* Record a difference. */
+static int record(const char *name, const cfgcli_diff_t kind, const int src_a,
+    const int src_b, void *arg) {
+  diff_t *d = (diff_t *) arg;
+  for (int i = 0; i < 4; i++) {
+    if (strcmp(name, names[i])) continue;
+    d->kind[i] = (kind == CFGCLI_DIFF_ADDED) ? 'A' :
+      (kind == CFGCLI_DIFF_REMOVED) ? 'R' : 'C';
+    d->src[i][0] = src_a;
+    d->src[i][1] = src_b;
+  }
+  d->num += 1;
+  return 0;
+}
+
+/* Stop at the first difference. */
+static int stop(const char *name, const cfgcli_diff_t kind, const int src_a,
+    const int src_b, void *arg) {
+  (void) name;
+  (void) kind;
+  (void) src_a;
+  (void) src_b;
+  *((int *) arg) += 1;
+  return 5;
+}
+
+/* Compare configurations with converted or deferred values. */
+static int check_diff(const bool defer) {
+  vars_t a, b;
+  char ba[] = "int = 1\ndbl = 0.5\nints = [1, 2, 3]\n";
+  char bb[] = "dbl = 0.50\nstr = new\nints = [1, 2, 4]\n";
+  char same[] = "ints = [1, 2, 3]\nstr = new\n";
+  char *argv[] = {"diff", "-i", "1"};
+  diff_t d;
+  int optidx, n = 0;
+  cfgcli_t *ca = setup(&a);
+  cfgcli_t *cb = setup(&b);
+  CHECK(ca && cb);
+  CHECK(!cfgcli_set_deferred(ca, defer) && !cfgcli_set_deferred(cb, defer));
+  CHECK(!cfgcli_read_buffer(ca, ba, strlen(ba), 1));
+  CHECK(!cfgcli_read_buffer(cb, bb, strlen(bb), 2));
+
+  /* Values are compared after conversion, with their sources. */
+  memset(&d, 0, sizeof(diff_t));
+  CHECK(!cfgcli_diff(ca, cb, record, &d));
+  CHECK(d.num == 3);
+  CHECK(d.kind[0] == 'R' && d.src[0][0] == 1 && d.src[0][1] == 0);
+  CHECK(d.kind[1] == '\0');
+  CHECK(d.kind[2] == 'A' && d.src[2][0] == 0 && d.src[2][1] == 2);
+  CHECK(d.kind[3] == 'C' && d.src[3][0] == 1 && d.src[3][1] == 2);
+  CHECK(cfgcli_diff(ca, cb, stop, &n) == 5 && n == 1);
+
+  /* Identical values from different sources are not reported. */
+  free(a.aint);
+  CHECK(!cfgcli_read_buffer(ca, same, strlen(same), 3));
+  CHECK(!cfgcli_read_opts(cb, 3, argv, 3, &optidx));
+  memset(&d, 0, sizeof(diff_t));
+  CHECK(!cfgcli_diff(ca, cb, record, &d));
+  CHECK(d.num == 1 && d.kind[3] == 'C');
+
+  CHECK(!cfgcli_resolve(ca) && !cfgcli_resolve(cb));
+  release(&a);
+  release(&b);
+  cfgcli_destroy(ca);
+  cfgcli_destroy(cb);
+  return 0;
+}
+
+int main(void) {
+  CHECK(!check_diff(false));
+  CHECK(!check_diff(true));
+  return 0;
+}
@@ -0,0 +1,101 @@
+/*******************************************************************************
+* env.c: tests of environment variables as configuration sources.
+
+* libcfgcli: C library for parsing command line option and configuration files.
+
+* Gitlab repository:
+        https://framagit.org/groolot-association/libcfgcli
+
+* Copyright (c) 2019 Cheng Zhao <zhaocheng03@gmail.com>
+* Copyright (c) 2023 Gregory David <dev@groolot.net>
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+
+*******************************************************************************/
+
+#define _POSIX_C_SOURCE 200112L
+#include <stdlib.h>
+#include "check.h"
+
+/* Variables of all tested parameters. */
+typedef struct {
+  int conn;
+  char *name;
+  int dot;
+  int dash;
+} vars_t;
+
+/* Register the parameters with the variables in `v`. */
+static cfgcli_t *setup(vars_t *v) {
+  const cfgcli_param_t params[] = {
+    { 0, NULL, "db.max-conn", CFGCLI_DTYPE_INT, &v->conn, "" },
+    { 0, NULL, "name",        CFGCLI_DTYPE_STR, &v->name, "" },
+    { 0, NULL, "a.b",         CFGCLI_DTYPE_INT, &v->dot,  "" },
+    { 0, NULL, "a-b",         CFGCLI_DTYPE_INT, &v->dash, "" }
+  };
+  cfgcli_t *cfg = cfgcli_init();
+  memset(v, 0, sizeof(vars_t));
+  if (cfg && cfgcli_set_params(cfg, params, 4)) {
+    cfgcli_destroy(cfg);
+    return NULL;
+  }
+  return cfg;
+}
+
+int main(void) {
+  vars_t v;
+  cfgcli_t *cfg = setup(&v);
+  CHECK(cfg);
+  CHECK(!setenv("CFGCLI_TEST_DB_MAX_CONN", "12", 1));
+  CHECK(!setenv("CFGCLI_TEST_NAME", "'a b'", 1));
+  CHECK(!setenv("CFGCLI_TEST_A_B", "3", 1));
+  CHECK(!setenv("cfgcli_test_name", "lower", 1));
+  CHECK(!setenv("NAME", "unprefixed", 1));
+
+  /* Names are prefixed and in upper case, with '.' and '-' as '_'. */
+  CHECK(!cfgcli_read_env(cfg, "CFGCLI_TEST_", 1));
+  CHECK(v.conn == 12 && !strcmp(v.name, "a b"));
+
+  /* Parameters with the same variable name are ambiguous. */
+  CHECK(v.dot == 3 && cfgcli_is_set(cfg, &v.dot));
+  CHECK(v.dash == 0 && !cfgcli_is_set(cfg, &v.dash));
+  CHECK(check_error(cfg, "ambiguous environment variable for parameter: a-b"));
+
+  /* Values of higher priorities are kept. */
+  free(v.name);
+  char buf[] = "db.max-conn = 20\n";
+  CHECK(!cfgcli_read_buffer(cfg, buf, strlen(buf), 3));
+  CHECK(!cfgcli_read_env(cfg, "CFGCLI_TEST_", 2));
+  CHECK(v.conn == 20);
+  free(v.name);
+  cfgcli_destroy(cfg);
+
+  /* Variables without prefix, and empty variables. */
+  CHECK((cfg = setup(&v)));
+  CHECK(!setenv("CFGCLI_TEST_NAME", "", 1));
+  CHECK(!cfgcli_read_env(cfg, NULL, 1));
+  CHECK(!strcmp(v.name, "unprefixed"));
+  free(v.name);
+  cfgcli_destroy(cfg);
+  CHECK((cfg = setup(&v)));
+  CHECK(!cfgcli_read_env(cfg, "CFGCLI_TEST_", 1));
+  CHECK(!cfgcli_is_set(cfg, &v.name) && v.conn == 12);
+  cfgcli_destroy(cfg);
+  return 0;
+}
@@ -0,0 +1,98 @@
+/*******************************************************************************
+* fingerprint.c: tests of fingerprints of all set parameters.
+
+* libcfgcli: C library for parsing command line option and configuration files.
+
+* Gitlab repository:
+        https://framagit.org/groolot-association/libcfgcli
+
+* Copyright (c) 2019 Cheng Zhao <zhaocheng03@gmail.com>
+* Copyright (c) 2023 Gregory David <dev@groolot.net>
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+
+*******************************************************************************/
+
+#include <stdlib.h>
+#include "check.h"
+
+/* Variables of all tested parameters. */
+typedef struct {
+  long num;
+  double *vals;
+  char *name;
+} vars_t;
+
+/* Register the parameters with the variables in `v`. */
+static cfgcli_t *setup(vars_t *v) {
+  const cfgcli_param_t params[] = {
+    { 0, NULL, "num",  CFGCLI_DTYPE_LONG, &v->num,  "" },
+    { 0, NULL, "vals", CFGCLI_ARRAY_DBL,  &v->vals, "" },
+    { 0, NULL, "name", CFGCLI_DTYPE_STR,  &v->name, "" }
+  };
+  cfgcli_t *cfg = cfgcli_init();
+  memset(v, 0, sizeof(vars_t));
+  if (cfg && cfgcli_set_params(cfg, params,
+      sizeof(params) / sizeof(params[0]))) {
+    cfgcli_destroy(cfg);
+    return NULL;
+  }
+  return cfg;
+}
+
+/* Read the definitions in `conf`, and retrieve the fingerprint. */
+static int fingerprint(const char *conf, unsigned char *out) {
+  vars_t v;
+  char buf[256];
+  cfgcli_t *cfg = setup(&v);
+  CHECK(cfg);
+  snprintf(buf, sizeof(buf), "%s", conf);
+  CHECK(!cfgcli_read_buffer(cfg, buf, strlen(buf), 1));
+  CHECK(!cfgcli_fingerprint(cfg, out));
+  free(v.vals);
+  free(v.name);
+  cfgcli_destroy(cfg);
+  return 0;
+}
+
+int main(void) {
+  /* Digests of the big-endian encoding of the values, which is the same on
+   * all platforms, regardless of the sizes of `long` and `size_t`. */
+  const char *known =
+    "9848bb61239ae43ebb1ff2f5ff7b61c4ab22461d19382526925354fce39ceacb";
+  unsigned char a[CFGCLI_FINGERPRINT_SIZE], b[CFGCLI_FINGERPRINT_SIZE];
+  char hex[2 * CFGCLI_FINGERPRINT_SIZE + 1];
+
+  CHECK(!fingerprint("num = -2\nvals = [0.5, -1, 2]\nname = abc\n", a));
+  for (int i = 0; i < CFGCLI_FINGERPRINT_SIZE; i++)
+    sprintf(hex + 2 * i, "%02x", a[i]);
+  CHECK(!strcmp(hex, known));
+
+  /* Independent of the order and formatting of the definitions. */
+  CHECK(!fingerprint("name = 'abc'  # comment\nvals = [5e-1, -1.0, \\\n 2]\n"
+      "num = -0002\n", b));
+  CHECK(!memcmp(a, b, CFGCLI_FINGERPRINT_SIZE));
+
+  /* Changes of any element are detected. */
+  CHECK(!fingerprint("num = -2\nvals = [0.5, -1, 3]\nname = abc\n", b));
+  CHECK(memcmp(a, b, CFGCLI_FINGERPRINT_SIZE));
+  CHECK(!fingerprint("num = -2\nvals = [0.5, -1, 2]\n", b));
+  CHECK(memcmp(a, b, CFGCLI_FINGERPRINT_SIZE));
+  return 0;
+}
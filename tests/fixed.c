@@ -0,0 +1,112 @@
+/*******************************************************************************
+* fixed.c: tests of fixed-width and unsigned integers.
+
+* libcfgcli: C library for parsing command line option and configuration files.
+
+* Gitlab repository:
+        https://framagit.org/groolot-association/libcfgcli
+
+* Copyright (c) 2019 Cheng Zhao <zhaocheng03@gmail.com>
+* Copyright (c) 2023 Gregory David <dev@groolot.net>
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+
+*******************************************************************************/
+
+#include <stdlib.h>
+#include "check.h"
+
+/* Variables of all tested parameters. */
+typedef struct {
+  int8_t i8;
+  uint8_t u8;
+  int64_t i64;
+  uint64_t u64;
+  size_t size;
+  int16_t *ai16;
+  uint32_t *au32;
+} vars_t;
+
+/* Register the parameters with the variables in `v`. */
+static cfgcli_t *setup(vars_t *v) {
+  const cfgcli_param_t params[] = {
+    { 0, NULL, "i8",   CFGCLI_DTYPE_INT8,   &v->i8,   "" },
+    { 0, NULL, "u8",   CFGCLI_DTYPE_UINT8,  &v->u8,   "" },
+    { 0, NULL, "i64",  CFGCLI_DTYPE_INT64,  &v->i64,  "" },
+    { 0, NULL, "u64",  CFGCLI_DTYPE_UINT64, &v->u64,  "" },
+    { 0, NULL, "size", CFGCLI_DTYPE_SIZE,   &v->size, "" },
+    { 0, NULL, "ai16", CFGCLI_ARRAY_INT16,  &v->ai16, "" },
+    { 0, NULL, "au32", CFGCLI_ARRAY_UINT32, &v->au32, "" }
+  };
+  cfgcli_t *cfg = cfgcli_init();
+  memset(v, 0, sizeof(vars_t));
+  if (cfg && cfgcli_set_params(cfg, params, 7)) {
+    cfgcli_destroy(cfg);
+    return NULL;
+  }
+  return cfg;
+}
+
+/* Read a single entry, and check that it is rejected. */
+static int check_invalid(const char *entry, const char *name) {
+  vars_t v;
+  char buf[128];
+  cfgcli_t *cfg = setup(&v);
+  CHECK(cfg);
+  snprintf(buf, sizeof(buf), "%s\n", entry);
+  CHECK(cfgcli_read_buffer(cfg, buf, strlen(buf), 1) != 0);
+  CHECK(check_error(cfg, name));
+  free(v.ai16);
+  free(v.au32);
+  cfgcli_destroy(cfg);
+  return 0;
+}
+
+int main(void) {
+  vars_t v;
+  char buf[] = "i8 = -128\nu8 = 255\ni64 = -9223372036854775808\n"
+    "u64 = 18446744073709551615\nsize = 4096\n"
+    "ai16 = [-32768, 32767]\nau32 = [0, 4294967295]\n";
+  cfgcli_t *cfg = setup(&v);
+  CHECK(cfg);
+  CHECK(!cfgcli_read_buffer(cfg, buf, strlen(buf), 1));
+  CHECK(v.i8 == INT8_MIN && v.u8 == UINT8_MAX && v.i64 == INT64_MIN);
+  CHECK(v.u64 == UINT64_MAX && v.size == 4096);
+  CHECK(cfgcli_get_size(cfg, &v.ai16) == 2);
+  CHECK(v.ai16[0] == INT16_MIN && v.ai16[1] == INT16_MAX);
+  CHECK(cfgcli_get_size(cfg, &v.au32) == 2 && v.au32[1] == UINT32_MAX);
+  free(v.ai16);
+  free(v.au32);
+  cfgcli_destroy(cfg);
+
+  /* Values out of the ranges of the types. */
+  CHECK(!check_invalid("i8 = 128", "parameter: i8"));
+  CHECK(!check_invalid("i8 = -129", "parameter: i8"));
+  CHECK(!check_invalid("u8 = 256", "parameter: u8"));
+  CHECK(!check_invalid("u64 = 18446744073709551616", "parameter: u64"));
+  CHECK(!check_invalid("i64 = 9223372036854775808", "parameter: i64"));
+  CHECK(!check_invalid("ai16 = [1, 32768]", "parameter: ai16"));
+
+  /* Negative values of unsigned types. */
+  CHECK(!check_invalid("u8 = -1", "parameter: u8"));
+  CHECK(!check_invalid("u64 = -1", "parameter: u64"));
+  CHECK(!check_invalid("size = -4096", "parameter: size"));
+  CHECK(!check_invalid("au32 = [1, -1]", "parameter: au32"));
+  return 0;
+}
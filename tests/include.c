@@ -0,0 +1,110 @@
+/*******************************************************************************
+* include.c: tests of included configuration files.
+
+* libcfgcli: C library for parsing command line option and configuration files.
+
+* Gitlab repository:
+        https://framagit.org/groolot-association/libcfgcli
+
+* Copyright (c) 2019 Cheng Zhao <zhaocheng03@gmail.com>
+* Copyright (c) 2023 Gregory David <dev@groolot.net>
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+
+*******************************************************************************/
+
+#include <stdlib.h>
+#include "check.h"
+
+/* Variables of all tested parameters. */
+typedef struct {
+  int vint;
+  double vdbl;
+  int *aint;
+} vars_t;
+
+/* Register the parameters with the variables in `v`. */
+static cfgcli_t *setup(vars_t *v) {
+  const cfgcli_param_t params[] = {
+    { 0, NULL, "int",  CFGCLI_DTYPE_INT, &v->vint, "" },
+    { 0, NULL, "dbl",  CFGCLI_DTYPE_DBL, &v->vdbl, "" },
+    { 0, NULL, "ints", CFGCLI_ARRAY_INT, &v->aint, "" }
+  };
+  cfgcli_t *cfg = cfgcli_init();
+  memset(v, 0, sizeof(vars_t));
+  if (cfg && cfgcli_set_params(cfg, params, 3)) {
+    cfgcli_destroy(cfg);
+    return NULL;
+  }
+  return cfg;
+}
+
+/* Write a string to a file. */
+static int save(const char *fname, const char *str) {
+  FILE *fp = fopen(fname, "w");
+  CHECK(fp);
+  CHECK(fputs(str, fp) >= 0);
+  CHECK(!fclose(fp));
+  return 0;
+}
+
+int main(void) {
+  vars_t v;
+  cfgcli_t *cfg = setup(&v);
+  CHECK(cfg);
+  CHECK(!save("include_main.conf", "include \"include_a.conf\"\nint = 5\n"));
+  CHECK(!save("include_a.conf", "dbl = 1.5\nints = [1, \\\n        2]\n"));
+
+  /* Values of included files, with line continuations. */
+  CHECK(!cfgcli_read_file(cfg, "include_main.conf", 1));
+  CHECK(v.vint == 5 && v.vdbl == 1.5);
+  CHECK(cfgcli_get_size(cfg, &v.aint) == 2 && v.aint[1] == 2);
+  free(v.aint);
+
+  /* Cached files are read again once they are modified. */
+  CHECK(!cfgcli_read_file(cfg, "include_main.conf", 2));
+  CHECK(v.vdbl == 1.5 && cfgcli_get_size(cfg, &v.aint) == 2);
+  free(v.aint);
+  CHECK(!save("include_a.conf", "dbl = 2.25\nints = [3]\n"));
+  CHECK(!cfgcli_read_file(cfg, "include_main.conf", 3));
+  CHECK(v.vdbl == 2.25 && cfgcli_get_size(cfg, &v.aint) == 1);
+  CHECK(v.aint[0] == 3);
+  free(v.aint);
+  cfgcli_destroy(cfg);
+
+  /* Files including themselves are rejected. */
+  CHECK(!save("include_a.conf", "include \"include_b.conf\"\n"));
+  CHECK(!save("include_b.conf", "include \"include_a.conf\"\n"));
+  CHECK((cfg = setup(&v)));
+  CHECK(cfgcli_read_file(cfg, "include_main.conf", 1) != 0);
+  CHECK(check_error(cfg, "recursive inclusion of file"));
+  cfgcli_destroy(cfg);
+
+  /* Included files cannot end with a line continuation. */
+  CHECK(!save("include_a.conf", "int = 5\nints = [1, \\\n"));
+  CHECK((cfg = setup(&v)));
+  CHECK(cfgcli_read_file(cfg, "include_main.conf", 1) != 0);
+  CHECK(check_error(cfg, "unterminated line continuation"));
+  free(v.aint);
+  cfgcli_destroy(cfg);
+  remove("include_main.conf");
+  remove("include_a.conf");
+  remove("include_b.conf");
+  return 0;
+}
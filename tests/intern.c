@@ -0,0 +1,101 @@
+/*******************************************************************************
+* intern.c: tests of interned string values.
+
+* libcfgcli: C library for parsing command line option and configuration files.
+
+* Gitlab repository:
+        https://framagit.org/groolot-association/libcfgcli
+
+* Copyright (c) 2019 Cheng Zhao <zhaocheng03@gmail.com>
+* Copyright (c) 2023 Gregory David <dev@groolot.net>
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+
+*******************************************************************************/
+
+#include <stdlib.h>
+#include "check.h"
+
+/* Number of distinct strings, enough for growing the table of strings. */
+#define NSTR            200
+
+/* Length of a string stored in its own block. */
+#define LONG_LEN        20000
+
+/* Compose a string array definition with the distinct strings. */
+static size_t compose(char *buf, const char *name) {
+  size_t n = sprintf(buf, "%s = [", name);
+  for (int i = 0; i < NSTR; i++) n += sprintf(buf + n, "e%d, ", i);
+  n += sprintf(buf + n - 2, "]\n") - 2;
+  return n;
+}
+
+int main(void) {
+  char *s1 = NULL, *s2 = NULL, **a1 = NULL, **a2 = NULL;
+  const cfgcli_param_t params[] = {
+    { 0, NULL, "s1", CFGCLI_DTYPE_STR, &s1, "" },
+    { 0, NULL, "s2", CFGCLI_DTYPE_STR, &s2, "" },
+    { 0, NULL, "a1", CFGCLI_ARRAY_STR, &a1, "" },
+    { 0, NULL, "a2", CFGCLI_ARRAY_STR, &a2, "" }
+  };
+  char buf[] = "s1 = abc\ns2 = 'abc'\na1 = [abc, x, \"abc\"]\n";
+  cfgcli_t *cfg = cfgcli_init();
+  CHECK(cfg);
+  CHECK(!cfgcli_set_params(cfg, params, 4));
+  CHECK(!cfgcli_set_intern(cfg, true));
+
+  /* Identical values share the same address. */
+  CHECK(!cfgcli_read_buffer(cfg, buf, strlen(buf), 1));
+  CHECK(!strcmp(s1, "abc") && s1 == s2);
+  CHECK(cfgcli_get_size(cfg, &a1) == 3);
+  CHECK(a1[0] == s1 && a1[2] == s1 && !strcmp(a1[1], "x"));
+  free(a1);
+
+  /* Addresses are kept while the table grows. */
+  char *arr = malloc(NSTR * 8 + 16);
+  CHECK(arr);
+  size_t len = compose(arr, "a1");
+  CHECK(!cfgcli_read_buffer(cfg, arr, len, 2));
+  len = compose(arr, "a2");
+  CHECK(!cfgcli_read_buffer(cfg, arr, len, 2));
+  CHECK(cfgcli_get_size(cfg, &a1) == NSTR && cfgcli_get_size(cfg, &a2) == NSTR);
+  for (int i = 0; i < NSTR; i++) CHECK(a1[i] == a2[i]);
+  len = sprintf(arr, "s2 = abc\n");
+  CHECK(!cfgcli_read_buffer(cfg, arr, len, 2));
+  CHECK(s2 == s1);
+  free(a1);
+  free(a2);
+  free(arr);
+
+  /* Long strings are stored in their own blocks. */
+  char *lng = malloc(2 * LONG_LEN + 32);
+  CHECK(lng);
+  len = sprintf(lng, "s1 = ");
+  memset(lng + len, 'l', LONG_LEN);
+  len += LONG_LEN;
+  len += sprintf(lng + len, "\ns2 = ");
+  memset(lng + len, 'l', LONG_LEN);
+  len += LONG_LEN;
+  len += sprintf(lng + len, "\n");
+  CHECK(!cfgcli_read_buffer(cfg, lng, len, 3));
+  CHECK(strlen(s1) == LONG_LEN && s1 == s2);
+  free(lng);
+  cfgcli_destroy(cfg);
+  return 0;
+}
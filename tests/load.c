@@ -0,0 +1,101 @@
+/*******************************************************************************
+* load.c: tests of configuration files loaded asynchronously.
+
+* libcfgcli: C library for parsing command line option and configuration files.
+
+* Gitlab repository:
+        https://framagit.org/groolot-association/libcfgcli
+
+* Copyright (c) 2019 Cheng Zhao <zhaocheng03@gmail.com>
+* Copyright (c) 2023 Gregory David <dev@groolot.net>
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+
+*******************************************************************************/
+
+#include "check.h"
+
+/* Variables of all tested parameters. */
+typedef struct {
+  int vint;
+  double vdbl;
+} vars_t;
+
+/* Register the parameters with the variables in `v`. */
+static cfgcli_t *setup(vars_t *v) {
+  const cfgcli_param_t params[] = {
+    { 0, NULL, "int", CFGCLI_DTYPE_INT, &v->vint, "" },
+    { 0, NULL, "dbl", CFGCLI_DTYPE_DBL, &v->vdbl, "" }
+  };
+  cfgcli_t *cfg = cfgcli_init();
+  memset(v, 0, sizeof(vars_t));
+  if (cfg && cfgcli_set_params(cfg, params, 2)) {
+    cfgcli_destroy(cfg);
+    return NULL;
+  }
+  return cfg;
+}
+
+/* Write a string to a file. */
+static int save(const char *fname, const char *str) {
+  FILE *fp = fopen(fname, "w");
+  CHECK(fp);
+  CHECK(fputs(str, fp) >= 0);
+  CHECK(!fclose(fp));
+  return 0;
+}
+
+int main(void) {
+  vars_t v;
+  const char *fname[] = {"load_1.conf", "load_2.conf", "load_3.conf"};
+  const char *conf[] = {"int = 1\n", "int = 2\ndbl = 2\n", "int = 3\n"};
+  const char *missing[] = {"load_1.conf", "load_missing.conf"};
+  const int prior[] = {1, 2, 3};
+  cfgcli_loader_t *ld;
+  int rest = 3, n = 0;
+  cfgcli_t *cfg = setup(&v);
+  CHECK(cfg);
+  for (int i = 0; i < 3; i++) CHECK(!save(fname[i], conf[i]));
+
+  /* Files are parsed by non-blocking polls. */
+  CHECK((ld = cfgcli_load_files(cfg, fname, prior, 3)));
+  const bool blocking = cfgcli_load_fd(ld) < 0;
+  while (rest > 0 && n++ < 1000000) {
+    const int num = cfgcli_load_poll(ld, false);
+    CHECK(num >= 0 && num <= rest);
+    /* Without io_uring, every poll parses exactly one file. */
+    if (blocking) CHECK(num == rest - 1);
+    rest = num;
+  }
+  CHECK(rest == 0 || cfgcli_load_poll(ld, true) == 0);
+  CHECK(cfgcli_load_poll(ld, false) == 0);
+  cfgcli_load_free(ld);
+  CHECK(v.vint == 3 && v.vdbl == 2);
+  cfgcli_destroy(cfg);
+
+  /* Files that cannot be opened are reported. */
+  CHECK((cfg = setup(&v)));
+  ld = cfgcli_load_files(cfg, missing, prior, 2);
+  CHECK(!ld || cfgcli_load_poll(ld, true) < 0);
+  CHECK(check_error(cfg, "load_missing.conf"));
+  if (ld) cfgcli_load_free(ld);
+  cfgcli_destroy(cfg);
+  for (int i = 0; i < 3; i++) remove(fname[i]);
+  return 0;
+}
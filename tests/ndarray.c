@@ -0,0 +1,83 @@
+/*******************************************************************************
+* ndarray.c: tests of multi-dimensional arrays.
+
+* libcfgcli: C library for parsing command line option and configuration files.
+
+* Gitlab repository:
+        https://framagit.org/groolot-association/libcfgcli
+
+* Copyright (c) 2019 Cheng Zhao <zhaocheng03@gmail.com>
+* Copyright (c) 2023 Gregory David <dev@groolot.net>
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+
+*******************************************************************************/
+
+#include <stdlib.h>
+#include "check.h"
+
+/* Read a multi-dimensional array, and check that it is rejected. */
+static int check_invalid(const char *entry) {
+  int *nd = NULL;
+  const cfgcli_param_t param = { 0, NULL, "nd", CFGCLI_NDARRAY_INT, &nd, "" };
+  char buf[256];
+  cfgcli_t *cfg = cfgcli_init();
+  CHECK(cfg);
+  CHECK(!cfgcli_set_params(cfg, &param, 1));
+  snprintf(buf, sizeof(buf), "nd = %s\n", entry);
+  CHECK(cfgcli_read_buffer(cfg, buf, strlen(buf), 1) != 0);
+  CHECK(check_error(cfg, "parameter: nd"));
+  free(nd);
+  cfgcli_destroy(cfg);
+  return 0;
+}
+
+int main(void) {
+  int *nd = NULL;
+  double *dd = NULL;
+  const cfgcli_param_t params[] = {
+    { 0, NULL, "nd", CFGCLI_NDARRAY_INT, &nd, "" },
+    { 0, NULL, "dd", CFGCLI_NDARRAY_DBL, &dd, "" }
+  };
+  char buf[] = "nd = [[1, 2, 3], [4, 5, 6]]\n"
+    "dd = [[[1], [2]], [[3], [4]], [[5], \\\n  [6.5]]]\n";
+  size_t shape[CFGCLI_MAX_NDIM];
+  cfgcli_t *cfg = cfgcli_init();
+  CHECK(cfg);
+  CHECK(!cfgcli_set_params(cfg, params, 2));
+  CHECK(!cfgcli_read_buffer(cfg, buf, strlen(buf), 1));
+
+  /* Elements are contiguous, with the last dimension varying fastest. */
+  CHECK(cfgcli_get_shape(cfg, &nd, shape) == 2);
+  CHECK(shape[0] == 2 && shape[1] == 3);
+  CHECK(cfgcli_get_array_size(cfg, &nd) == 6);
+  for (int i = 0; i < 6; i++) CHECK(nd[i] == i + 1);
+  CHECK(cfgcli_get_shape(cfg, &dd, shape) == 3);
+  CHECK(shape[0] == 3 && shape[1] == 2 && shape[2] == 1);
+  CHECK(cfgcli_get_array_size(cfg, &dd) == 6 && dd[5] == 6.5);
+  free(nd);
+  free(dd);
+  cfgcli_destroy(cfg);
+
+  /* Ragged arrays, and inconsistent depths. */
+  CHECK(!check_invalid("[[1, 2], [3]]"));
+  CHECK(!check_invalid("[[1, 2], 3]"));
+  CHECK(!check_invalid("[[1, 2], [3, x]]"));
+  return 0;
+}
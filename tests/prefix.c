@@ -0,0 +1,90 @@
+/*******************************************************************************
+* prefix.c: tests of abbreviated long command line options.
+
+* libcfgcli: C library for parsing command line option and configuration files.
+
+* Gitlab repository:
+        https://framagit.org/groolot-association/libcfgcli
+
+* Copyright (c) 2019 Cheng Zhao <zhaocheng03@gmail.com>
+* Copyright (c) 2023 Gregory David <dev@groolot.net>
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+
+*******************************************************************************/
+
+#include <stdlib.h>
+#include "check.h"
+
+/* Variables of all tested parameters. */
+typedef struct {
+  bool verbose;
+  int in;
+  char *input;
+  int ncall;                    /* number of calls of the function */
+} vars_t;
+
+/* Function called with the `--version` option. */
+static void version(void *arg) {
+  ((vars_t *) arg)->ncall++;
+}
+
+/* Register the parameters and the function. */
+static cfgcli_t *setup(vars_t *v) {
+  const cfgcli_param_t params[] = {
+    { 0, "verbose", "verbose", CFGCLI_DTYPE_BOOL, &v->verbose, "" },
+    { 0, "in",      "in",      CFGCLI_DTYPE_INT,  &v->in,      "" },
+    { 0, "input",   "input",   CFGCLI_DTYPE_STR,  &v->input,   "" }
+  };
+  const cfgcli_func_t funcs[] = {
+    { 0, "version", version, v, "" }
+  };
+  cfgcli_t *cfg = cfgcli_init();
+  memset(v, 0, sizeof(vars_t));
+  if (cfg && (cfgcli_set_params(cfg, params, 3) ||
+      cfgcli_set_funcs(cfg, funcs, 1))) {
+    cfgcli_destroy(cfg);
+    return NULL;
+  }
+  return cfg;
+}
+
+int main(void) {
+  vars_t v;
+  char *argv[] = {"prefix", "--verb", "--in=3", "--inp", "x", "--versi"};
+  char *ambig[] = {"prefix", "--ver"};
+  int optidx = 0;
+
+  /* Unique prefixes, and exact matches that are prefixes of others. */
+  cfgcli_t *cfg = setup(&v);
+  CHECK(cfg);
+  CHECK(!cfgcli_read_opts(cfg, 6, argv, 1, &optidx));
+  CHECK(v.verbose && v.in == 3 && !strcmp(v.input, "x") && v.ncall == 1);
+  free(v.input);
+  cfgcli_destroy(cfg);
+
+  /* Ambiguous prefixes are reported with all candidates. */
+  CHECK((cfg = setup(&v)));
+  CHECK(cfgcli_read_opts(cfg, 2, ambig, 1, &optidx) != 0);
+  CHECK(check_error(cfg,
+      "ambiguous command line option: --ver (--verbose, --version)"));
+  CHECK(!v.verbose && v.ncall == 0);
+  cfgcli_destroy(cfg);
+  return 0;
+}
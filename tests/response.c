@@ -0,0 +1,112 @@
+/*******************************************************************************
+* response.c: tests of command line arguments from response files.
+
+* libcfgcli: C library for parsing command line option and configuration files.
+
+* Gitlab repository:
+        https://framagit.org/groolot-association/libcfgcli
+
+* Copyright (c) 2019 Cheng Zhao <zhaocheng03@gmail.com>
+* Copyright (c) 2023 Gregory David <dev@groolot.net>
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+
+*******************************************************************************/
+
+#include <stdlib.h>
+#include "check.h"
+
+/* Variables of all tested parameters. */
+typedef struct {
+  int vint;
+  double vdbl;
+  char *vstr;
+  int *aint;
+} vars_t;
+
+/* Register the parameters with the variables in `v`. */
+static cfgcli_t *setup(vars_t *v) {
+  const cfgcli_param_t params[] = {
+    { 'i', "int",  "int",  CFGCLI_DTYPE_INT, &v->vint, "" },
+    { 'd', "dbl",  "dbl",  CFGCLI_DTYPE_DBL, &v->vdbl, "" },
+    { 0,   "str",  "str",  CFGCLI_DTYPE_STR, &v->vstr, "" },
+    { 0,   "ints", "ints", CFGCLI_ARRAY_INT, &v->aint, "" }
+  };
+  cfgcli_t *cfg = cfgcli_init();
+  memset(v, 0, sizeof(vars_t));
+  if (cfg && cfgcli_set_params(cfg, params,
+      sizeof(params) / sizeof(params[0]))) {
+    cfgcli_destroy(cfg);
+    return NULL;
+  }
+  return cfg;
+}
+
+/* Release the memory of the values. */
+static void release(vars_t *v) {
+  free(v->vstr);
+  free(v->aint);
+}
+
+/* Write a string to a file. */
+static int save(const char *fname, const char *str) {
+  FILE *fp = fopen(fname, "w");
+  CHECK(fp);
+  CHECK(fputs(str, fp) >= 0);
+  CHECK(!fclose(fp));
+  return 0;
+}
+
+int main(void) {
+  vars_t v;
+  char *argv[] = {"response", "@response_1.rsp", "--", "pos"};
+  char *loop[] = {"response", "@response_loop.rsp"};
+  char *missing[] = {"response", "@response_missing.rsp"};
+  int optidx = 0;
+  cfgcli_t *cfg = setup(&v);
+  CHECK(cfg);
+  CHECK(!save("response_1.rsp",
+      "--int=3 @response_2.rsp \"--str=a b\"\n"));
+  CHECK(!save("response_2.rsp", "--ints=[1,2]\n  -d 2.5\n"));
+  CHECK(!save("response_loop.rsp", "@response_loop.rsp\n"));
+
+  /* Nested response files, with quoted arguments. */
+  CHECK(!cfgcli_read_opts(cfg, 4, argv, 1, &optidx));
+  CHECK(optidx == 3);
+  CHECK(v.vint == 3 && v.vdbl == 2.5 && !strcmp(v.vstr, "a b"));
+  CHECK(cfgcli_get_size(cfg, &v.aint) == 2 && v.aint[1] == 2);
+  release(&v);
+  cfgcli_destroy(cfg);
+
+  /* Response files including themselves are limited in depth. */
+  CHECK((cfg = setup(&v)));
+  CHECK(cfgcli_read_opts(cfg, 2, loop, 1, &optidx) != 0);
+  CHECK(check_error(cfg, "too many nested response files"));
+  cfgcli_destroy(cfg);
+
+  /* Missing response files are reported. */
+  CHECK((cfg = setup(&v)));
+  CHECK(cfgcli_read_opts(cfg, 2, missing, 1, &optidx) != 0);
+  CHECK(check_error(cfg, "cannot open the response file"));
+  cfgcli_destroy(cfg);
+  remove("response_1.rsp");
+  remove("response_2.rsp");
+  remove("response_loop.rsp");
+  return 0;
+}
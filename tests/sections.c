@@ -0,0 +1,135 @@
+/*******************************************************************************
+* sections.c: tests of sections, and of reloading them.
+
+* libcfgcli: C library for parsing command line option and configuration files.
+
+* Gitlab repository:
+        https://framagit.org/groolot-association/libcfgcli
+
+* Copyright (c) 2019 Cheng Zhao <zhaocheng03@gmail.com>
+* Copyright (c) 2023 Gregory David <dev@groolot.net>
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+
+*******************************************************************************/
+
+#include <stdlib.h>
+#include "check.h"
+
+/* Variables of all tested parameters. */
+typedef struct {
+  char *host;
+  int port;
+  int size;
+  int level;
+  int top;
+} vars_t;
+
+/* Register the parameters with the variables in `v`. */
+static cfgcli_t *setup(vars_t *v) {
+  const cfgcli_param_t params[] = {
+    { 0, NULL, "db.host",      CFGCLI_DTYPE_STR, &v->host,  "" },
+    { 0, NULL, "db.port",      CFGCLI_DTYPE_INT, &v->port,  "" },
+    { 0, NULL, "db.pool.size", CFGCLI_DTYPE_INT, &v->size,  "" },
+    { 0, NULL, "log.level",    CFGCLI_DTYPE_INT, &v->level, "" },
+    { 0, NULL, "top",          CFGCLI_DTYPE_INT, &v->top,   "" }
+  };
+  cfgcli_t *cfg = cfgcli_init();
+  memset(v, 0, sizeof(vars_t));
+  if (cfg && cfgcli_set_params(cfg, params, 5)) {
+    cfgcli_destroy(cfg);
+    return NULL;
+  }
+  return cfg;
+}
+
+/* Write a string to a file. */
+static int save(const char *fname, const char *str) {
+  FILE *fp = fopen(fname, "w");
+  CHECK(fp);
+  CHECK(fputs(str, fp) >= 0);
+  CHECK(!fclose(fp));
+  return 0;
+}
+
+/* Count the visited parameters, and stop at "log.level". */
+static int visit(const char *name, void *var, void *arg) {
+  int *n = (int *) arg;
+  (void) var;
+  if (!strcmp(name, "log.level")) return 7;
+  *n += 1;
+  return 0;
+}
+
+int main(void) {
+  vars_t v;
+  int n = 0;
+  cfgcli_t *cfg = setup(&v);
+  CHECK(cfg);
+  CHECK(!save("sections_1.conf", "top = 1\n[db]\nhost = a\n[db.pool]\n"
+      "size = 4\n[]\nlog.level = 2\n[nothing]\nx = 0\n"));
+  CHECK(!save("sections_2.conf", "top = 9\n[db.pool]\nsize = 8\n"));
+
+  /* Names are composed with the section headers. */
+  CHECK(!cfgcli_read_file(cfg, "sections_1.conf", 1));
+  CHECK(check_error(cfg, "nothing"));
+  CHECK(v.top == 1 && !strcmp(v.host, "a") && v.size == 4 && v.level == 2);
+
+  /* Parameters of sections are visited. */
+  CHECK(!cfgcli_foreach_param(cfg, "db", visit, &n) && n == 3);
+  n = 0;
+  CHECK(!cfgcli_foreach_param(cfg, "db.pool", visit, &n) && n == 1);
+  n = 0;
+  CHECK(cfgcli_foreach_param(cfg, NULL, visit, &n) == 7);
+  CHECK(cfgcli_foreach_param(cfg, "db.po", visit, &n) != 0);
+
+  /* Only parameters of the section are read again. */
+  CHECK(!cfgcli_reload_section(cfg, "sections_2.conf", "db", 1));
+  CHECK(v.size == 8 && v.top == 1);
+  CHECK(!cfgcli_is_set(cfg, &v.host) && cfgcli_is_set(cfg, &v.size));
+  free(v.host);
+
+  /* The section is restored if the file cannot be read. */
+  CHECK(!save("sections_3.conf", "[db]\nport = 5432\n[db.pool]\nsize = x\n"));
+  CHECK(cfgcli_reload_section(cfg, "sections_3.conf", "db", 1) != 0);
+  CHECK(!cfgcli_is_set(cfg, &v.port) && v.port == 0);
+  CHECK(cfgcli_is_set(cfg, &v.size) && v.size == 8);
+  cfgcli_destroy(cfg);
+  CHECK((cfg = setup(&v)));
+  CHECK(!cfgcli_read_file(cfg, "sections_2.conf", 1));
+  CHECK(cfgcli_reload_section(cfg, "sections_none.conf", "db", 1) != 0);
+  CHECK(cfgcli_is_set(cfg, &v.size) && v.size == 8);
+  cfgcli_destroy(cfg);
+
+  /* Deferred values of the section are dropped. */
+  CHECK((cfg = setup(&v)));
+  CHECK(!cfgcli_set_deferred(cfg, true));
+  CHECK(!cfgcli_read_file(cfg, "sections_1.conf", 1));
+  CHECK(!save("sections_2.conf", "top = 9\n[db]\nhost = b\n"));
+  CHECK(!cfgcli_reload_section(cfg, "sections_2.conf", "db", 1));
+  CHECK(!cfgcli_resolve(cfg));
+  CHECK(!cfgcli_is_set(cfg, &v.size) && v.size == 0);
+  CHECK(!strcmp(v.host, "b") && v.top == 1 && v.level == 2);
+  free(v.host);
+  cfgcli_destroy(cfg);
+  remove("sections_1.conf");
+  remove("sections_2.conf");
+  remove("sections_3.conf");
+  return 0;
+}
@@ -0,0 +1,121 @@
+/*******************************************************************************
+* shared.c: tests of values exported to shared memory segments.
+
+* libcfgcli: C library for parsing command line option and configuration files.
+
+* Gitlab repository:
+        https://framagit.org/groolot-association/libcfgcli
+
+* Copyright (c) 2019 Cheng Zhao <zhaocheng03@gmail.com>
+* Copyright (c) 2023 Gregory David <dev@groolot.net>
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+
+*******************************************************************************/
+
+#include <stdlib.h>
+#include "check.h"
+#ifdef HAVE_CONFIG_H
+#include "autoconf.h"
+#endif
+#ifdef HAVE_UNISTD_H
+#include <unistd.h>
+#endif
+
+/* Variables of all tested parameters. */
+typedef struct {
+  int vint;
+  double vdbl;
+  char *vstr;
+  int *aint;
+  char **astr;
+} vars_t;
+
+/* Register the parameters with the variables in `v`. */
+static cfgcli_t *setup(vars_t *v) {
+  const cfgcli_param_t params[] = {
+    { 0, NULL, "int",  CFGCLI_DTYPE_INT, &v->vint, "" },
+    { 0, NULL, "dbl",  CFGCLI_DTYPE_DBL, &v->vdbl, "" },
+    { 0, NULL, "str",  CFGCLI_DTYPE_STR, &v->vstr, "" },
+    { 0, NULL, "ints", CFGCLI_ARRAY_INT, &v->aint, "" },
+    { 0, NULL, "strs", CFGCLI_ARRAY_STR, &v->astr, "" }
+  };
+  cfgcli_t *cfg = cfgcli_init();
+  memset(v, 0, sizeof(vars_t));
+  if (cfg && cfgcli_set_params(cfg, params,
+      sizeof(params) / sizeof(params[0]))) {
+    cfgcli_destroy(cfg);
+    return NULL;
+  }
+  return cfg;
+}
+
+/* Release the memory of the values. */
+static void release(vars_t *v) {
+  free(v->vstr);
+  free(v->aint);
+  if (v->astr) free(*v->astr);
+  free(v->astr);
+}
+
+int main(void) {
+  vars_t v;
+  char conf[] = "int = 9\nstr = shared\nints = [4, 5, 6]\n"
+    "strs = [a, 'b c']\n";
+  cfgcli_shared_t *sh;
+  size_t num;
+  int fd;
+  cfgcli_t *cfg = setup(&v);
+  CHECK(cfg);
+  CHECK(!cfgcli_read_buffer(cfg, conf, strlen(conf), 1));
+
+  /* Segments cannot be created on every platform. */
+  if ((fd = cfgcli_shared_export(cfg)) < 0) {
+    CHECK(check_error(cfg, "not supported"));
+    release(&v);
+    cfgcli_destroy(cfg);
+    return 0;
+  }
+  /* The segment does not depend on the entry of the configurations. */
+  release(&v);
+  cfgcli_destroy(cfg);
+
+  sh = cfgcli_shared_attach(fd);
+#ifdef HAVE_UNISTD_H
+  close(fd);
+#endif
+  CHECK(sh);
+  const int *vint = cfgcli_shared_get(sh, "int", CFGCLI_DTYPE_INT, &num);
+  CHECK(vint && *vint == 9 && num == 1);
+  const char *vstr = cfgcli_shared_get(sh, "str", CFGCLI_DTYPE_STR, &num);
+  CHECK(vstr && !strcmp(vstr, "shared") && num == 6);
+  const int *aint = cfgcli_shared_get(sh, "ints", CFGCLI_ARRAY_INT, &num);
+  CHECK(aint && num == 3 && aint[0] == 4 && aint[2] == 6);
+  CHECK(cfgcli_shared_get(sh, "strs", CFGCLI_ARRAY_STR, &num) && num == 2);
+  const char *s = cfgcli_shared_str(sh, "strs", 1, &num);
+  CHECK(s && !strcmp(s, "b c") && num == 3);
+  CHECK(!cfgcli_shared_str(sh, "strs", 2, NULL));
+
+  /* Mismatched data types and unset parameters are not found. */
+  CHECK(!cfgcli_shared_get(sh, "ints", CFGCLI_ARRAY_DBL, NULL));
+  CHECK(!cfgcli_shared_get(sh, "dbl", CFGCLI_DTYPE_DBL, NULL));
+  CHECK(!cfgcli_shared_get(sh, "none", CFGCLI_DTYPE_INT, NULL));
+  cfgcli_shared_detach(sh);
+  return 0;
+}
@@ -0,0 +1,140 @@
+/*******************************************************************************
+* sink.c: tests of element sinks of arrays.
+
+* libcfgcli: C library for parsing command line option and configuration files.
+
+* Gitlab repository:
+        https://framagit.org/groolot-association/libcfgcli
+
+* Copyright (c) 2019 Cheng Zhao <zhaocheng03@gmail.com>
+* Copyright (c) 2023 Gregory David <dev@groolot.net>
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+
+*******************************************************************************/
+
+#include <stdlib.h>
+#include "check.h"
+
+/* Number of elements, filling several batches of the sinks. */
+#define NELEM           5000
+
+/* Elements received by a sink. */
+typedef struct {
+  size_t num;                   /* number of received elements          */
+  size_t nbatch;                /* number of batches                    */
+  bool order;                   /* true if the elements are in order    */
+  size_t stop;                  /* reject the batch with this element   */
+} sink_t;
+
+/* Receive integers, which must be 0, 1, 2, ... */
+static int sink_int(const void *elems, const size_t num, void *arg) {
+  sink_t *s = (sink_t *) arg;
+  const int *e = (const int *) elems;
+  if (num > 8192 / sizeof(int)) s->order = false;
+  for (size_t i = 0; i < num; i++)
+    if (e[i] != (int) (s->num + i)) s->order = false;
+  if (s->stop >= s->num && s->stop < s->num + num) return 1;
+  s->num += num;
+  s->nbatch += 1;
+  return 0;
+}
+
+/* Receive strings, which must be "s0", "s1", ... */
+static int sink_str(const void *elems, const size_t num, void *arg) {
+  sink_t *s = (sink_t *) arg;
+  char *const *e = (char *const *) elems;
+  char str[16];
+  for (size_t i = 0; i < num; i++) {
+    sprintf(str, "s%zu", s->num + i);
+    if (strcmp(e[i], str)) s->order = false;
+  }
+  s->num += num;
+  s->nbatch += 1;
+  return 0;
+}
+
+/* Compose an array definition with `NELEM` elements. */
+static char *compose(const char *name, const char *fmt, size_t *len) {
+  char *buf = malloc(NELEM * 12 + 32);
+  if (!buf) return NULL;
+  size_t n = sprintf(buf, "%s = [", name);
+  for (int i = 0; i < NELEM; i++) {
+    n += sprintf(buf + n, fmt, i);
+    n += sprintf(buf + n, ", ");
+  }
+  n += sprintf(buf + n - 2, "]\n") - 2;
+  *len = n;
+  return buf;
+}
+
+int main(void) {
+  int *aint = (int *) &aint;    /* not assigned if the sink is attached */
+  char **astr = NULL;
+  const cfgcli_param_t params[] = {
+    { 0, NULL, "ints", CFGCLI_ARRAY_INT, &aint, "" },
+    { 0, NULL, "strs", CFGCLI_ARRAY_STR, &astr, "" }
+  };
+  sink_t si = {0, 0, true, NELEM}, ss = {0, 0, true, NELEM};
+  size_t li, ls;
+  char *bi = compose("ints", "%d", &li);
+  char *bs = compose("strs", "'s%d'", &ls);
+  cfgcli_t *cfg = cfgcli_init();
+  CHECK(bi && bs && cfg);
+  CHECK(!cfgcli_set_params(cfg, params, 2));
+  CHECK(!cfgcli_set_sink(cfg, &aint, sink_int, &si));
+  CHECK(!cfgcli_set_sink(cfg, &astr, sink_str, &ss));
+
+  /* Elements are passed in order, in batches of at most 8 KiB. */
+  CHECK(!cfgcli_read_buffer(cfg, bi, li, 1));
+  CHECK(si.order && si.num == NELEM && si.nbatch > 1);
+  CHECK(!cfgcli_read_buffer(cfg, bs, ls, 1));
+  CHECK(ss.order && ss.num == NELEM && ss.nbatch > 1);
+
+  /* The variables are untouched, but the numbers of elements are kept. */
+  CHECK(aint == (int *) &aint && !astr);
+  CHECK(cfgcli_is_set(cfg, &aint));
+  CHECK(cfgcli_get_array_size(cfg, &aint) == NELEM);
+  CHECK(cfgcli_get_array_size(cfg, &astr) == NELEM);
+  free(bi);
+  free(bs);
+
+  /* Elements are assigned to the variable again without the sink. */
+  char arr[] = "ints = [7, 8]\n";
+  CHECK(!cfgcli_set_sink(cfg, &aint, NULL, NULL));
+  CHECK(!cfgcli_read_buffer(cfg, arr, strlen(arr), 2));
+  CHECK(cfgcli_get_size(cfg, &aint) == 2 && aint[1] == 8);
+  free(aint);
+  cfgcli_destroy(cfg);
+
+  /* Elements rejected by the sink are reported as an error. */
+  aint = NULL;
+  si.num = si.nbatch = 0;
+  si.stop = NELEM / 2;
+  CHECK((bi = compose("ints", "%d", &li)));
+  CHECK((cfg = cfgcli_init()));
+  CHECK(!cfgcli_set_params(cfg, params, 1));
+  CHECK(!cfgcli_set_sink(cfg, &aint, sink_int, &si));
+  CHECK(cfgcli_read_buffer(cfg, bi, li, 1) != 0);
+  CHECK(check_error(cfg, "elements rejected by the sink of parameter: ints"));
+  CHECK(si.order && si.num <= NELEM / 2 && !aint);
+  free(bi);
+  cfgcli_destroy(cfg);
+  return 0;
+}
@@ -0,0 +1,113 @@
+/*******************************************************************************
+* subcmd.c: tests of subcommands with lazily registered options.
+
+* libcfgcli: C library for parsing command line option and configuration files.
+
+* Gitlab repository:
+        https://framagit.org/groolot-association/libcfgcli
+
+* Copyright (c) 2019 Cheng Zhao <zhaocheng03@gmail.com>
+* Copyright (c) 2023 Gregory David <dev@groolot.net>
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+
+*******************************************************************************/
+
+#include "check.h"
+
+/* Variables of all tested parameters. */
+typedef struct {
+  bool verbose;
+  int num;                      /* option of `build` */
+  int port;                     /* option of `serve` */
+  int nbuild;                   /* number of registrations of `build` */
+  int nserve;                   /* number of registrations of `serve` */
+} vars_t;
+
+/* Register the options of the `build` subcommand. */
+static int reg_build(cfgcli_t *cfg, void *arg) {
+  vars_t *v = (vars_t *) arg;
+  const cfgcli_param_t params[] = {
+    { 'n', "num", "num", CFGCLI_DTYPE_INT, &v->num, "" }
+  };
+  v->nbuild++;
+  return cfgcli_set_params(cfg, params, 1);
+}
+
+/* Register the options of the `serve` subcommand. */
+static int reg_serve(cfgcli_t *cfg, void *arg) {
+  vars_t *v = (vars_t *) arg;
+  const cfgcli_param_t params[] = {
+    { 'p', "port", "port", CFGCLI_DTYPE_INT, &v->port, "" }
+  };
+  v->nserve++;
+  return cfgcli_set_params(cfg, params, 1);
+}
+
+/* Register the global option and the subcommands. */
+static cfgcli_t *setup(vars_t *v) {
+  const cfgcli_param_t params[] = {
+    { 'v', "verbose", "verbose", CFGCLI_DTYPE_BOOL, &v->verbose, "" }
+  };
+  const cfgcli_cmd_t cmds[] = {
+    { "build", reg_build, v, "" },
+    { "serve", reg_serve, v, "" }
+  };
+  cfgcli_t *cfg = cfgcli_init();
+  memset(v, 0, sizeof(vars_t));
+  if (cfg && (cfgcli_set_params(cfg, params, 1) ||
+      cfgcli_set_cmds(cfg, cmds, 2))) {
+    cfgcli_destroy(cfg);
+    return NULL;
+  }
+  return cfg;
+}
+
+int main(void) {
+  vars_t v;
+  char *argv[] = {"subcmd", "-v", "build", "-n", "4"};
+  char *inactive[] = {"subcmd", "build", "--port=80"};
+  char *unknown[] = {"subcmd", "test"};
+  int optidx = 0;
+
+  /* Only the selected subcommand registers its options. */
+  cfgcli_t *cfg = setup(&v);
+  CHECK(cfg);
+  CHECK(!cfgcli_get_cmd(cfg) && v.nbuild == 0 && v.nserve == 0);
+  CHECK(!cfgcli_read_opts(cfg, 5, argv, 1, &optidx));
+  CHECK(v.nbuild == 1 && v.nserve == 0);
+  CHECK(v.verbose && v.num == 4);
+  CHECK(!strcmp(cfgcli_get_cmd(cfg), "build"));
+  cfgcli_destroy(cfg);
+
+  /* Options of subcommands that are not selected are not recognised. */
+  CHECK((cfg = setup(&v)));
+  CHECK(!cfgcli_read_opts(cfg, 3, inactive, 1, &optidx));
+  CHECK(v.nbuild == 1 && v.nserve == 0 && v.port == 0);
+  CHECK(check_error(cfg, "unrecognised command line option: --port=80"));
+  cfgcli_destroy(cfg);
+
+  /* Unknown subcommands are rejected. */
+  CHECK((cfg = setup(&v)));
+  CHECK(cfgcli_read_opts(cfg, 2, unknown, 1, &optidx) != 0);
+  CHECK(check_error(cfg, "unknown subcommand: test"));
+  CHECK(!cfgcli_get_cmd(cfg) && v.nbuild == 0 && v.nserve == 0);
+  cfgcli_destroy(cfg);
+  return 0;
+}
@@ -0,0 +1,109 @@
+/*******************************************************************************
+* threads.c: tests of array conversions with multiple threads.
+
+* libcfgcli: C library for parsing command line option and configuration files.
+
+* Gitlab repository:
+        https://framagit.org/groolot-association/libcfgcli
+
+* Copyright (c) 2019 Cheng Zhao <zhaocheng03@gmail.com>
+* Copyright (c) 2023 Gregory David <dev@groolot.net>
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+
+*******************************************************************************/
+
+#include <stdlib.h>
+#include "check.h"
+
+/* Number of elements, enough for four threads. */
+#define NELEM   (4 * CFGCLI_PARALLEL_MIN_ELEM)
+
+/* Compose an array definition, with invalid elements at `bad`. */
+static char *compose(const char *name, const size_t *bad, const int nbad,
+    size_t *len) {
+  char *buf = malloc(NELEM * 12 + 32);
+  if (!buf) return NULL;
+  size_t n = sprintf(buf, "%s = [", name);
+  for (size_t i = 0; i < NELEM; i++) {
+    bool valid = true;
+    for (int j = 0; j < nbad; j++) if (bad[j] == i) valid = false;
+    n += valid ? sprintf(buf + n, "%zu, ", i) : sprintf(buf + n, "x, ");
+  }
+  n += sprintf(buf + n - 2, "]\n") - 2;
+  *len = n;
+  return buf;
+}
+
+/* Convert arrays, and check the reported element if any is invalid. */
+static int check_convert(const int nthread, const size_t *bad,
+    const int nbad, const char *msg) {
+  int *ai = NULL;
+  double *ad = NULL;
+  const cfgcli_param_t params[] = {
+    { 0, NULL, "ints", CFGCLI_ARRAY_INT, &ai, "" },
+    { 0, NULL, "dbls", CFGCLI_ARRAY_DBL, &ad, "" }
+  };
+  size_t li, ld;
+  char *bi = compose("ints", bad, nbad, &li);
+  char *bd = compose("dbls", NULL, 0, &ld);
+  cfgcli_t *cfg = cfgcli_init();
+  CHECK(bi && bd && cfg);
+  CHECK(!cfgcli_set_params(cfg, params, 2));
+  CHECK(!cfgcli_set_threads(cfg, nthread));
+
+  CHECK(!cfgcli_read_buffer(cfg, bd, ld, 1));
+  CHECK(cfgcli_get_array_size(cfg, &ad) == NELEM);
+  for (size_t i = 0; i < NELEM; i++) CHECK(ad[i] == (double) i);
+
+  if (nbad) {
+    CHECK(cfgcli_read_buffer(cfg, bi, li, 1) != 0);
+    CHECK(check_error(cfg, msg));
+  }
+  else {
+    CHECK(!cfgcli_read_buffer(cfg, bi, li, 1));
+    CHECK(cfgcli_get_array_size(cfg, &ai) == NELEM);
+    for (size_t i = 0; i < NELEM; i++) CHECK(ai[i] == (int) i);
+  }
+
+  free(ai);
+  free(ad);
+  free(bi);
+  free(bd);
+  cfgcli_destroy(cfg);
+  return 0;
+}
+
+int main(void) {
+  const size_t first[] = {3 * CFGCLI_PARALLEL_MIN_ELEM + 7};
+  const size_t both[] = {NELEM - 1, CFGCLI_PARALLEL_MIN_ELEM + 1};
+  char msg[64];
+
+  CHECK(!check_convert(4, NULL, 0, NULL));
+  CHECK(!check_convert(3, NULL, 0, NULL));
+
+  /* The first invalid element is reported regardless of the threads. */
+  for (int nthread = 1; nthread <= 4; nthread++) {
+    sprintf(msg, "with index: %zu", first[0]);
+    CHECK(!check_convert(nthread, first, 1, msg));
+    sprintf(msg, "with index: %zu", both[1]);
+    CHECK(!check_convert(nthread, both, 2, msg));
+  }
+  return 0;
+}
@@ -0,0 +1,195 @@
+/*******************************************************************************
+* values.c: tests of value conversions, and arrays spanning multiple lines.
+
+* libcfgcli: C library for parsing command line option and configuration files.
+
+* Gitlab repository:
+        https://framagit.org/groolot-association/libcfgcli
+
+* Copyright (c) 2019 Cheng Zhao <zhaocheng03@gmail.com>
+* Copyright (c) 2023 Gregory David <dev@groolot.net>
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+
+*******************************************************************************/
+
+#include <stdlib.h>
+#include <math.h>
+#include "check.h"
+
+/* Number of streamed elements, filling several batches of the sinks. */
+#define NSTREAM         5000
+
+/* Variables of all tested parameters. */
+typedef struct {
+  int vint;
+  double vdbl;
+  char *vstr;
+  int *aint;
+  double *adbl;
+  char **astr;
+} vars_t;
+
+/* Elements received by a sink. */
+typedef struct {
+  size_t num;                   /* number of received elements          */
+  size_t nbatch;                /* number of batches                    */
+  size_t max;                   /* maximum number of elements per batch */
+  bool order;                   /* true if the elements are in order    */
+} sink_t;
+
+static char conf[] =
+  "int  = -2147483648\n"
+  "dbl  = 0.1\n"
+  "str  = \"a 'quoted' # string\"\n"
+  "ints = [1, -2, 3]\n"
+  "dbls = [1e-320, -0.0, \\\n"
+  "        2.5e300]\n"
+  "strs = ['x, y', \"[z]\"]\n";
+
+/* Register the parameters with the variables in `v`. */
+static cfgcli_t *setup(vars_t *v) {
+  const cfgcli_param_t params[] = {
+    { 0, NULL, "int",  CFGCLI_DTYPE_INT, &v->vint, "" },
+    { 0, NULL, "dbl",  CFGCLI_DTYPE_DBL, &v->vdbl, "" },
+    { 0, NULL, "str",  CFGCLI_DTYPE_STR, &v->vstr, "" },
+    { 0, NULL, "ints", CFGCLI_ARRAY_INT, &v->aint, "" },
+    { 0, NULL, "dbls", CFGCLI_ARRAY_DBL, &v->adbl, "" },
+    { 0, NULL, "strs", CFGCLI_ARRAY_STR, &v->astr, "" }
+  };
+  cfgcli_t *cfg = cfgcli_init();
+  memset(v, 0, sizeof(vars_t));
+  if (cfg && cfgcli_set_params(cfg, params,
+      sizeof(params) / sizeof(params[0]))) {
+    cfgcli_destroy(cfg);
+    return NULL;
+  }
+  return cfg;
+}
+
+/* Release the memory of the values. */
+static void release(vars_t *v) {
+  free(v->vstr);
+  free(v->aint);
+  free(v->adbl);
+  if (v->astr) free(*v->astr);
+  free(v->astr);
+}
+
+/* Read a single entry, and check that it is rejected with `msg`. */
+static int check_invalid(const char *entry, const char *msg) {
+  vars_t v;
+  char buf[256];
+  cfgcli_t *cfg = setup(&v);
+  CHECK(cfg);
+  snprintf(buf, sizeof(buf), "%s\n", entry);
+  CHECK(cfgcli_read_buffer(cfg, buf, strlen(buf), 1) != 0);
+  CHECK(check_error(cfg, msg));
+  release(&v);
+  cfgcli_destroy(cfg);
+  return 0;
+}
+
+/* Count the integers passed to a sink, which must be 0, 1, 2, ... */
+static int count_elements(const void *elems, const size_t num, void *arg) {
+  sink_t *s = (sink_t *) arg;
+  const int *e = (const int *) elems;
+  for (size_t i = 0; i < num; i++)
+    if (e[i] != (int) (s->num + i)) s->order = false;
+  s->num += num;
+  s->nbatch += 1;
+  if (num > s->max) s->max = num;
+  return 0;
+}
+
+/* Write an array of `NSTREAM` elements in lines of 10 elements to a file. */
+static int save_stream(const char *fname, const char *name, const char *fmt) {
+  FILE *fp = fopen(fname, "w");
+  CHECK(fp);
+  fprintf(fp, "%s = [", name);
+  for (int i = 0; i < NSTREAM; i++) {
+    fprintf(fp, fmt, i);
+    if (i == NSTREAM - 1) fprintf(fp, "]\n");
+    else if (i % 10 == 9) fprintf(fp, ", \\\n  ");
+    else fprintf(fp, ", ");
+  }
+  CHECK(!fclose(fp));
+  return 0;
+}
+
+/* Arrays in multiple lines of files, which are converted line by line. */
+static int check_stream(void) {
+  vars_t v;
+  sink_t s = {0, 0, 0, true};
+  char str[16];
+  cfgcli_t *cfg = setup(&v);
+  CHECK(cfg);
+  CHECK(!save_stream("values_ints.conf", "ints", "%d"));
+  CHECK(!save_stream("values_strs.conf", "strs", "'s %d'"));
+
+  /* Batches of the sink are limited to 8 KiB. */
+  CHECK(!cfgcli_set_sink(cfg, &v.aint, count_elements, &s));
+  CHECK(!cfgcli_read_file(cfg, "values_ints.conf", 1));
+  CHECK(s.order && s.num == NSTREAM);
+  CHECK(s.nbatch > 1 && s.max <= 8192 / sizeof(int));
+  CHECK(cfgcli_get_array_size(cfg, &v.aint) == NSTREAM && !v.aint);
+
+  /* Offsets of strings that are not interned are turned into addresses. */
+  CHECK(!cfgcli_read_file(cfg, "values_strs.conf", 1));
+  CHECK(cfgcli_get_array_size(cfg, &v.astr) == NSTREAM);
+  for (int i = 0; i < NSTREAM; i++) {
+    sprintf(str, "s %d", i);
+    CHECK(!strcmp(v.astr[i], str));
+  }
+  release(&v);
+  cfgcli_destroy(cfg);
+  remove("values_ints.conf");
+  remove("values_strs.conf");
+  return 0;
+}
+
+int main(void) {
+  vars_t v;
+  char buf[sizeof(conf)];
+  cfgcli_t *cfg = setup(&v);
+  CHECK(cfg);
+  memcpy(buf, conf, sizeof(conf));
+  CHECK(!cfgcli_read_buffer(cfg, buf, strlen(buf), 1));
+  CHECK(v.vint == -2147483647 - 1);
+  CHECK(v.vdbl == 0.1);
+  CHECK(!strcmp(v.vstr, "a 'quoted' # string"));
+  CHECK(cfgcli_get_size(cfg, &v.aint) == 3);
+  CHECK(v.aint[0] == 1 && v.aint[1] == -2 && v.aint[2] == 3);
+  CHECK(cfgcli_get_array_size(cfg, &v.adbl) == 3);
+  CHECK(v.adbl[0] == 1e-320 && v.adbl[1] == 0 && signbit(v.adbl[1]) &&
+      v.adbl[2] == 2.5e300);
+  CHECK(cfgcli_get_size(cfg, &v.astr) == 2);
+  CHECK(!strcmp(v.astr[0], "x, y") && !strcmp(v.astr[1], "[z]"));
+  release(&v);
+  cfgcli_destroy(cfg);
+
+  /* Invalid values. */
+  CHECK(!check_invalid("int = 2147483648", "parameter: int"));
+  CHECK(!check_invalid("int = 12a", "parameter: int"));
+  CHECK(!check_invalid("dbl = 1e-3x", "parameter: dbl"));
+  CHECK(!check_invalid("ints = [1, 2x, 3]", "parameter: ints"));
+
+  CHECK(!check_stream());
+  return 0;
+}
@@ -0,0 +1,97 @@
+/*******************************************************************************
+* views.c: tests of string views pointing to the sources.
+
+* libcfgcli: C library for parsing command line option and configuration files.
+
+* Gitlab repository:
+        https://framagit.org/groolot-association/libcfgcli
+
+* Copyright (c) 2019 Cheng Zhao <zhaocheng03@gmail.com>
+* Copyright (c) 2023 Gregory David <dev@groolot.net>
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+
+*******************************************************************************/
+
+#include <stdlib.h>
+#include "check.h"
+
+/* Variables of all tested parameters. */
+typedef struct {
+  cfgcli_strview_t view;
+  cfgcli_strview_t *views;
+} vars_t;
+
+/* Register the parameters with the variables in `v`. */
+static cfgcli_t *setup(vars_t *v) {
+  const cfgcli_param_t params[] = {
+    { 'v', "view",  "view",  CFGCLI_DTYPE_STRV, &v->view,  "" },
+    { 0,   "views", "views", CFGCLI_ARRAY_STRV, &v->views, "" }
+  };
+  cfgcli_t *cfg = cfgcli_init();
+  memset(v, 0, sizeof(vars_t));
+  if (cfg && cfgcli_set_params(cfg, params, 2)) {
+    cfgcli_destroy(cfg);
+    return NULL;
+  }
+  return cfg;
+}
+
+/* Check if a view points to `str` in the source. */
+static bool view_is(const cfgcli_strview_t *view, const char *str) {
+  return view->len == strlen(str) && !memcmp(view->ptr, str, view->len);
+}
+
+int main(void) {
+  vars_t v;
+  char buf[] = "view = 'a b'\nviews = [x, \"y, z\"]\n";
+  cfgcli_t *cfg = setup(&v);
+  CHECK(cfg);
+
+  /* Views of buffers point to their content. */
+  CHECK(!cfgcli_read_buffer(cfg, buf, strlen(buf), 1));
+  CHECK(view_is(&v.view, "a b"));
+  CHECK(v.view.ptr > buf && v.view.ptr < buf + sizeof(buf));
+  CHECK(cfgcli_get_array_size(cfg, &v.views) == 2);
+  CHECK(view_is(v.views, "x") && view_is(v.views + 1, "y, z"));
+  CHECK(v.views[1].ptr > buf && v.views[1].ptr < buf + sizeof(buf));
+  free(v.views);
+  cfgcli_destroy(cfg);
+
+  /* Views of command line options point to the arguments. */
+  char *argv[] = {"views", "-v", "opt"};
+  int optidx;
+  CHECK((cfg = setup(&v)));
+  CHECK(!cfgcli_read_opts(cfg, 3, argv, 2, &optidx));
+  CHECK(view_is(&v.view, "opt") && v.view.ptr == argv[2]);
+  cfgcli_destroy(cfg);
+
+  /* Files are not resident, so views of them are rejected. */
+  FILE *fp = fopen("views.conf", "w");
+  CHECK(fp);
+  fprintf(fp, "view = file\n");
+  CHECK(!fclose(fp));
+  CHECK((cfg = setup(&v)));
+  CHECK(cfgcli_read_file(cfg, "views.conf", 1) != 0);
+  CHECK(check_error(cfg, "no resident source for string view parameter"));
+  CHECK(!v.view.ptr);
+  cfgcli_destroy(cfg);
+  remove("views.conf");
+  return 0;
+}
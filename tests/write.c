@@ -0,0 +1,170 @@
+/*******************************************************************************
+* write.c: tests of writing configurations.
+
+* libcfgcli: C library for parsing command line option and configuration files.
+
+* Gitlab repository:
+        https://framagit.org/groolot-association/libcfgcli
+
+* Copyright (c) 2019 Cheng Zhao <zhaocheng03@gmail.com>
+* Copyright (c) 2023 Gregory David <dev@groolot.net>
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+
+*******************************************************************************/
+
+#include <stdlib.h>
+#include <math.h>
+#include "check.h"
+
+/* Variables of all tested parameters. */
+typedef struct {
+  int vint;
+  double vdbl;
+  char *vstr;
+  char *quote;
+  int *aint;
+  double *adbl;
+  char **astr;
+  int *nd;
+  unsigned char *blob;
+} vars_t;
+
+static char conf[] =
+  "int   = -2147483648\n"
+  "dbl   = 0.1\n"
+  "str   = \"a 'quoted' # string\"\n"
+  "quote = both\"'quotes\n"
+  "ints  = [1, -2, 3]\n"
+  "dbls  = [1e-320, -0.0, \\\n"
+  "         2.5e300]\n"
+  "strs  = ['x, y', \"[z]\"]\n"
+  "nd    = [[1, 2, 3], [4, 5, 6]]\n"
+  "blob  = AP86\n";
+
+/* Register the parameters with the variables in `v`. */
+static cfgcli_t *setup(vars_t *v) {
+  const cfgcli_param_t params[] = {
+    { 0, NULL, "int",   CFGCLI_DTYPE_INT,   &v->vint,  "" },
+    { 0, NULL, "dbl",   CFGCLI_DTYPE_DBL,   &v->vdbl,  "" },
+    { 0, "str", "str",     CFGCLI_DTYPE_STR,   &v->vstr,  "" },
+    { 0, "quote", "quote", CFGCLI_DTYPE_STR,   &v->quote, "" },
+    { 0, NULL, "ints",  CFGCLI_ARRAY_INT,   &v->aint,  "" },
+    { 0, NULL, "dbls",  CFGCLI_ARRAY_DBL,   &v->adbl,  "" },
+    { 0, NULL, "strs",  CFGCLI_ARRAY_STR,   &v->astr,  "" },
+    { 0, NULL, "nd",    CFGCLI_NDARRAY_INT, &v->nd,    "" },
+    { 0, NULL, "blob",  CFGCLI_DTYPE_BLOB,  &v->blob,  "" }
+  };
+  cfgcli_t *cfg = cfgcli_init();
+  memset(v, 0, sizeof(vars_t));
+  if (cfg && cfgcli_set_params(cfg, params,
+      sizeof(params) / sizeof(params[0]))) {
+    cfgcli_destroy(cfg);
+    return NULL;
+  }
+  return cfg;
+}
+
+/* Release the memory of the values. */
+static void release(vars_t *v) {
+  free(v->vstr);
+  free(v->quote);
+  free(v->aint);
+  free(v->adbl);
+  if (v->astr) free(*v->astr);
+  free(v->astr);
+  free(v->nd);
+  free(v->blob);
+}
+
+/* Check the values defined in `conf`. */
+static int check_values(cfgcli_t *cfg, const vars_t *v) {
+  size_t shape[CFGCLI_MAX_NDIM];
+  CHECK(v->vint == -2147483647 - 1 && v->vdbl == 0.1);
+  CHECK(!strcmp(v->vstr, "a 'quoted' # string"));
+  CHECK(!strcmp(v->quote, "both\"'quotes"));
+  CHECK(cfgcli_get_size(cfg, &v->aint) == 3);
+  CHECK(v->aint[0] == 1 && v->aint[1] == -2 && v->aint[2] == 3);
+  CHECK(cfgcli_get_size(cfg, &v->adbl) == 3);
+  CHECK(v->adbl[0] == 1e-320 && v->adbl[1] == 0 && signbit(v->adbl[1]) &&
+      v->adbl[2] == 2.5e300);
+  CHECK(cfgcli_get_size(cfg, &v->astr) == 2);
+  CHECK(!strcmp(v->astr[0], "x, y") && !strcmp(v->astr[1], "[z]"));
+  CHECK(cfgcli_get_shape(cfg, &v->nd, shape) == 2);
+  CHECK(shape[0] == 2 && shape[1] == 3 && v->nd[5] == 6);
+  CHECK(cfgcli_get_array_size(cfg, &v->blob) == 3);
+  CHECK(!memcmp(v->blob, "\x00\xff\x3a", 3));
+  return 0;
+}
+
+/* Write the configurations, and read them back. */
+static int check_roundtrip(const bool defer) {
+  vars_t a, b;
+  char buf[sizeof(conf)], *out = NULL;
+  size_t len;
+  cfgcli_t *ca = setup(&a);
+  cfgcli_t *cb = setup(&b);
+  CHECK(ca && cb);
+
+  /* Deferred values are converted before they are written. */
+  memcpy(buf, conf, sizeof(conf));
+  CHECK(!cfgcli_set_deferred(ca, defer));
+  CHECK(!cfgcli_read_buffer(ca, buf, strlen(buf), 1));
+  CHECK(!cfgcli_write_buffer(ca, &out, &len));
+  CHECK(out && strlen(out) == len);
+  CHECK(!check_values(ca, &a));
+
+  CHECK(!cfgcli_read_buffer(cb, out, len, 1));
+  CHECK(!check_values(cb, &b));
+  free(out);
+  release(&a);
+  release(&b);
+  cfgcli_destroy(ca);
+  cfgcli_destroy(cb);
+  return 0;
+}
+
+int main(void) {
+  vars_t v;
+  CHECK(!check_roundtrip(false));
+  CHECK(!check_roundtrip(true));
+
+  /* Files are written at once, and strings that cannot be represented are
+     omitted with a warning. */
+  char buf[] = "int = 5\n";
+  char *argv[] = {"write", "--str=line\nbreak", "--quote=both\"'#quotes"};
+  int optidx;
+  cfgcli_t *cfg = setup(&v);
+  CHECK(cfg);
+  CHECK(!cfgcli_read_buffer(cfg, buf, strlen(buf), 1));
+  CHECK(!cfgcli_read_opts(cfg, 3, argv, 2, &optidx));
+  CHECK(!cfgcli_write_file(cfg, "write.conf"));
+  CHECK(check_error(cfg, "parameter: quote"));
+  release(&v);
+  cfgcli_destroy(cfg);
+
+  CHECK((cfg = setup(&v)));
+  CHECK(!cfgcli_read_file(cfg, "write.conf", 1));
+  CHECK(v.vint == 5 && !cfgcli_is_set(cfg, &v.vstr) &&
+      !cfgcli_is_set(cfg, &v.quote));
+  release(&v);
+  cfgcli_destroy(cfg);
+  remove("write.conf");
+  return 0;
+}